@@ -30,6 +30,11 @@ CREATE TABLE Categories (
   FOREIGN KEY (account_id) REFERENCES Accounts (id) ON DELETE CASCADE
 );
 -- !
+CREATE TABLE Icons (
+  hash            VARCHAR(64) NOT NULL UNIQUE CHECK (hash != ''), /* SHA-256 of data. Feeds/icon and Categories/icon point here. */
+  data            ^^          NOT NULL
+);
+-- !
 CREATE TABLE Feeds (
   id                        $$,
   ordr                      INTEGER     NOT NULL CHECK (ordr >= 0),
@@ -81,10 +86,18 @@ CREATE TABLE Messages (
   custom_id       TEXT,
   custom_hash     TEXT,
   labels          TEXT        NOT NULL DEFAULT ".", /* Holds list of assigned label IDs. */
+  has_enclosures  INTEGER     NOT NULL DEFAULT 0 CHECK (has_enclosures >= 0 AND has_enclosures <= 1),
+  contents_compressed ^^,     /* Compressed contents, 'contents' column is empty then. */
+  content_hash    VARCHAR(64), /* Hash of URL and title of articles without custom ID from feed. */
+  full_contents   TEXT,       /* Extracted main content of linked page, empty if extraction failed. */
+  full_contents_compressed ^^, /* Compressed extracted content, 'full_contents' column is empty then. */
   
   FOREIGN KEY (account_id) REFERENCES Accounts (id) ON DELETE CASCADE
 );
 -- !
+/* Articles without custom ID are recognized by hash of their contents. */
+CREATE UNIQUE INDEX idx_messages_content_hash ON Messages (account_id, feed~~, content_hash);
+-- !
 CREATE TABLE MessageFilters (
   id                  $$,
   name                TEXT        NOT NULL CHECK (name != ''),
@@ -0,0 +1,7 @@
+USE ##;
+-- !
+SET FOREIGN_KEY_CHECKS = 0;
+-- !
+!! db_update_sqlite_12_13.sql
+-- !
+SET FOREIGN_KEY_CHECKS = 1;
\ No newline at end of file
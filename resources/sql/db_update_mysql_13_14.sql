@@ -0,0 +1,7 @@
+USE ##;
+-- !
+SET FOREIGN_KEY_CHECKS = 0;
+-- !
+!! db_update_sqlite_13_14.sql
+-- !
+SET FOREIGN_KEY_CHECKS = 1;
@@ -0,0 +1 @@
+ALTER TABLE Messages ADD COLUMN contents_compressed ^^;
\ No newline at end of file
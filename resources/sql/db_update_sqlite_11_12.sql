@@ -0,0 +1,4 @@
+ALTER TABLE Messages ADD COLUMN content_hash VARCHAR(64);
+-- !
+/* Articles without custom ID are recognized by hash of their contents. */
+CREATE UNIQUE INDEX idx_messages_content_hash ON Messages (account_id, feed~~, content_hash);
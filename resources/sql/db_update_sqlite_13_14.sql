@@ -0,0 +1 @@
+ALTER TABLE Messages ADD COLUMN full_contents_compressed ^^;
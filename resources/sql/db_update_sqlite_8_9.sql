@@ -0,0 +1,3 @@
+ALTER TABLE Messages ADD COLUMN has_enclosures INTEGER NOT NULL DEFAULT 0 CHECK (has_enclosures >= 0 AND has_enclosures <= 1);
+-- !
+UPDATE Messages SET has_enclosures = 1 WHERE LENGTH(enclosures) > 10;
\ No newline at end of file
@@ -0,0 +1,4 @@
+CREATE TABLE Icons (
+  hash            VARCHAR(64) NOT NULL UNIQUE CHECK (hash != ''),
+  data            ^^          NOT NULL
+);
\ No newline at end of file
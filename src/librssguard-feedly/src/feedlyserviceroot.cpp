@@ -94,9 +94,13 @@ QList<Message> FeedlyServiceRoot::obtainNewMessages(Feed* feed,
   }
 }
 
+AccountStructure FeedlyServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  return DatabaseQueries::getAccountStructure<Category, Feed>(db, accountId());
+}
+
 void FeedlyServiceRoot::start(bool freshly_activated) {
   if (!freshly_activated) {
-    DatabaseQueries::loadRootFromDatabase<Category, Feed>(this);
+    loadFromDatabase();
     loadCacheFromFile();
   }
 
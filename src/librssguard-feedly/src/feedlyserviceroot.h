@@ -32,6 +32,7 @@ class FeedlyServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     FeedlyNetwork* network() const;
 
   protected:
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
     virtual RootItem* obtainNewTreeForSyncIn() const;
 
   private:
@@ -188,9 +188,13 @@ bool GmailServiceRoot::supportsCategoryAdding() const {
   return false;
 }
 
+AccountStructure GmailServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  return DatabaseQueries::getAccountStructure<Category, Feed>(db, accountId());
+}
+
 void GmailServiceRoot::start(bool freshly_activated) {
   if (!freshly_activated) {
-    DatabaseQueries::loadRootFromDatabase<Category, Feed>(this);
+    loadFromDatabase();
     loadCacheFromFile();
   }
 
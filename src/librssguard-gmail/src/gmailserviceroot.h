@@ -43,6 +43,7 @@ class GmailServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     virtual CustomMessagePreviewer* customMessagePreviewer();
 
   protected:
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
     virtual RootItem* obtainNewTreeForSyncIn() const;
 
   private slots:
@@ -232,9 +232,13 @@ bool GreaderServiceRoot::wantsBaggedIdsOfExistingMessages() const {
   return m_network->intelligentSynchronization();
 }
 
+AccountStructure GreaderServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  return DatabaseQueries::getAccountStructure<Category, GreaderFeed>(db, accountId());
+}
+
 void GreaderServiceRoot::start(bool freshly_activated) {
   if (!freshly_activated) {
-    DatabaseQueries::loadRootFromDatabase<Category, GreaderFeed>(this);
+    loadFromDatabase();
     loadCacheFromFile();
   }
 
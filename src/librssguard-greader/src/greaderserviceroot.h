@@ -57,6 +57,7 @@ class GreaderServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     void exportFeeds();
 
   protected:
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
     virtual RootItem* obtainNewTreeForSyncIn() const;
 
   private:
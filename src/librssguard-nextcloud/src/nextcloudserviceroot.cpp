@@ -54,9 +54,13 @@ bool NextcloudServiceRoot::supportsCategoryAdding() const {
   return false;
 }
 
+AccountStructure NextcloudServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  return DatabaseQueries::getAccountStructure<Category, NextcloudFeed>(db, accountId());
+}
+
 void NextcloudServiceRoot::start(bool freshly_activated) {
   if (!freshly_activated) {
-    DatabaseQueries::loadRootFromDatabase<Category, NextcloudFeed>(this);
+    loadFromDatabase();
     loadCacheFromFile();
   }
 
@@ -36,6 +36,7 @@ class NextcloudServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     NextcloudNetworkFactory* network() const;
 
   protected:
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
     virtual RootItem* obtainNewTreeForSyncIn() const;
 
   private:
@@ -105,9 +105,13 @@ bool RedditServiceRoot::supportsCategoryAdding() const {
   return false;
 }
 
+AccountStructure RedditServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  return DatabaseQueries::getAccountStructure<RedditCategory, RedditSubscription>(db, accountId());
+}
+
 void RedditServiceRoot::start(bool freshly_activated) {
   if (!freshly_activated) {
-    DatabaseQueries::loadRootFromDatabase<RedditCategory, RedditSubscription>(this);
+    loadFromDatabase();
     loadCacheFromFile();
   }
 
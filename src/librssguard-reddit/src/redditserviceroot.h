@@ -34,6 +34,7 @@ class RedditServiceRoot : public ServiceRoot, public CacheForServiceRoot {
                                              const QHash<QString, QStringList>& tagged_messages);
 
   protected:
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
     virtual RootItem* obtainNewTreeForSyncIn() const;
 
   private:
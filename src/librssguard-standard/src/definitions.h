@@ -8,6 +8,18 @@
 
 #define ADVANCED_FEED_ADD_DIALOG_CODE 64
 
+// Size of response cache shared by parsers during feed discovery, in kB.
+#define DISCOVERY_CACHE_SIZE            32768
+#define DISCOVERY_MAX_REQUESTS_PER_HOST 2
+
+// Child sitemaps of sitemap index are downloaded by given count of threads. Only given
+// count of most recently modified children is processed during single feed update.
+#define SITEMAP_INDEX_FETCH_THREADS 4
+#define SITEMAP_INDEX_MAX_CHILDREN  50
+
+// Gzipped sitemaps are read from their source in chunks of given size, in bytes.
+#define GZIP_INPUT_CHUNK_SIZE 65536
+
 #define RSS_REGEX_MATCHER      "<link[^>]+type=\"application\\/(?:rss\\+xml)\"[^>]*>"
 #define RSS_HREF_REGEX_MATCHER "href=\"([^\"]+)\""
 
@@ -5,6 +5,7 @@
 #include "src/definitions.h"
 #include "src/gui/formstandardfeeddetails.h"
 #include "src/parsers/atomparser.h"
+#include "src/parsers/discoverysession.h"
 #include "src/parsers/icalparser.h"
 #include "src/parsers/jsonparser.h"
 #include "src/parsers/rdfparser.h"
@@ -148,16 +149,18 @@ FormDiscoverFeeds::~FormDiscoverFeeds() {
 }
 
 QList<StandardFeed*> FormDiscoverFeeds::discoverFeedsWithParser(const FeedParser* parser,
+                                                                DiscoverySession& session,
                                                                 const QString& url,
                                                                 bool greedy) {
-  auto feeds = parser->discoverFeeds(m_serviceRoot, QUrl::fromUserInput(url), greedy);
-  QPixmap icon;
-  int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
-
-  if (NetworkFactory::downloadIcon({{url, false}}, timeout, icon, {}, m_serviceRoot->networkProxy()) ==
-      QNetworkReply::NetworkError::NoError) {
-    for (Feed* feed : feeds) {
-      feed->setIcon(icon);
+  auto feeds = parser->discoverFeeds(session, QUrl::fromUserInput(url), greedy);
+
+  if (!feeds.isEmpty()) {
+    QPixmap icon = session.icon(url);
+
+    if (!icon.isNull()) {
+      for (Feed* feed : feeds) {
+        feed->setIcon(icon);
+      }
     }
   }
 
@@ -168,8 +171,11 @@ void FormDiscoverFeeds::discoverFeeds() {
   QString url = m_ui.m_txtUrl->lineEdit()->text();
   bool greedy_discover = m_ui.m_cbDiscoverRecursive->isChecked();
 
+  // All parsers share downloaded data, so each URL is fetched only once.
+  QSharedPointer<DiscoverySession> session(new DiscoverySession(m_serviceRoot));
+
   std::function<QList<StandardFeed*>(const FeedParser*)> func = [=](const FeedParser* parser) -> QList<StandardFeed*> {
-    return discoverFeedsWithParser(parser, url, greedy_discover);
+    return discoverFeedsWithParser(parser, *session, url, greedy_discover);
   };
 
   std::function<QList<StandardFeed*>(QList<StandardFeed*>&, const QList<StandardFeed*>&)> reducer =
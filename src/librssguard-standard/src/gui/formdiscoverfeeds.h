@@ -14,6 +14,7 @@
 
 class ServiceRoot;
 class RootItem;
+class DiscoverySession;
 class Category;
 
 class DiscoveredFeedsModel : public AccountCheckModel {
@@ -57,7 +58,10 @@ class FormDiscoverFeeds : public QDialog {
     StandardFeed* selectedFeed() const;
     RootItem* targetParent() const;
 
-    QList<StandardFeed*> discoverFeedsWithParser(const FeedParser* parser, const QString& url, bool greedy);
+    QList<StandardFeed*> discoverFeedsWithParser(const FeedParser* parser,
+                                                 DiscoverySession& session,
+                                                 const QString& url,
+                                                 bool greedy);
 
     void userWantsAdvanced();
     void loadDiscoveredFeeds(const QList<StandardFeed*>& feeds);
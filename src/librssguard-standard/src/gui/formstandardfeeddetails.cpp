@@ -137,6 +137,10 @@ void FormStandardFeedDetails::apply() {
       std_feed->setDontUseRawXmlSaving(m_standardFeedExpDetails->m_ui.m_cbDontUseRawXml->isChecked());
     }
 
+    if (isChangeAllowed(m_standardFeedExpDetails->m_ui.m_mcbPrefetchFullArticles)) {
+      std_feed->setPrefetchFullArticles(m_standardFeedExpDetails->m_ui.m_cbPrefetchFullArticles->isChecked());
+    }
+
     std_feed->setCreationDate(QDateTime::currentDateTime());
     std_feed->setLastEtag({});
 
@@ -192,6 +196,8 @@ void FormStandardFeedDetails::loadFeedData() {
 
     m_standardFeedExpDetails->m_ui.m_mcbDontUseRawXml
       ->addActionWidget(m_standardFeedExpDetails->m_ui.m_cbDontUseRawXml);
+    m_standardFeedExpDetails->m_ui.m_mcbPrefetchFullArticles
+      ->addActionWidget(m_standardFeedExpDetails->m_ui.m_cbPrefetchFullArticles);
   }
   else {
     // We hide batch selectors.
@@ -220,5 +226,6 @@ void FormStandardFeedDetails::loadFeedData() {
     m_standardFeedDetails->setExistingFeed(std_feed);
 
     m_standardFeedExpDetails->m_ui.m_cbDontUseRawXml->setChecked(std_feed->dontUseRawXmlSaving());
+    m_standardFeedExpDetails->m_ui.m_cbPrefetchFullArticles->setChecked(std_feed->prefetchFullArticles());
   }
 }
@@ -28,4 +28,11 @@ StandardFeedExpDetails::StandardFeedExpDetails(QWidget* parent) : QWidget(parent
                                            "This setting is useful when raw XML parsing of the feed is very slow, this "
                                            "happens for feed which do have very long contents."),
                                         false);
+
+  m_ui.m_helpPrefetchFullArticles->setHelpText(tr("Web pages of articles are downloaded when fetching this feed and "
+                                                  "their main content is stored and displayed instead of article "
+                                                  "summary, so that whole articles can be read even offline.\n\n"
+                                                  "This setting is useful for feeds which only provide short summaries "
+                                                  "of their articles. Feed fetching then takes longer."),
+                                               false);
 }
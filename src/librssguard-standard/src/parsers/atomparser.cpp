@@ -3,6 +3,7 @@
 #include "src/parsers/atomparser.h"
 
 #include "src/definitions.h"
+#include "src/parsers/discoverysession.h"
 #include "src/standardfeed.h"
 
 #include <librssguard/definitions/definitions.h>
@@ -26,8 +27,8 @@ AtomParser::AtomParser(const QString& data) : FeedParser(data) {
 
 AtomParser::~AtomParser() {}
 
-QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const {
-  auto base_result = FeedParser::discoverFeeds(root, url, greedy);
+QList<StandardFeed*> AtomParser::discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const {
+  auto base_result = FeedParser::discoverFeeds(session, url, greedy);
 
   if (!base_result.isEmpty()) {
     return base_result;
@@ -48,18 +49,8 @@ QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
   // 7. If URL is reddit, append ".rss".
 
   // Download URL.
-  int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
   QByteArray data;
-  auto res = NetworkFactory::performNetworkOperation(my_url,
-                                                     timeout,
-                                                     {},
-                                                     data,
-                                                     QNetworkAccessManager::Operation::GetOperation,
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     root->networkProxy());
+  auto res = session.fetch(my_url, data);
   QString direct_html_data = QString::fromUtf8(data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
@@ -98,16 +89,7 @@ QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
       }
 
       QByteArray data;
-      auto res = NetworkFactory::performNetworkOperation(feed_link,
-                                                         timeout,
-                                                         {},
-                                                         data,
-                                                         QNetworkAccessManager::Operation::GetOperation,
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         root->networkProxy());
+      auto res = session.fetch(feed_link, data);
 
       if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
         try {
@@ -125,16 +107,7 @@ QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
 
   // 3.
   my_url = url.toString(QUrl::UrlFormattingOption::StripTrailingSlash) + QSL("/feed");
-  res = NetworkFactory::performNetworkOperation(my_url,
-                                                timeout,
-                                                {},
-                                                data,
-                                                QNetworkAccessManager::Operation::GetOperation,
-                                                {},
-                                                {},
-                                                {},
-                                                {},
-                                                root->networkProxy());
+  res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -149,16 +122,7 @@ QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
 
   // 4.
   my_url = url.toString(QUrl::UrlFormattingOption::StripTrailingSlash) + QSL("/atom");
-  res = NetworkFactory::performNetworkOperation(my_url,
-                                                timeout,
-                                                {},
-                                                data,
-                                                QNetworkAccessManager::Operation::GetOperation,
-                                                {},
-                                                {},
-                                                {},
-                                                {},
-                                                root->networkProxy());
+  res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -183,16 +147,7 @@ QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
 
     for (const QString& github_feed : github_feeds) {
       my_url = QSL("https://github.com/%1/%2/%3").arg(gh_username, gh_repo, github_feed);
-      res = NetworkFactory::performNetworkOperation(my_url,
-                                                    timeout,
-                                                    {},
-                                                    data,
-                                                    QNetworkAccessManager::Operation::GetOperation,
-                                                    {},
-                                                    {},
-                                                    {},
-                                                    {},
-                                                    root->networkProxy());
+      res = session.fetch(my_url, data);
 
       if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
         try {
@@ -222,16 +177,7 @@ QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
 
     if (!youtube_channel_id.isEmpty()) {
       my_url = QSL("https://www.youtube.com/feeds/videos.xml?channel_id=%1").arg(youtube_channel_id);
-      res = NetworkFactory::performNetworkOperation(my_url,
-                                                    timeout,
-                                                    {},
-                                                    data,
-                                                    QNetworkAccessManager::Operation::GetOperation,
-                                                    {},
-                                                    {},
-                                                    {},
-                                                    {},
-                                                    root->networkProxy());
+      res = session.fetch(my_url, data);
 
       if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
         try {
@@ -251,16 +197,7 @@ QList<StandardFeed*> AtomParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
 
   if (my_url.contains(QSL("reddit.com")) && !my_url.endsWith(QSL(".rss"))) {
     my_url += QSL(".rss");
-    res = NetworkFactory::performNetworkOperation(my_url,
-                                                  timeout,
-                                                  {},
-                                                  data,
-                                                  QNetworkAccessManager::Operation::GetOperation,
-                                                  {},
-                                                  {},
-                                                  {},
-                                                  {},
-                                                  root->networkProxy());
+    res = session.fetch(my_url, data);
 
     if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
       try {
@@ -15,7 +15,7 @@ class AtomParser : public FeedParser {
     explicit AtomParser(const QString& data);
     virtual ~AtomParser();
 
-    virtual QList<StandardFeed*> discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const;
+    virtual QList<StandardFeed*> discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const;
 
     virtual QPair<StandardFeed*, QList<IconLocation>> guessFeed(const QByteArray& content,
                                                                 const NetworkResult& network_res) const;
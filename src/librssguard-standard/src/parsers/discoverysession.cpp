@@ -0,0 +1,99 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "src/parsers/discoverysession.h"
+
+#include "src/definitions.h"
+
+#include <librssguard/miscellaneous/application.h>
+#include <librssguard/miscellaneous/settings.h>
+#include <librssguard/services/abstract/serviceroot.h>
+
+DiscoverySession::DiscoverySession(ServiceRoot* root)
+  : m_root(root), m_timeout(qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt()) {
+  // Cost of cached response is its size in kilobytes.
+  m_responses.setMaxCost(DISCOVERY_CACHE_SIZE);
+}
+
+NetworkResult DiscoverySession::fetch(const QString& url, QByteArray& data) {
+  const QString host = QUrl(url).host();
+  QMutexLocker lck(&m_mutex);
+
+  // Another parser may be downloading the very same URL, wait for it.
+  while (m_pendingUrls.contains(url)) {
+    m_changed.wait(&m_mutex);
+  }
+
+  if (Response* cached = m_responses.object(url)) {
+    data = cached->m_data;
+    return cached->m_result;
+  }
+
+  m_pendingUrls.insert(url);
+  acquireHost(host);
+  lck.unlock();
+
+  NetworkResult res = NetworkFactory::performNetworkOperation(url,
+                                                              m_timeout,
+                                                              {},
+                                                              data,
+                                                              QNetworkAccessManager::Operation::GetOperation,
+                                                              {},
+                                                              {},
+                                                              {},
+                                                              {},
+                                                              m_root->networkProxy());
+
+  lck.relock();
+  releaseHost(host);
+  m_pendingUrls.remove(url);
+  m_responses.insert(url, new Response{res, data}, 1 + int(data.size() / 1024));
+  m_changed.wakeAll();
+
+  return res;
+}
+
+QPixmap DiscoverySession::icon(const QString& url) {
+  const QString host = QUrl::fromUserInput(url).host();
+  QMutexLocker lck(&m_mutex);
+
+  while (m_pendingIcons.contains(host)) {
+    m_changed.wait(&m_mutex);
+  }
+
+  if (m_icons.contains(host)) {
+    return m_icons.value(host);
+  }
+
+  m_pendingIcons.insert(host);
+  acquireHost(host);
+  lck.unlock();
+
+  QPixmap icon;
+
+  if (NetworkFactory::downloadIcon({{url, false}}, m_timeout, icon, {}, m_root->networkProxy()) !=
+      QNetworkReply::NetworkError::NoError) {
+    icon = QPixmap();
+  }
+
+  lck.relock();
+  releaseHost(host);
+  m_pendingIcons.remove(host);
+  m_icons.insert(host, icon);
+  m_changed.wakeAll();
+
+  return icon;
+}
+
+void DiscoverySession::acquireHost(const QString& host) {
+  while (m_activeRequests.value(host) >= DISCOVERY_MAX_REQUESTS_PER_HOST) {
+    m_changed.wait(&m_mutex);
+  }
+
+  m_activeRequests[host]++;
+}
+
+void DiscoverySession::releaseHost(const QString& host) {
+  if (--m_activeRequests[host] <= 0) {
+    m_activeRequests.remove(host);
+  }
+}
@@ -0,0 +1,59 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef DISCOVERYSESSION_H
+#define DISCOVERYSESSION_H
+
+#include <librssguard/network-web/networkfactory.h>
+
+#include <QCache>
+#include <QHash>
+#include <QMutex>
+#include <QPixmap>
+#include <QSet>
+#include <QWaitCondition>
+
+class ServiceRoot;
+
+// State shared by all feed parsers during single feed discovery.
+//
+// Each URL is downloaded only once and its response is then handed
+// to all parsers, which run concurrently. Favicons are fetched once
+// per host and number of parallel requests to single host is capped.
+class DiscoverySession {
+  public:
+    explicit DiscoverySession(ServiceRoot* root);
+
+    ServiceRoot* root() const;
+
+    // Downloads given URL or returns its cached response.
+    NetworkResult fetch(const QString& url, QByteArray& data);
+
+    // Returns favicon of host of given URL.
+    QPixmap icon(const QString& url);
+
+  private:
+    struct Response {
+        NetworkResult m_result;
+        QByteArray m_data;
+    };
+
+    void acquireHost(const QString& host);
+    void releaseHost(const QString& host);
+
+  private:
+    ServiceRoot* m_root;
+    int m_timeout;
+    QMutex m_mutex;
+    QWaitCondition m_changed;
+    QCache<QString, Response> m_responses;
+    QSet<QString> m_pendingUrls;
+    QHash<QString, int> m_activeRequests;
+    QHash<QString, QPixmap> m_icons;
+    QSet<QString> m_pendingIcons;
+};
+
+inline ServiceRoot* DiscoverySession::root() const {
+  return m_root;
+}
+
+#endif // DISCOVERYSESSION_H
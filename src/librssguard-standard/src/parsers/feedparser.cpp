@@ -3,6 +3,7 @@
 #include "src/parsers/feedparser.h"
 
 #include "src/definitions.h"
+#include "src/parsers/discoverysession.h"
 
 #include <librssguard/definitions/definitions.h>
 #include <librssguard/exceptions/applicationexception.h>
@@ -48,8 +49,8 @@ FeedParser::FeedParser(QString data, DataType is_xml)
 
 FeedParser::~FeedParser() {}
 
-QList<StandardFeed*> FeedParser::discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const {
-  Q_UNUSED(root)
+QList<StandardFeed*> FeedParser::discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const {
+  Q_UNUSED(session)
   Q_UNUSED(greedy)
 
   if (url.isLocalFile()) {
@@ -172,9 +173,7 @@ QString FeedParser::objMessageRawContents(const QVariant& msg_element) const {
 }
 
 QList<Message> FeedParser::messages() {
-  QString feed_author = feedAuthor();
   QList<Message> messages;
-  QDateTime current_time = QDateTime::currentDateTimeUtc();
 
   // Pull out all messages.
   if (m_dataType == DataType::Xml) {
@@ -256,6 +255,14 @@ QList<Message> FeedParser::messages() {
     }
   }
 
+  fixupMessages(messages);
+  return messages;
+}
+
+void FeedParser::fixupMessages(QList<Message>& messages) const {
+  QString feed_author = feedAuthor();
+  QDateTime current_time = QDateTime::currentDateTimeUtc();
+
   // Fixup missing data.
   //
   // NOTE: Message must have "title" field, otherwise it is skipped.
@@ -301,8 +308,6 @@ QList<Message> FeedParser::messages() {
 
     new_message.m_url = new_message.m_url.replace(reg_non_url, {});
   }
-
-  return messages;
 }
 
 QList<Enclosure> FeedParser::xmlMrssGetEnclosures(const QDomElement& msg_element) const {
@@ -14,6 +14,8 @@
 #include <QJsonObject>
 #include <QString>
 
+class DiscoverySession;
+
 // Base class for all XML-based feed parsers.
 class FeedParser {
   public:
@@ -28,7 +30,7 @@ class FeedParser {
     virtual ~FeedParser();
 
     // Returns list of absolute URLs of discovered feeds from provided base URL.
-    virtual QList<StandardFeed*> discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const;
+    virtual QList<StandardFeed*> discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const;
 
     // Guesses feed.
     virtual QPair<StandardFeed*, QList<IconLocation>> guessFeed(const QByteArray& content,
@@ -84,6 +86,10 @@ class FeedParser {
     virtual QString objMessageRawContents(const QVariant& msg_element) const;
 
   protected:
+    // Fills missing titles, authors and dates of parsed messages
+    // and removes messages which cannot be fixed.
+    void fixupMessages(QList<Message>& messages) const;
+
     QList<Enclosure> xmlMrssGetEnclosures(const QDomElement& msg_element) const;
     QString xmlMrssTextFromPath(const QDomElement& msg_element, const QString& xml_path) const;
     QString xmlRawChild(const QDomElement& container) const;
@@ -0,0 +1,111 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "src/parsers/gzipdevice.h"
+
+#include "src/3rd-party/qcompressor/qcompressor.h"
+#include "src/definitions.h"
+
+#include <limits>
+
+GzipDevice::GzipDevice(QIODevice* source, QObject* parent)
+  : QIODevice(parent), m_source(source), m_stream(), m_streamInitialized(false), m_streamFinished(false) {}
+
+GzipDevice::~GzipDevice() {
+  close();
+}
+
+bool GzipDevice::isSequential() const {
+  return true;
+}
+
+bool GzipDevice::open(OpenMode mode) {
+  if (mode != QIODevice::OpenModeFlag::ReadOnly || isOpen()) {
+    return false;
+  }
+
+  m_stream.zalloc = Z_NULL;
+  m_stream.zfree = Z_NULL;
+  m_stream.opaque = Z_NULL;
+  m_stream.next_in = Z_NULL;
+  m_stream.avail_in = 0;
+
+  if (inflateInit2(&m_stream, GZIP_WINDOWS_BIT) != Z_OK) {
+    setErrorString(QObject::tr("gzip decompression cannot be initialized"));
+    return false;
+  }
+
+  m_streamInitialized = true;
+  m_streamFinished = false;
+
+  return QIODevice::open(mode);
+}
+
+void GzipDevice::close() {
+  if (m_streamInitialized) {
+    inflateEnd(&m_stream);
+    m_streamInitialized = false;
+  }
+
+  QIODevice::close();
+}
+
+qint64 GzipDevice::readData(char* data, qint64 max_size) {
+  if (!m_streamInitialized || m_streamFinished) {
+    return 0;
+  }
+
+  m_stream.next_out = reinterpret_cast<Bytef*>(data);
+  m_stream.avail_out = uInt(qMin(max_size, qint64(std::numeric_limits<uInt>::max())));
+
+  const uInt requested = m_stream.avail_out;
+
+  // NOTE: Inflate until at least some data are produced, returning zero
+  // bytes would make the reader think that stream has ended.
+  while (m_stream.avail_out == requested && !m_streamFinished) {
+    if (m_stream.avail_in == 0) {
+      m_input.resize(GZIP_INPUT_CHUNK_SIZE);
+
+      const qint64 input_size = m_source->read(m_input.data(), m_input.size());
+
+      if (input_size < 0) {
+        m_streamFinished = true;
+        setErrorString(m_source->errorString());
+        return -1;
+      }
+
+      if (input_size == 0) {
+        // Input data are truncated, return what we have.
+        m_streamFinished = true;
+        break;
+      }
+
+      m_stream.next_in = reinterpret_cast<Bytef*>(m_input.data());
+      m_stream.avail_in = uInt(input_size);
+    }
+
+    switch (inflate(&m_stream, Z_NO_FLUSH)) {
+      case Z_OK:
+      case Z_BUF_ERROR:
+        // NOTE: Buffer error means that more input is needed.
+        break;
+
+      case Z_STREAM_END:
+        m_streamFinished = true;
+        break;
+
+      default:
+        m_streamFinished = true;
+        setErrorString(QObject::tr("gzip decompression failed"));
+        return -1;
+    }
+  }
+
+  return qint64(requested - m_stream.avail_out);
+}
+
+qint64 GzipDevice::writeData(const char* data, qint64 max_size) {
+  Q_UNUSED(data)
+  Q_UNUSED(max_size)
+
+  return -1;
+}
@@ -0,0 +1,35 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef GZIPDEVICE_H
+#define GZIPDEVICE_H
+
+#include <QByteArray>
+#include <QIODevice>
+
+#include <zlib.h>
+
+// Read-only sequential device which decompresses gzipped data read from given
+// source device on the fly, so that neither compressed nor decompressed data
+// have to be held in memory as a whole. Source device must be opened already.
+class GzipDevice : public QIODevice {
+  public:
+    explicit GzipDevice(QIODevice* source, QObject* parent = nullptr);
+    virtual ~GzipDevice();
+
+    virtual bool isSequential() const;
+    virtual bool open(OpenMode mode);
+    virtual void close();
+
+  protected:
+    virtual qint64 readData(char* data, qint64 max_size);
+    virtual qint64 writeData(const char* data, qint64 max_size);
+
+  private:
+    QIODevice* m_source;
+    QByteArray m_input;
+    z_stream m_stream;
+    bool m_streamInitialized;
+    bool m_streamFinished;
+};
+
+#endif // GZIPDEVICE_H
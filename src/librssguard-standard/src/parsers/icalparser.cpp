@@ -3,6 +3,7 @@
 #include "src/parsers/icalparser.h"
 
 #include "src/definitions.h"
+#include "src/parsers/discoverysession.h"
 
 #include <librssguard/3rd-party/boolinq/boolinq.h>
 #include <librssguard/definitions/definitions.h>
@@ -17,8 +18,8 @@ IcalParser::IcalParser(const QString& data)
 
 IcalParser::~IcalParser() {}
 
-QList<StandardFeed*> IcalParser::discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const {
-  auto base_result = FeedParser::discoverFeeds(root, url, greedy);
+QList<StandardFeed*> IcalParser::discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const {
+  auto base_result = FeedParser::discoverFeeds(session, url, greedy);
 
   if (!base_result.isEmpty()) {
     return base_result;
@@ -27,18 +28,8 @@ QList<StandardFeed*> IcalParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
   QString my_url = url.toString();
 
   // Test direct URL for a feed.
-  int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
   QByteArray data;
-  auto res = NetworkFactory::performNetworkOperation(my_url,
-                                                     timeout,
-                                                     {},
-                                                     data,
-                                                     QNetworkAccessManager::Operation::GetOperation,
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     root->networkProxy());
+  auto res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -75,7 +75,7 @@ class IcalParser : public FeedParser {
     explicit IcalParser(const QString& data);
     virtual ~IcalParser();
 
-    virtual QList<StandardFeed*> discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const;
+    virtual QList<StandardFeed*> discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const;
 
     virtual QPair<StandardFeed*, QList<IconLocation>> guessFeed(const QByteArray& content,
                                                                 const NetworkResult& network_res) const;
@@ -3,6 +3,7 @@
 #include "src/parsers/jsonparser.h"
 
 #include "src/definitions.h"
+#include "src/parsers/discoverysession.h"
 #include "src/standardfeed.h"
 
 #include <librssguard/definitions/definitions.h>
@@ -20,8 +21,8 @@ JsonParser::JsonParser(const QString& data) : FeedParser(data, DataType::Json) {
 
 JsonParser::~JsonParser() {}
 
-QList<StandardFeed*> JsonParser::discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const {
-  auto base_result = FeedParser::discoverFeeds(root, url, greedy);
+QList<StandardFeed*> JsonParser::discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const {
+  auto base_result = FeedParser::discoverFeeds(session, url, greedy);
 
   if (!base_result.isEmpty()) {
     return base_result;
@@ -34,18 +35,8 @@ QList<StandardFeed*> JsonParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
   // 2. Test embedded JSON feed links from HTML data.
 
   // Download URL.
-  int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
   QByteArray data;
-  auto res = NetworkFactory::performNetworkOperation(my_url,
-                                                     timeout,
-                                                     {},
-                                                     data,
-                                                     QNetworkAccessManager::Operation::GetOperation,
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     root->networkProxy());
+  auto res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -82,16 +73,7 @@ QList<StandardFeed*> JsonParser::discoverFeeds(ServiceRoot* root, const QUrl& ur
       }
 
       QByteArray data;
-      auto res = NetworkFactory::performNetworkOperation(feed_link,
-                                                         timeout,
-                                                         {},
-                                                         data,
-                                                         QNetworkAccessManager::Operation::GetOperation,
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         root->networkProxy());
+      auto res = session.fetch(feed_link, data);
 
       if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
         try {
@@ -12,7 +12,7 @@ class JsonParser : public FeedParser {
     explicit JsonParser(const QString& data);
     virtual ~JsonParser();
 
-    virtual QList<StandardFeed*> discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const;
+    virtual QList<StandardFeed*> discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const;
 
     virtual QPair<StandardFeed*, QList<IconLocation>> guessFeed(const QByteArray& content,
                                                                 const NetworkResult& network_res) const;
@@ -3,6 +3,7 @@
 #include "src/parsers/rdfparser.h"
 
 #include "src/definitions.h"
+#include "src/parsers/discoverysession.h"
 #include "src/standardfeed.h"
 
 #include <librssguard/exceptions/applicationexception.h>
@@ -19,8 +20,8 @@ RdfParser::RdfParser(const QString& data)
 
 RdfParser::~RdfParser() {}
 
-QList<StandardFeed*> RdfParser::discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const {
-  auto base_result = FeedParser::discoverFeeds(root, url, greedy);
+QList<StandardFeed*> RdfParser::discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const {
+  auto base_result = FeedParser::discoverFeeds(session, url, greedy);
 
   if (!base_result.isEmpty()) {
     return base_result;
@@ -35,18 +36,8 @@ QList<StandardFeed*> RdfParser::discoverFeeds(ServiceRoot* root, const QUrl& url
   // 4. Test "URL/rdf" endpoint.
 
   // Download URL.
-  int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
   QByteArray data;
-  auto res = NetworkFactory::performNetworkOperation(my_url,
-                                                     timeout,
-                                                     {},
-                                                     data,
-                                                     QNetworkAccessManager::Operation::GetOperation,
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     root->networkProxy());
+  auto res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -83,16 +74,7 @@ QList<StandardFeed*> RdfParser::discoverFeeds(ServiceRoot* root, const QUrl& url
       }
 
       QByteArray data;
-      auto res = NetworkFactory::performNetworkOperation(feed_link,
-                                                         timeout,
-                                                         {},
-                                                         data,
-                                                         QNetworkAccessManager::Operation::GetOperation,
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         root->networkProxy());
+      auto res = session.fetch(feed_link, data);
 
       if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
         try {
@@ -110,16 +92,7 @@ QList<StandardFeed*> RdfParser::discoverFeeds(ServiceRoot* root, const QUrl& url
 
   // 3.
   my_url = url.toString(QUrl::UrlFormattingOption::StripTrailingSlash) + QSL("/feed");
-  res = NetworkFactory::performNetworkOperation(my_url,
-                                                timeout,
-                                                {},
-                                                data,
-                                                QNetworkAccessManager::Operation::GetOperation,
-                                                {},
-                                                {},
-                                                {},
-                                                {},
-                                                root->networkProxy());
+  res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -134,16 +107,7 @@ QList<StandardFeed*> RdfParser::discoverFeeds(ServiceRoot* root, const QUrl& url
 
   // 4.
   my_url = url.toString(QUrl::UrlFormattingOption::StripTrailingSlash) + QSL("/rdf");
-  res = NetworkFactory::performNetworkOperation(my_url,
-                                                timeout,
-                                                {},
-                                                data,
-                                                QNetworkAccessManager::Operation::GetOperation,
-                                                {},
-                                                {},
-                                                {},
-                                                {},
-                                                root->networkProxy());
+  res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -14,7 +14,7 @@ class RdfParser : public FeedParser {
     explicit RdfParser(const QString& data);
     virtual ~RdfParser();
 
-    virtual QList<StandardFeed*> discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const;
+    virtual QList<StandardFeed*> discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const;
 
     virtual QPair<StandardFeed*, QList<IconLocation>> guessFeed(const QByteArray& content,
                                                                 const NetworkResult& network_res) const;
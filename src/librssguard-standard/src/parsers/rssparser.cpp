@@ -3,6 +3,7 @@
 #include "src/parsers/rssparser.h"
 
 #include "src/definitions.h"
+#include "src/parsers/discoverysession.h"
 #include "src/standardfeed.h"
 
 #include <librssguard/exceptions/applicationexception.h>
@@ -19,8 +20,8 @@ RssParser::RssParser(const QString& data) : FeedParser(data) {}
 
 RssParser::~RssParser() {}
 
-QList<StandardFeed*> RssParser::discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const {
-  auto base_result = FeedParser::discoverFeeds(root, url, greedy);
+QList<StandardFeed*> RssParser::discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const {
+  auto base_result = FeedParser::discoverFeeds(session, url, greedy);
 
   if (!base_result.isEmpty()) {
     return base_result;
@@ -35,18 +36,8 @@ QList<StandardFeed*> RssParser::discoverFeeds(ServiceRoot* root, const QUrl& url
   // 4. Test "URL/rss" endpoint.
 
   // Download URL.
-  int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
   QByteArray data;
-  auto res = NetworkFactory::performNetworkOperation(my_url,
-                                                     timeout,
-                                                     {},
-                                                     data,
-                                                     QNetworkAccessManager::Operation::GetOperation,
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     {},
-                                                     root->networkProxy());
+  auto res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -83,16 +74,7 @@ QList<StandardFeed*> RssParser::discoverFeeds(ServiceRoot* root, const QUrl& url
       }
 
       QByteArray data;
-      auto res = NetworkFactory::performNetworkOperation(feed_link,
-                                                         timeout,
-                                                         {},
-                                                         data,
-                                                         QNetworkAccessManager::Operation::GetOperation,
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         {},
-                                                         root->networkProxy());
+      auto res = session.fetch(feed_link, data);
 
       if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
         try {
@@ -110,16 +92,7 @@ QList<StandardFeed*> RssParser::discoverFeeds(ServiceRoot* root, const QUrl& url
 
   // 3.
   my_url = url.toString(QUrl::UrlFormattingOption::StripTrailingSlash) + QSL("/feed");
-  res = NetworkFactory::performNetworkOperation(my_url,
-                                                timeout,
-                                                {},
-                                                data,
-                                                QNetworkAccessManager::Operation::GetOperation,
-                                                {},
-                                                {},
-                                                {},
-                                                {},
-                                                root->networkProxy());
+  res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -134,16 +107,7 @@ QList<StandardFeed*> RssParser::discoverFeeds(ServiceRoot* root, const QUrl& url
 
   // 4.
   my_url = url.toString(QUrl::UrlFormattingOption::StripTrailingSlash) + QSL("/rss");
-  res = NetworkFactory::performNetworkOperation(my_url,
-                                                timeout,
-                                                {},
-                                                data,
-                                                QNetworkAccessManager::Operation::GetOperation,
-                                                {},
-                                                {},
-                                                {},
-                                                {},
-                                                root->networkProxy());
+  res = session.fetch(my_url, data);
 
   if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
     try {
@@ -3,27 +3,40 @@
 #include "src/parsers/sitemapparser.h"
 
 #if defined(ENABLE_COMPRESSED_SITEMAP)
-#include "src/3rd-party/qcompressor/qcompressor.h"
+#include "src/parsers/gzipdevice.h"
 #endif
 
 #include "src/definitions.h"
+#include "src/parsers/discoverysession.h"
 
 #include <librssguard/definitions/definitions.h>
 #include <librssguard/exceptions/applicationexception.h>
+#include <librssguard/exceptions/feedfetchexception.h>
 #include <librssguard/exceptions/feedrecognizedbutfailedexception.h>
-#include <librssguard/miscellaneous/settings.h>
+#include <librssguard/exceptions/ioexception.h>
+#include <librssguard/exceptions/networkexception.h>
+#include <librssguard/miscellaneous/application.h>
 #include <librssguard/miscellaneous/textfactory.h>
+#include <librssguard/network-web/networkreplydevice.h>
 
-#include <QDomDocument>
-#include <QTextCodec>
-#include <QTextStream>
+#include <QBuffer>
+#include <QFile>
+#include <QFuture>
+#include <QRegularExpression>
+#include <QThreadPool>
+#include <QXmlStreamWriter>
+#include <QtConcurrentRun>
 
-SitemapParser::SitemapParser(const QString& data) : FeedParser(data) {}
+#include <algorithm>
+
+SitemapParser::SitemapParser(const QByteArray& data)
+  : FeedParser(QString()), m_rawData(data), m_device(nullptr), m_timeout(DOWNLOAD_TIMEOUT),
+    m_proxy(QNetworkProxy::ProxyType::DefaultProxy) {}
 
 SitemapParser::~SitemapParser() {}
 
-QList<StandardFeed*> SitemapParser::discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const {
-  auto base_result = FeedParser::discoverFeeds(root, url, greedy);
+QList<StandardFeed*> SitemapParser::discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const {
+  auto base_result = FeedParser::discoverFeeds(session, url, greedy);
   QHash<QString, StandardFeed*> feeds;
 
   if (!base_result.isEmpty()) {
@@ -38,10 +51,8 @@ QList<StandardFeed*> SitemapParser::discoverFeeds(ServiceRoot* root, const QUrl&
   }
 
   QStringList to_process_sitemaps;
-  int sitemap_index_limit = 2;
-  int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
 
-  // 1. Direct URL test. If sitemap index, process its children. If found, stop if non-recursive
+  // 1. Direct URL test, sitemap indices are recognized as feeds too. If found, stop if non-recursive
   //    discovery is chosen.
   // 2. Process "URL/robots.txt" file.
   // 3. Process "URLHOST/robots.txt" file.
@@ -63,16 +74,7 @@ QList<StandardFeed*> SitemapParser::discoverFeeds(ServiceRoot* root, const QUrl&
   for (const QString& robots_url : to_process_robots) {
     // Download URL.
     QByteArray data;
-    auto res = NetworkFactory::performNetworkOperation(robots_url,
-                                                       timeout,
-                                                       {},
-                                                       data,
-                                                       QNetworkAccessManager::Operation::GetOperation,
-                                                       {},
-                                                       {},
-                                                       {},
-                                                       {},
-                                                       root->networkProxy());
+    auto res = session.fetch(robots_url, data);
 
     if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
       QRegularExpression rx(QSL("Sitemap: ?([^\\r\\n]+)"),
@@ -109,16 +111,7 @@ QList<StandardFeed*> SitemapParser::discoverFeeds(ServiceRoot* root, const QUrl&
 
     // Download URL.
     QByteArray data;
-    auto res = NetworkFactory::performNetworkOperation(my_url,
-                                                       timeout,
-                                                       {},
-                                                       data,
-                                                       QNetworkAccessManager::Operation::GetOperation,
-                                                       {},
-                                                       {},
-                                                       {},
-                                                       {},
-                                                       root->networkProxy());
+    auto res = session.fetch(my_url, data);
 
     if (res.m_networkError == QNetworkReply::NetworkError::NoError) {
       try {
@@ -130,12 +123,6 @@ QList<StandardFeed*> SitemapParser::discoverFeeds(ServiceRoot* root, const QUrl&
           break;
         }
       }
-      catch (const FeedRecognizedButFailedException& ex) {
-        // This is index.
-        if (sitemap_index_limit-- > 0) {
-          to_process_sitemaps.append(ex.arbitraryData().toStringList());
-        }
-      }
       catch (const ApplicationException&) {
         qDebugNN << LOGSEC_CORE << QUOTE_W_SPACE(my_url) << "is not a direct sitemap file.";
       }
@@ -147,69 +134,29 @@ QList<StandardFeed*> SitemapParser::discoverFeeds(ServiceRoot* root, const QUrl&
 
 QPair<StandardFeed*, QList<IconLocation>> SitemapParser::guessFeed(const QByteArray& content,
                                                                    const NetworkResult& network_res) const {
-  QByteArray uncompressed_content;
-
-  if (isGzip(content)) {
-#if defined(ENABLE_COMPRESSED_SITEMAP)
-    QCompressor::gzipDecompress(content, uncompressed_content);
-#else
-    throw FeedRecognizedButFailedException(QObject::tr("support for gzipped sitemaps is not enabled"));
-#endif
-  }
-  else {
-    uncompressed_content = content;
-  }
-
-  QString xml_schema_encoding = QSL(DEFAULT_FEED_ENCODING);
-  QString xml_contents_encoded;
-  QString enc =
-    QRegularExpression(QSL("encoding=\"([A-Z0-9\\-]+)\""), QRegularExpression::PatternOption::CaseInsensitiveOption)
-      .match(uncompressed_content)
-      .captured(1);
-
-  if (!enc.isEmpty()) {
-    // Some "encoding" attribute was found get the encoding
-    // out of it.
-    xml_schema_encoding = enc;
-  }
-
-  QTextCodec* custom_codec = QTextCodec::codecForName(xml_schema_encoding.toLocal8Bit());
-
-  if (custom_codec != nullptr) {
-    xml_contents_encoded = custom_codec->toUnicode(uncompressed_content);
-  }
-  else {
-    xml_contents_encoded = QString::fromUtf8(uncompressed_content);
-  }
+  QBuffer buffer;
 
-  // Feed XML was obtained, guess it now.
-  QDomDocument xml_document;
-  QString error_msg;
-  int error_line, error_column;
+  buffer.setData(content);
+  buffer.open(QIODevice::OpenModeFlag::ReadOnly);
 
-  if (!xml_document.setContent(xml_contents_encoded, true, &error_msg, &error_line, &error_column)) {
-    throw ApplicationException(QObject::tr("XML is not well-formed, %1").arg(error_msg));
-  }
-
-  QDomElement root_element = xml_document.documentElement();
-
-  if (root_element.tagName() == QSL("sitemapindex")) {
-    QStringList locs;
-    int i = 0;
-
-    for (QDomNodeList ndl = root_element.elementsByTagNameNS(sitemapNamespace(), QSL("loc")); i < ndl.size(); i++) {
-      locs << ndl.at(i).toElement().text();
-    }
+  QXmlStreamReader reader(openData(&buffer));
 
-    throw FeedRecognizedButFailedException(QObject::tr("sitemap indices are not supported"), locs);
+  // NOTE: Only root element is needed to recognize sitemap.
+  if (!reader.readNextStartElement()) {
+    throw ApplicationException(QObject::tr("XML is not well-formed, %1").arg(reader.errorString()));
   }
 
-  if (root_element.tagName() != QSL("urlset")) {
+  if (reader.name() != QL1S("urlset") && reader.name() != QL1S("sitemapindex")) {
     throw ApplicationException(QObject::tr("not a Sitemap"));
   }
 
   auto* feed = new StandardFeed();
   QList<IconLocation> icon_possible_locations;
+  QString xml_schema_encoding = reader.documentEncoding().toString();
+
+  if (xml_schema_encoding.isEmpty()) {
+    xml_schema_encoding = QSL(DEFAULT_FEED_ENCODING);
+  }
 
   feed->setEncoding(xml_schema_encoding);
   feed->setType(StandardFeed::Type::Sitemap);
@@ -219,97 +166,362 @@ QPair<StandardFeed*, QList<IconLocation>> SitemapParser::guessFeed(const QByteAr
   return {feed, icon_possible_locations};
 }
 
-QString SitemapParser::sitemapNamespace() const {
-  return QSL("http://www.sitemaps.org/schemas/sitemap/0.9");
+QList<Message> SitemapParser::messages() {
+  QList<Message> messages;
+  QList<ChildSitemap> children;
+  QBuffer buffer;
+
+  if (m_device != nullptr) {
+    parseSitemap(m_device, messages, children);
+  }
+  else {
+    buffer.setData(m_rawData);
+    buffer.open(QIODevice::OpenModeFlag::ReadOnly);
+
+    parseSitemap(&buffer, messages, children);
+  }
+
+  if (!children.isEmpty()) {
+    messages.append(crawlChildSitemaps(children));
+  }
+
+  fixupMessages(messages);
+  return messages;
 }
 
-QString SitemapParser::sitemapNewsNamespace() const {
-  return QSL("http://www.google.com/schemas/sitemap-news/0.9");
+void SitemapParser::setDevice(QIODevice* device) {
+  m_device = device;
 }
 
-QString SitemapParser::sitemapImageNamespace() const {
-  return QSL("http://www.google.com/schemas/sitemap-image/1.1");
+void SitemapParser::setLastFetched(const QDateTime& last_fetched) {
+  m_lastFetched = last_fetched;
 }
 
-QString SitemapParser::sitemapVideoNamespace() const {
-  return QSL("http://www.google.com/schemas/sitemap-video/1.1");
+void SitemapParser::setNetworkSetup(const QUrl& url,
+                                    int timeout,
+                                    const QList<QPair<QByteArray, QByteArray>>& headers,
+                                    const QPair<QByteArray, QByteArray>& auth_header,
+                                    const QNetworkProxy& proxy) {
+  m_url = url;
+  m_timeout = timeout;
+  m_headers = headers;
+  m_authHeader = auth_header;
+  m_proxy = proxy;
 }
 
-QDomNodeList SitemapParser::xmlMessageElements() {
-  return m_xml.elementsByTagNameNS(sitemapNamespace(), QSL("url"));
+QList<QPair<QByteArray, QByteArray>> SitemapParser::childHeaders(const QUrl& child_url) const {
+  QList<QPair<QByteArray, QByteArray>> headers = m_headers;
+
+  // NOTE: Children can point to any host, credentials of the index
+  // must not leak to them.
+  if (!m_authHeader.first.isEmpty() && !m_url.host().isEmpty() &&
+      child_url.scheme().compare(m_url.scheme(), Qt::CaseSensitivity::CaseInsensitive) == 0 &&
+      child_url.host().compare(m_url.host(), Qt::CaseSensitivity::CaseInsensitive) == 0 &&
+      child_url.port() == m_url.port()) {
+    headers << m_authHeader;
+  }
+
+  return headers;
 }
 
-QString SitemapParser::xmlMessageTitle(const QDomElement& msg_element) const {
-  QString str_title = msg_element.elementsByTagNameNS(sitemapNewsNamespace(), QSL("title")).at(0).toElement().text();
+void SitemapParser::parseSitemap(QIODevice* source, QList<Message>& messages, QList<ChildSitemap>& children) {
+  QXmlStreamReader reader(openData(source));
+
+  if (!reader.readNextStartElement()) {
+    throwReadError(source, reader);
+  }
+
+  const bool is_index = reader.name() == QL1S("sitemapindex");
 
-  if (str_title.isEmpty()) {
-    str_title = msg_element.elementsByTagNameNS(sitemapVideoNamespace(), QSL("title")).at(0).toElement().text();
+  if (!is_index && reader.name() != QL1S("urlset")) {
+    throw FeedFetchException(Feed::Status::ParsingError, QObject::tr("not a Sitemap"));
   }
 
-  if (str_title.isEmpty()) {
-    str_title = msg_element.elementsByTagNameNS(sitemapImageNamespace(), QSL("title")).at(0).toElement().text();
+  while (reader.readNextStartElement()) {
+    if (is_index && reader.name() == QL1S("sitemap")) {
+      children.append(parseChildSitemap(reader));
+    }
+    else if (!is_index && reader.name() == QL1S("url")) {
+      messages.append(parseUrl(reader));
+    }
+    else {
+      reader.skipCurrentElement();
+    }
   }
 
-  return str_title;
+  if (reader.hasError()) {
+    throwReadError(source, reader);
+  }
 }
 
-QString SitemapParser::xmlMessageUrl(const QDomElement& msg_element) const {
-  return msg_element.elementsByTagNameNS(sitemapNamespace(), QSL("loc")).at(0).toElement().text();
-}
+Message SitemapParser::parseUrl(QXmlStreamReader& reader) {
+  Message msg;
+  QString raw_contents, text, all_text;
+  QString lastmod, publication_date, news_title, video_title, image_title;
+  QString image_loc, video_player_loc, video_content_loc;
+  QXmlStreamWriter raw_writer(&raw_contents);
+  int depth = 0;
+
+  // NOTE: Element is processed token by token, so that its
+  // raw XML can be written out at the same time.
+  while (true) {
+    if (!m_dontUseRawXmlSaving) {
+      raw_writer.writeCurrentToken(reader);
+    }
 
-QString SitemapParser::xmlMessageDescription(const QDomElement& msg_element) const {
-  return xmlRawChild(msg_element.elementsByTagNameNS(sitemapVideoNamespace(), QSL("description")).at(0).toElement());
+    if (reader.isStartElement()) {
+      depth++;
+      text.clear();
+    }
+    else if (reader.isCharacters()) {
+      text += reader.text();
+      all_text += reader.text();
+    }
+    else if (reader.isEndElement()) {
+      const QString ns = reader.namespaceUri().toString();
+      const QString name = reader.name().toString();
+
+      depth--;
+
+      if (ns.isEmpty() || ns == sitemapNamespace()) {
+        if (name == QSL("loc")) {
+          msg.m_url = text.trimmed();
+        }
+        else if (name == QSL("lastmod")) {
+          lastmod = text.trimmed();
+        }
+      }
+      else if (ns == sitemapNewsNamespace()) {
+        if (name == QSL("title")) {
+          news_title = text;
+        }
+        else if (name == QSL("publication_date")) {
+          publication_date = text.trimmed();
+        }
+      }
+      else if (ns == sitemapImageNamespace()) {
+        if (name == QSL("loc")) {
+          image_loc = text.trimmed();
+        }
+        else if (name == QSL("title") && image_title.isEmpty()) {
+          image_title = text;
+        }
+        else if (name == QSL("image") && !image_loc.isEmpty()) {
+          // NOTE: The MIME is made up.
+          msg.m_enclosures.append(Enclosure(image_loc, QSL("image/png")));
+          image_loc.clear();
+        }
+      }
+      else if (ns == sitemapVideoNamespace()) {
+        if (name == QSL("player_loc")) {
+          video_player_loc = text.trimmed();
+        }
+        else if (name == QSL("content_loc")) {
+          video_content_loc = text.trimmed();
+        }
+        else if (name == QSL("title") && video_title.isEmpty()) {
+          video_title = text;
+        }
+        else if (name == QSL("description") && msg.m_contents.isEmpty()) {
+          msg.m_contents = text;
+        }
+        else if (name == QSL("video")) {
+          QString loc = video_player_loc.isEmpty() ? video_content_loc : video_player_loc;
+
+          if (!loc.isEmpty()) {
+            // NOTE: The MIME is made up.
+            msg.m_enclosures.append(Enclosure(loc, QSL("video/mpeg")));
+          }
+
+          video_player_loc.clear();
+          video_content_loc.clear();
+        }
+      }
+    }
+
+    if (depth <= 0 || reader.atEnd()) {
+      break;
+    }
+
+    reader.readNext();
+  }
+
+  msg.m_customId = msg.m_url;
+  msg.m_title = !news_title.isEmpty() ? news_title : (!video_title.isEmpty() ? video_title : image_title);
+  msg.m_created = TextFactory::parseDateTime(lastmod.isEmpty() ? publication_date : lastmod, &m_dateTimeFormat);
+  msg.m_rawContents = m_dontUseRawXmlSaving ? all_text : raw_contents;
+
+  return msg;
 }
 
-QDateTime SitemapParser::xmlMessageDateCreated(const QDomElement& msg_element) {
-  QString str_date = msg_element.elementsByTagNameNS(sitemapNamespace(), QSL("lastmod")).at(0).toElement().text();
+SitemapParser::ChildSitemap SitemapParser::parseChildSitemap(QXmlStreamReader& reader) {
+  ChildSitemap child;
 
-  if (str_date.isEmpty()) {
-    str_date =
-      msg_element.elementsByTagNameNS(sitemapNewsNamespace(), QSL("publication_date")).at(0).toElement().text();
+  while (reader.readNextStartElement()) {
+    if (reader.name() == QL1S("loc")) {
+      child.m_url = reader.readElementText().trimmed();
+    }
+    else if (reader.name() == QL1S("lastmod")) {
+      child.m_lastModified = TextFactory::parseDateTime(reader.readElementText().trimmed());
+    }
+    else {
+      reader.skipCurrentElement();
+    }
   }
 
-  return TextFactory::parseDateTime(str_date, &m_dateTimeFormat);
+  return child;
 }
 
-QString SitemapParser::xmlMessageId(const QDomElement& msg_element) const {
-  return xmlMessageUrl(msg_element);
+QList<Message> SitemapParser::crawlChildSitemaps(QList<ChildSitemap> children) const {
+  const int all_children = children.size();
+
+  // Children which were not modified since last fetch are skipped,
+  // children without modification date cannot be skipped.
+  children.erase(std::remove_if(children.begin(),
+                                children.end(),
+                                [this](const ChildSitemap& child) {
+                                  return child.m_url.isEmpty() ||
+                                         (m_lastFetched.isValid() && child.m_lastModified.isValid() &&
+                                          child.m_lastModified < m_lastFetched);
+                                }),
+                 children.end());
+
+  // Most recently modified children are processed first.
+  std::stable_sort(children.begin(), children.end(), [](const ChildSitemap& lhs, const ChildSitemap& rhs) {
+    if (lhs.m_lastModified.isValid() != rhs.m_lastModified.isValid()) {
+      return !lhs.m_lastModified.isValid();
+    }
+
+    return lhs.m_lastModified > rhs.m_lastModified;
+  });
+
+  if (children.size() > SITEMAP_INDEX_MAX_CHILDREN) {
+    children = children.mid(0, SITEMAP_INDEX_MAX_CHILDREN);
+  }
+
+  qDebugNN << LOGSEC_CORE << "Sitemap index has" << NONQUOTE_W_SPACE(all_children) << "children, processing"
+           << NONQUOTE_W_SPACE(children.size()) << "of them.";
+
+  QThreadPool pool;
+  QList<QFuture<QList<Message>>> futures;
+
+  pool.setMaxThreadCount(SITEMAP_INDEX_FETCH_THREADS);
+
+  for (const ChildSitemap& child : std::as_const(children)) {
+    futures.append(QtConcurrent::run(&pool, [this, child]() {
+      return obtainChildSitemap(child.m_url);
+    }));
+  }
+
+  QList<Message> messages;
+
+  for (QFuture<QList<Message>>& future : futures) {
+    messages.append(future.result());
+  }
+
+  return messages;
 }
 
-QList<Enclosure> SitemapParser::xmlMessageEnclosures(const QDomElement& msg_element) const {
-  QList<Enclosure> enclosures;
+QList<Message> SitemapParser::obtainChildSitemap(const QString& url) const {
+  QList<Message> messages;
+
+  try {
+    const QUrl child_url(url);
+    QScopedPointer<QIODevice> source;
 
-  // sitemap-image
-  QDomNodeList elem_links = msg_element.elementsByTagNameNS(sitemapImageNamespace(), QSL("image"));
+    // NOTE: Child is parsed while it is being read, so it
+    // is never held in memory as a whole.
+    if (child_url.isLocalFile()) {
+      // NOTE: Remote index must not be able to read local files.
+      if (!m_url.isLocalFile()) {
+        throw ApplicationException(QObject::tr("local file is not allowed in remote sitemap index"));
+      }
 
-  for (int i = 0; i < elem_links.size(); i++) {
-    QDomElement link = elem_links.at(i).toElement();
-    QString loc = link.elementsByTagNameNS(sitemapImageNamespace(), QSL("loc")).at(0).toElement().text();
+      source.reset(new QFile(child_url.toLocalFile()));
 
-    if (!loc.isEmpty()) {
-      // NOTE: The MIME is made up.
-      enclosures.append(Enclosure(loc, QSL("image/png")));
+      if (!source->open(QIODevice::OpenModeFlag::ReadOnly)) {
+        throw IOException(source->errorString());
+      }
     }
-  }
+    else {
+      auto* reply = new NetworkReplyDevice(child_url, m_timeout, childHeaders(child_url), m_proxy);
+
+      source.reset(reply);
 
-  // sitemap-video
-  elem_links = msg_element.elementsByTagNameNS(sitemapVideoNamespace(), QSL("video"));
+      if (!reply->open(QIODevice::OpenModeFlag::ReadOnly)) {
+        throw NetworkException(reply->error());
+      }
+    }
 
-  for (int i = 0; i < elem_links.size(); i++) {
-    QDomElement link = elem_links.at(i).toElement();
-    QString loc = link.elementsByTagNameNS(sitemapVideoNamespace(), QSL("player_loc")).at(0).toElement().text();
+    SitemapParser child_parser({});
+    QList<ChildSitemap> nested_children;
 
-    if (loc.isEmpty()) {
-      loc = link.elementsByTagNameNS(sitemapVideoNamespace(), QSL("content_loc")).at(0).toElement().text();
+    child_parser.setDateTimeFormat(dateTimeFormat());
+    child_parser.setDontUseRawXmlSaving(dontUseRawXmlSaving());
+    child_parser.parseSitemap(source.data(), messages, nested_children);
+
+    if (!nested_children.isEmpty()) {
+      qWarningNN << LOGSEC_CORE << "Nested sitemap index" << QUOTE_W_SPACE(url) << "is not supported.";
     }
+  }
+  catch (const ApplicationException& ex) {
+    qWarningNN << LOGSEC_CORE << "Cannot obtain child sitemap" << QUOTE_W_SPACE(url)
+               << "error:" << QUOTE_W_SPACE_DOT(ex.message());
+  }
+
+  return messages;
+}
 
-    if (!loc.isEmpty()) {
-      // NOTE: The MIME is made up.
-      enclosures.append(Enclosure(loc, QSL("video/mpeg")));
+QIODevice* SitemapParser::openData(QIODevice* source) {
+  QIODevice* device = source;
+
+  if (isGzip(source->peek(2))) {
+#if defined(ENABLE_COMPRESSED_SITEMAP)
+    device = new GzipDevice(source, source);
+
+    if (!device->open(QIODevice::OpenModeFlag::ReadOnly)) {
+      throw ApplicationException(device->errorString());
     }
+#else
+    throw FeedRecognizedButFailedException(QObject::tr("support for gzipped sitemaps is not enabled"));
+#endif
+  }
+
+  // NOTE: Some XMLs have whitespace before XML declaration,
+  // which is not accepted by XML reader, skip it.
+  char chr;
+
+  while (device->peek(&chr, 1) == 1 && QChar(QL1C(chr)).isSpace()) {
+    device->skip(1);
   }
 
-  return enclosures;
+  return device;
+}
+
+void SitemapParser::throwReadError(QIODevice* source, const QXmlStreamReader& reader) {
+  auto* reply = qobject_cast<NetworkReplyDevice*>(source);
+
+  if (reply != nullptr && reply->error() != QNetworkReply::NetworkError::NoError) {
+    throw FeedFetchException(Feed::Status::NetworkError, NetworkFactory::networkErrorText(reply->error()));
+  }
+
+  throw FeedFetchException(Feed::Status::ParsingError, QObject::tr("XML problem: %1").arg(reader.errorString()));
+}
+
+QString SitemapParser::sitemapNamespace() const {
+  return QSL("http://www.sitemaps.org/schemas/sitemap/0.9");
+}
+
+QString SitemapParser::sitemapNewsNamespace() const {
+  return QSL("http://www.google.com/schemas/sitemap-news/0.9");
+}
+
+QString SitemapParser::sitemapImageNamespace() const {
+  return QSL("http://www.google.com/schemas/sitemap-image/1.1");
+}
+
+QString SitemapParser::sitemapVideoNamespace() const {
+  return QSL("http://www.google.com/schemas/sitemap-video/1.1");
 }
 
 bool SitemapParser::isGzip(const QByteArray& content) {
@@ -6,32 +6,85 @@
 #include "src/parsers/feedparser.h"
 #include "src/standardfeed.h"
 
+#include <QIODevice>
+#include <QNetworkProxy>
+#include <QUrl>
+#include <QXmlStreamReader>
+
+// Parses sitemaps and sitemap indices.
+//
+// Data are read with streaming XML reader, gzipped data are decompressed on the fly.
+// Downloaded sitemaps are parsed while they are being read from network reply.
+// Child sitemaps of sitemap index are downloaded and parsed concurrently, children
+// not modified since last successful fetch of the index are skipped. Children which
+// point to local files are read directly, but only if the index is local file too.
 class SitemapParser : public FeedParser {
   public:
-    explicit SitemapParser(const QString& data);
+    explicit SitemapParser(const QByteArray& data);
     virtual ~SitemapParser();
 
-    virtual QList<StandardFeed*> discoverFeeds(ServiceRoot* root, const QUrl& url, bool greedy) const;
+    virtual QList<StandardFeed*> discoverFeeds(DiscoverySession& session, const QUrl& url, bool greedy) const;
 
     virtual QPair<StandardFeed*, QList<IconLocation>> guessFeed(const QByteArray& content,
                                                                 const NetworkResult& network_res) const;
 
-    static bool isGzip(const QByteArray& content);
+    virtual QList<Message> messages();
+
+    // Sitemap is read from given opened device instead of data given
+    // to constructor, caller keeps ownership of the device.
+    void setDevice(QIODevice* device);
+
+    // Children of sitemap index with older "lastmod" are skipped.
+    void setLastFetched(const QDateTime& last_fetched);
 
-  protected:
-    virtual QDomNodeList xmlMessageElements();
-    virtual QString xmlMessageTitle(const QDomElement& msg_element) const;
-    virtual QString xmlMessageUrl(const QDomElement& msg_element) const;
-    virtual QString xmlMessageDescription(const QDomElement& msg_element) const;
-    virtual QDateTime xmlMessageDateCreated(const QDomElement& msg_element);
-    virtual QString xmlMessageId(const QDomElement& msg_element) const;
-    virtual QList<Enclosure> xmlMessageEnclosures(const QDomElement& msg_element) const;
+    // Setup used to download child sitemaps of sitemap index. Authentication
+    // header is sent only to children on the same host as the index itself.
+    void setNetworkSetup(const QUrl& url,
+                         int timeout,
+                         const QList<QPair<QByteArray, QByteArray>>& headers,
+                         const QPair<QByteArray, QByteArray>& auth_header,
+                         const QNetworkProxy& proxy);
+
+    // Returns HTTP headers used to download given child sitemap.
+    QList<QPair<QByteArray, QByteArray>> childHeaders(const QUrl& child_url) const;
+
+    static bool isGzip(const QByteArray& content);
 
   private:
+    struct ChildSitemap {
+        QString m_url;
+        QDateTime m_lastModified;
+    };
+
+    void parseSitemap(QIODevice* source, QList<Message>& messages, QList<ChildSitemap>& children);
+    Message parseUrl(QXmlStreamReader& reader);
+    ChildSitemap parseChildSitemap(QXmlStreamReader& reader);
+
+    QList<Message> crawlChildSitemaps(QList<ChildSitemap> children) const;
+    QList<Message> obtainChildSitemap(const QString& url) const;
+
+    // Returns device with (decompressed) data of given opened source, that is either
+    // the source itself or device reading from it, which is then owned by the source.
+    static QIODevice* openData(QIODevice* source);
+
+    // Failed download looks like truncated document to XML reader, network
+    // error is reported instead of XML error then.
+    static void throwReadError(QIODevice* source, const QXmlStreamReader& reader);
+
     QString sitemapNamespace() const;
     QString sitemapNewsNamespace() const;
     QString sitemapImageNamespace() const;
     QString sitemapVideoNamespace() const;
+
+  private:
+    QByteArray m_rawData;
+    QIODevice* m_device;
+    QDateTime m_lastFetched;
+    QUrl m_url;
+    int m_timeout;
+    QList<QPair<QByteArray, QByteArray>> m_headers;
+    QPair<QByteArray, QByteArray> m_authHeader;
+    QNetworkProxy m_proxy;
 };
 
 #endif // SITEMAPPARSER_H
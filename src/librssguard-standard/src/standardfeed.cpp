@@ -54,6 +54,7 @@ StandardFeed::StandardFeed(RootItem* parent_item) : Feed(parent_item) {
   m_password = QString();
   m_httpHeaders = {};
   m_dontUseRawXmlSaving = false;
+  m_prefetchFullArticles = false;
 }
 
 StandardFeed::StandardFeed(const StandardFeed& other) : Feed(other) {
@@ -65,6 +66,7 @@ StandardFeed::StandardFeed(const StandardFeed& other) : Feed(other) {
   m_username = other.username();
   m_password = other.password();
   m_dontUseRawXmlSaving = other.dontUseRawXmlSaving();
+  m_prefetchFullArticles = other.prefetchFullArticles();
   m_httpHeaders = other.httpHeaders();
 }
 
@@ -166,7 +168,10 @@ QVariantHash StandardFeed::customDatabaseData() const {
   data[QSL("username")] = username();
   data[QSL("password")] = TextFactory::encrypt(password());
   data[QSL("dont_use_raw_xml_saving")] = dontUseRawXmlSaving();
+  data[QSL("prefetch_full_articles")] = prefetchFullArticles();
   data[QSL("http_headers")] = httpHeaders();
+  data[QSL("last_successful_fetch")] =
+    lastSuccessfulFetch().isValid() ? lastSuccessfulFetch().toMSecsSinceEpoch() : qint64(0);
 
   return data;
 }
@@ -180,7 +185,12 @@ void StandardFeed::setCustomDatabaseData(const QVariantHash& data) {
   setUsername(data[QSL("username")].toString());
   setPassword(TextFactory::decrypt(data[QSL("password")].toString()));
   setDontUseRawXmlSaving(data[QSL("dont_use_raw_xml_saving")].toBool());
+  setPrefetchFullArticles(data[QSL("prefetch_full_articles")].toBool());
   setHttpHeaders(data[QSL("http_headers")].toHash());
+
+  const qint64 last_fetch = data[QSL("last_successful_fetch")].toLongLong();
+
+  setLastSuccessfulFetch(last_fetch > 0 ? QDateTime::fromMSecsSinceEpoch(last_fetch, Qt::TimeSpec::UTC) : QDateTime());
 }
 
 QString StandardFeed::typeToString(StandardFeed::Type type) {
@@ -461,6 +471,18 @@ void StandardFeed::setDontUseRawXmlSaving(bool no_raw_xml_saving) {
   m_dontUseRawXmlSaving = no_raw_xml_saving;
 }
 
+bool StandardFeed::prefetchFullArticles() const {
+  return m_prefetchFullArticles;
+}
+
+void StandardFeed::setPrefetchFullArticles(bool prefetch) {
+  m_prefetchFullArticles = prefetch;
+}
+
+QList<QPair<QByteArray, QByteArray>> StandardFeed::articleHttpHeaders() const {
+  return httpHeadersToList(httpHeaders());
+}
+
 QString StandardFeed::dateTimeFormat() const {
   return m_dateTimeFormat;
 }
@@ -477,6 +499,14 @@ void StandardFeed::setLastEtag(const QString& etag) {
   m_lastEtag = etag;
 }
 
+QDateTime StandardFeed::lastSuccessfulFetch() const {
+  return m_lastSuccessfulFetch;
+}
+
+void StandardFeed::setLastSuccessfulFetch(const QDateTime& last_fetch) {
+  m_lastSuccessfulFetch = last_fetch;
+}
+
 StandardFeed::Type StandardFeed::type() const {
   return m_type;
 }
@@ -51,6 +51,8 @@ class StandardFeed : public Feed {
     virtual void setCustomDatabaseData(const QVariantHash& data);
     virtual Qt::ItemFlags additionalFlags() const;
     virtual bool performDragDropChange(RootItem* target_item);
+    virtual bool prefetchFullArticles() const;
+    virtual QList<QPair<QByteArray, QByteArray>> articleHttpHeaders() const;
 
     // Other getters/setters.
     Type type() const;
@@ -111,12 +113,18 @@ class StandardFeed : public Feed {
     QString lastEtag() const;
     void setLastEtag(const QString& etag);
 
+    // Time when feed data were last successfully fetched and parsed.
+    QDateTime lastSuccessfulFetch() const;
+    void setLastSuccessfulFetch(const QDateTime& last_fetch);
+
     QString dateTimeFormat() const;
     void setDateTimeFormat(const QString& dt_format);
 
     bool dontUseRawXmlSaving() const;
     void setDontUseRawXmlSaving(bool no_raw_xml_saving);
 
+    void setPrefetchFullArticles(bool prefetch);
+
     // NOTE: Contains hash table where key is name of HTTP header.
     QVariantHash httpHeaders() const;
     void setHttpHeaders(const QVariantHash& http_headers);
@@ -138,7 +146,9 @@ class StandardFeed : public Feed {
     QString m_username;
     QString m_password;
     QString m_lastEtag;
+    QDateTime m_lastSuccessfulFetch;
     bool m_dontUseRawXmlSaving;
+    bool m_prefetchFullArticles;
     QVariantHash m_httpHeaders;
 };
 
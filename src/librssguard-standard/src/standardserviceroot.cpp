@@ -29,6 +29,8 @@
 #include <librssguard/miscellaneous/mutex.h>
 #include <librssguard/miscellaneous/settings.h>
 #include <librssguard/network-web/networkfactory.h>
+#include <librssguard/network-web/networkreplydevice.h>
+#include <librssguard/network-web/webfactory.h>
 #include <librssguard/services/abstract/gui/formcategorydetails.h>
 
 #if defined(NO_LITE)
@@ -55,13 +57,33 @@ StandardServiceRoot::~StandardServiceRoot() {
 }
 
 void StandardServiceRoot::onDatabaseCleanup() {
+  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+
   for (Feed* fd : getSubTreeFeeds()) {
-    qobject_cast<StandardFeed*>(fd)->setLastEtag({});
+    auto* std_feed = qobject_cast<StandardFeed*>(fd);
+
+    std_feed->setLastEtag({});
+
+    if (std_feed->lastSuccessfulFetch().isValid()) {
+      std_feed->setLastSuccessfulFetch({});
+
+      try {
+        DatabaseQueries::storeFeedCustomData(database, std_feed);
+      }
+      catch (const ApplicationException& ex) {
+        qWarningNN << LOGSEC_CORE << "Cannot reset time of last fetch of feed" << QUOTE_W_SPACE(std_feed->title())
+                   << "error:" << QUOTE_W_SPACE_DOT(ex.message());
+      }
+    }
   }
 }
 
+AccountStructure StandardServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  return DatabaseQueries::getAccountStructure<StandardCategory, StandardFeed>(db, accountId());
+}
+
 void StandardServiceRoot::start(bool freshly_activated) {
-  DatabaseQueries::loadRootFromDatabase<StandardCategory, StandardFeed>(this);
+  loadFromDatabase();
 
   if (freshly_activated && getSubTreeFeeds().isEmpty()) {
     // In other words, if there are no feeds or categories added.
@@ -204,8 +226,14 @@ QList<Message> StandardServiceRoot::obtainNewMessages(Feed* feed,
 
   StandardFeed* f = static_cast<StandardFeed*>(feed);
   QByteArray feed_contents;
+  QScopedPointer<NetworkReplyDevice> sitemap_reply;
   QString formatted_feed_contents;
   int download_timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
+  const QDateTime fetch_started = QDateTime::currentDateTimeUtc();
+
+  // Sitemap parser reads raw data on its own, including gzip-encoded data.
+  // They are decoded here only if post-processing script needs them.
+  const bool raw_sitemap = f->type() == StandardFeed::Type::Sitemap && f->postProcessScript().simplified().isEmpty();
 
   if (f->sourceType() == StandardFeed::SourceType::Url) {
     qDebugNN << LOGSEC_CORE << "Downloading URL" << QUOTE_W_SPACE(feed->source()) << "to obtain feed data.";
@@ -220,34 +248,58 @@ QList<Message> StandardServiceRoot::obtainNewMessages(Feed* feed,
       qDebugNN << "Using ETag value:" << QUOTE_W_SPACE_DOT(f->lastEtag());
     }
 
-    auto network_result = NetworkFactory::performNetworkOperation(feed->source(),
-                                                                  download_timeout,
-                                                                  {},
-                                                                  feed_contents,
-                                                                  QNetworkAccessManager::Operation::GetOperation,
-                                                                  headers,
-                                                                  false,
-                                                                  {},
-                                                                  {},
-                                                                  networkProxy());
-
-    if (network_result.m_networkError != QNetworkReply::NetworkError::NoError) {
-      qWarningNN << LOGSEC_CORE << "Error" << QUOTE_W_SPACE(network_result.m_networkError)
-                 << "during fetching of new messages for feed" << QUOTE_W_SPACE_DOT(feed->source());
-      throw FeedFetchException(Feed::Status::NetworkError,
-                               NetworkFactory::networkErrorText(network_result.m_networkError));
-    }
-    else {
-      f->setLastEtag(network_result.m_headers.value(QSL("etag")));
+    if (raw_sitemap) {
+      // NOTE: Sitemaps can be huge, they are parsed straight from
+      // network reply while they are being downloaded.
+      const QUrl sitemap_url(qApp->web()->processFeedUriScheme(NetworkFactory::sanitizeUrl(feed->source())));
+
+      sitemap_reply.reset(new NetworkReplyDevice(sitemap_url, download_timeout, headers, networkProxy()));
 
-      if (network_result.m_httpCode == HTTP_CODE_NOT_MODIFIED && feed_contents.trimmed().isEmpty()) {
-        // We very likely used "eTag" before and server reports that
-        // content was not modified since.
+      if (!sitemap_reply->open(QIODevice::OpenModeFlag::ReadOnly)) {
+        qWarningNN << LOGSEC_CORE << "Error" << QUOTE_W_SPACE(sitemap_reply->error())
+                   << "during fetching of new messages for feed" << QUOTE_W_SPACE_DOT(feed->source());
+        throw FeedFetchException(Feed::Status::NetworkError,
+                                 NetworkFactory::networkErrorText(sitemap_reply->error()));
+      }
+
+      f->setLastEtag(QString::fromLatin1(sitemap_reply->rawHeader(QByteArrayLiteral("ETag"))));
+
+      if (sitemap_reply->httpCode() == HTTP_CODE_NOT_MODIFIED) {
         qWarningNN << LOGSEC_CORE << QUOTE_W_SPACE(feed->source())
                    << "reported HTTP/304, meaning that the remote file did not change since last time we checked it.";
         return {};
       }
     }
+    else {
+      auto network_result = NetworkFactory::performNetworkOperation(feed->source(),
+                                                                    download_timeout,
+                                                                    {},
+                                                                    feed_contents,
+                                                                    QNetworkAccessManager::Operation::GetOperation,
+                                                                    headers,
+                                                                    false,
+                                                                    {},
+                                                                    {},
+                                                                    networkProxy());
+
+      if (network_result.m_networkError != QNetworkReply::NetworkError::NoError) {
+        qWarningNN << LOGSEC_CORE << "Error" << QUOTE_W_SPACE(network_result.m_networkError)
+                   << "during fetching of new messages for feed" << QUOTE_W_SPACE_DOT(feed->source());
+        throw FeedFetchException(Feed::Status::NetworkError,
+                                 NetworkFactory::networkErrorText(network_result.m_networkError));
+      }
+      else {
+        f->setLastEtag(network_result.m_headers.value(QSL("etag")));
+
+        if (network_result.m_httpCode == HTTP_CODE_NOT_MODIFIED && feed_contents.trimmed().isEmpty()) {
+          // We very likely used "eTag" before and server reports that
+          // content was not modified since.
+          qWarningNN << LOGSEC_CORE << QUOTE_W_SPACE(feed->source())
+                     << "reported HTTP/304, meaning that the remote file did not change since last time we checked it.";
+          return {};
+        }
+      }
+    }
   }
   else if (f->sourceType() == StandardFeed::SourceType::EmbeddedBrowser) {
 #if defined(NO_LITE)
@@ -276,7 +328,7 @@ QList<Message> StandardServiceRoot::obtainNewMessages(Feed* feed,
   // Sitemap parser supports gzip-encoded data too.
   // We need to decode it here before encoding
   // stuff kicks in.
-  if (SitemapParser::isGzip(feed_contents)) {
+  if (!raw_sitemap && SitemapParser::isGzip(feed_contents)) {
 #if defined(ENABLE_COMPRESSED_SITEMAP)
     qWarningNN << LOGSEC_CORE << "Decompressing gzipped feed data.";
 
@@ -310,7 +362,11 @@ QList<Message> StandardServiceRoot::obtainNewMessages(Feed* feed,
   // Encode obtained data for further parsing.
   QTextCodec* codec = QTextCodec::codecForName(f->encoding().toLocal8Bit());
 
-  if (codec == nullptr) {
+  if (f->type() == StandardFeed::Type::Sitemap) {
+    // NOTE: Sitemaps are passed to parser as raw data and decoded
+    // by XML reader according to their declared encoding.
+  }
+  else if (codec == nullptr) {
     // No suitable codec for this encoding was found.
     // Use UTF-8.
     formatted_feed_contents = QString::fromUtf8(feed_contents);
@@ -349,9 +405,33 @@ QList<Message> StandardServiceRoot::obtainNewMessages(Feed* feed,
       parser = new IcalParser(formatted_feed_contents);
       break;
 
-    case StandardFeed::Type::Sitemap:
-      parser = new SitemapParser(formatted_feed_contents);
+    case StandardFeed::Type::Sitemap: {
+      auto* sitemap_parser = new SitemapParser(feed_contents);
+      QUrl sitemap_url;
+
+      if (!sitemap_reply.isNull()) {
+        sitemap_parser->setDevice(sitemap_reply.data());
+      }
+
+      if (f->sourceType() == StandardFeed::SourceType::LocalFile) {
+        sitemap_url = QUrl::fromLocalFile(f->source());
+      }
+      else if (f->sourceType() != StandardFeed::SourceType::Script) {
+        sitemap_url = QUrl(f->source());
+      }
+
+      // Child sitemaps of sitemap index are downloaded with the same setup as the index.
+      sitemap_parser->setLastFetched(f->lastSuccessfulFetch());
+      sitemap_parser->setNetworkSetup(sitemap_url,
+                                      download_timeout,
+                                      StandardFeed::httpHeadersToList(f->httpHeaders()),
+                                      NetworkFactory::generateBasicAuthHeader(f->protection(),
+                                                                              f->username(),
+                                                                              f->password()),
+                                      networkProxy());
+      parser = sitemap_parser;
       break;
+    }
 
     default:
       break;
@@ -373,6 +453,22 @@ QList<Message> StandardServiceRoot::obtainNewMessages(Feed* feed,
 
   delete parser;
 
+  f->setLastSuccessfulFetch(fetch_started);
+
+  if (f->type() == StandardFeed::Type::Sitemap) {
+    // NOTE: Children of sitemap index are skipped according to time of last
+    // successful fetch, so it must survive restart of the application.
+    QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(metaObject()->className());
+
+    try {
+      DatabaseQueries::storeFeedCustomData(database, f);
+    }
+    catch (const ApplicationException& ex) {
+      qWarningNN << LOGSEC_CORE << "Cannot store time of last fetch of feed" << QUOTE_W_SPACE(f->title())
+                 << "error:" << QUOTE_W_SPACE_DOT(ex.message());
+    }
+  }
+
   for (Message& mess : messages) {
     mess.m_feedId = feed->customId();
   }
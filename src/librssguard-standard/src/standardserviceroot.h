@@ -49,6 +49,9 @@ class StandardServiceRoot : public ServiceRoot {
     void addNewFeed(RootItem* selected_item, const QString& url = QString());
     void addNewCategory(RootItem* selected_item);
 
+  protected:
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
+
   private slots:
     void importFeeds();
     void exportFeeds();
@@ -0,0 +1,117 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "definitions/definitions.h"
+#include "src/parsers/sitemapparser.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTest>
+
+// Checks sitemap parser against fixture files, child sitemaps
+// of sitemap index fixtures are local files too.
+class SitemapParserTest : public QObject {
+    Q_OBJECT
+
+  private slots:
+    void leadingWhitespaceIsSkipped();
+    void localIndexReadsLocalChildren();
+    void childrenOlderThanLastFetchAreSkipped();
+    void remoteIndexDoesNotReadLocalChildren();
+    void credentialsAreSentOnlyToSameHost();
+
+  private:
+    static QByteArray fixture(const QString& file_name);
+    static QByteArray sitemapIndex();
+    static QUrl fixtureUrl(const QString& file_name);
+};
+
+void SitemapParserTest::leadingWhitespaceIsSkipped() {
+  SitemapParser parser(fixture(QSL("urlset-whitespace.xml")));
+  QList<Message> messages = parser.messages();
+
+  QCOMPARE(messages.size(), 2);
+  QCOMPARE(messages.at(0).m_url, QSL("https://sitemap.rssguard.invalid/articles/first"));
+  QCOMPARE(messages.at(0).m_title, QSL("First article"));
+  QCOMPARE(messages.at(1).m_title, messages.at(1).m_url);
+}
+
+void SitemapParserTest::localIndexReadsLocalChildren() {
+  SitemapParser parser(sitemapIndex());
+
+  parser.setNetworkSetup(fixtureUrl(QSL("sitemap-index.xml")), DOWNLOAD_TIMEOUT, {}, {}, {});
+
+  QList<Message> messages = parser.messages();
+
+  QCOMPARE(messages.size(), 3);
+  QCOMPARE(messages.at(0).m_url, QSL("https://sitemap.rssguard.invalid/new/1"));
+  QCOMPARE(messages.at(2).m_url, QSL("https://sitemap.rssguard.invalid/old/1"));
+}
+
+void SitemapParserTest::childrenOlderThanLastFetchAreSkipped() {
+  SitemapParser parser(sitemapIndex());
+
+  parser.setNetworkSetup(fixtureUrl(QSL("sitemap-index.xml")), DOWNLOAD_TIMEOUT, {}, {}, {});
+  parser.setLastFetched(QDateTime(QDate(2024, 1, 1), QTime(0, 0), Qt::TimeSpec::UTC));
+
+  QList<Message> messages = parser.messages();
+
+  QCOMPARE(messages.size(), 2);
+  QCOMPARE(messages.at(1).m_url, QSL("https://sitemap.rssguard.invalid/new/2"));
+}
+
+void SitemapParserTest::remoteIndexDoesNotReadLocalChildren() {
+  SitemapParser parser(sitemapIndex());
+
+  parser.setNetworkSetup(QUrl(QSL("https://sitemap.rssguard.invalid/sitemap.xml")), DOWNLOAD_TIMEOUT, {}, {}, {});
+
+  QVERIFY(parser.messages().isEmpty());
+}
+
+void SitemapParserTest::credentialsAreSentOnlyToSameHost() {
+  const QPair<QByteArray, QByteArray> custom_header = {QByteArrayLiteral("X-Custom"), QByteArrayLiteral("value")};
+  const QPair<QByteArray, QByteArray> auth_header = {QByteArrayLiteral("Authorization"),
+                                                     QByteArrayLiteral("Basic dXNlcjpwYXNz")};
+  SitemapParser parser(QByteArray{});
+
+  parser.setNetworkSetup(QUrl(QSL("https://sitemap.rssguard.invalid/sitemap.xml")),
+                         DOWNLOAD_TIMEOUT,
+                         {custom_header},
+                         auth_header,
+                         {});
+
+  const auto same_host = parser.childHeaders(QUrl(QSL("https://SITEMAP.rssguard.invalid/child.xml")));
+  const auto other_host = parser.childHeaders(QUrl(QSL("https://other.rssguard.invalid/child.xml")));
+  const auto other_scheme = parser.childHeaders(QUrl(QSL("http://sitemap.rssguard.invalid/child.xml")));
+  const auto other_port = parser.childHeaders(QUrl(QSL("https://sitemap.rssguard.invalid:8443/child.xml")));
+
+  QVERIFY(same_host.contains(custom_header));
+  QVERIFY(same_host.contains(auth_header));
+  QVERIFY(other_host.contains(custom_header));
+  QVERIFY(!other_host.contains(auth_header));
+  QVERIFY(!other_scheme.contains(auth_header));
+  QVERIFY(!other_port.contains(auth_header));
+}
+
+QByteArray SitemapParserTest::fixture(const QString& file_name) {
+  QFile file(QDir(QSL(SITEMAP_FIXTURES_DIR)).absoluteFilePath(file_name));
+
+  if (!file.open(QIODevice::OpenModeFlag::ReadOnly)) {
+    qFatal("Fixture '%s' cannot be opened.", qPrintable(file.fileName()));
+  }
+
+  return file.readAll();
+}
+
+QByteArray SitemapParserTest::sitemapIndex() {
+  // NOTE: Index fixture has placeholder instead of URL of fixtures folder.
+  return fixture(QSL("sitemap-index.xml"))
+    .replace("@FIXTURES@", QUrl::fromLocalFile(QSL(SITEMAP_FIXTURES_DIR)).toEncoded());
+}
+
+QUrl SitemapParserTest::fixtureUrl(const QString& file_name) {
+  return QUrl::fromLocalFile(QDir(QSL(SITEMAP_FIXTURES_DIR)).absoluteFilePath(file_name));
+}
+
+QTEST_GUILESS_MAIN(SitemapParserTest)
+
+#include "sitemapparsertest.moc"
@@ -35,9 +35,13 @@ ServiceRoot::LabelOperation TtRssServiceRoot::supportedLabelOperations() const {
   return ServiceRoot::LabelOperation::Synchronised;
 }
 
+AccountStructure TtRssServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  return DatabaseQueries::getAccountStructure<Category, TtRssFeed>(db, accountId());
+}
+
 void TtRssServiceRoot::start(bool freshly_activated) {
   if (!freshly_activated) {
-    DatabaseQueries::loadRootFromDatabase<Category, TtRssFeed>(this);
+    loadFromDatabase();
     loadCacheFromFile();
 
     auto lbls = labelsNode()->labels();
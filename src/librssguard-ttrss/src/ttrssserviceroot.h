@@ -46,6 +46,7 @@ class TtRssServiceRoot : public ServiceRoot, public CacheForServiceRoot {
     void shareToPublished();
 
   protected:
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
     virtual RootItem* obtainNewTreeForSyncIn() const;
 
   private:
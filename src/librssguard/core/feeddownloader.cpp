@@ -11,6 +11,9 @@
 #include "miscellaneous/application.h"
 #include "miscellaneous/settings.h"
 #include "miscellaneous/thread.h"
+#include "miscellaneous/tracer.h"
+#include "network-web/articleextractor.h"
+#include "network-web/networkfactory.h"
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/feed.h"
 #include "services/abstract/labelsnode.h"
@@ -19,11 +22,14 @@
 #include <QJSEngine>
 #include <QString>
 #include <QtConcurrentMap>
+#include <QtConcurrentRun>
 
 FeedDownloader::FeedDownloader()
-  : QObject(), m_isCacheSynchronizationRunning(false), m_stopCacheSynchronization(false) {
+  : QObject(), m_isCacheSynchronizationRunning(false), m_stopCacheSynchronization(false), m_stopFeedUpdate(false) {
   qRegisterMetaType<FeedDownloadResults>("FeedDownloadResults");
 
+  m_prefetchPool.setMaxThreadCount(ARTICLE_PREFETCH_THREADS);
+
   connect(&m_watcherLookup, &QFutureWatcher<FeedUpdateResult>::resultReadyAt, this, [=](int idx) {
     FeedUpdateResult res = m_watcherLookup.resultAt(idx);
 
@@ -36,6 +42,9 @@ FeedDownloader::FeedDownloader()
 
 FeedDownloader::~FeedDownloader() {
   qDebugNN << LOGSEC_FEEDDOWNLOADER << "Destroying FeedDownloader instance.";
+
+  // NOTE: Workers of full article downloads access queues of this instance.
+  m_prefetchPool.waitForDone();
 }
 
 bool FeedDownloader::isUpdateRunning() const {
@@ -67,6 +76,7 @@ void FeedDownloader::synchronizeAccountCaches(const QList<CacheForServiceRoot*>&
 }
 
 void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
+  m_stopFeedUpdate = false;
   m_erroredAccounts.clear();
   m_results.clear();
   m_feeds.clear();
@@ -203,6 +213,7 @@ void FeedDownloader::skipFeedUpdateWithError(ServiceRoot* acc, Feed* feed, const
 
 void FeedDownloader::stopRunningUpdate() {
   m_stopCacheSynchronization = true;
+  m_stopFeedUpdate = true;
 
   m_watcherLookup.cancel();
   m_watcherLookup.waitForFinished();
@@ -214,10 +225,11 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
                                    Feed* feed,
                                    const QHash<ServiceRoot::BagOfMessages, QStringList>& stated_messages,
                                    const QHash<QString, QStringList>& tagged_messages) {
+  TRACE_SCOPE("feed-update", "fetch");
+
   feed->setStatus(Feed::Status::Fetching);
 
-  const bool update_feed_list =
-    qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateFeedListDuringFetching)).toBool();
+  const bool update_feed_list = qApp->settings()->snapshot()->m_updateFeedListDuringFetching;
 
   if (update_feed_list) {
     acc->itemChanged({feed});
@@ -235,14 +247,19 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
 
   try {
     QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(metaObject()->className());
+    TraceSpan span_fetch("feed-fetch-parse", "fetch");
     QList<Message> msgs = feed->getParentServiceRoot()->obtainNewMessages(feed, stated_messages, tagged_messages);
 
+    span_fetch.finish();
+    TRACE_COUNTER("feed-articles-fetched", msgs.size());
+
     qDebugNN << LOGSEC_FEEDDOWNLOADER << "Downloaded" << NONQUOTE_W_SPACE(msgs.size()) << "messages for feed ID"
              << QUOTE_W_SPACE_COMMA(feed->customId()) << "operation took" << NONQUOTE_W_SPACE(tmr.nsecsElapsed() / 1000)
              << "microseconds.";
 
-    bool fix_future_datetimes =
-      qApp->settings()->value(GROUP(Messages), SETTING(Messages::FixupFutureArticleDateTimes)).toBool();
+    bool fix_future_datetimes = qApp->settings()->snapshot()->m_fixupFutureArticleDateTimes;
+
+    TraceSpan span_sanitize("feed-sanitize", "fetch");
 
     // Now, sanitize messages (tweak encoding etc.).
     for (auto& msg : msgs) {
@@ -250,9 +267,16 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
       msg.sanitize(feed, fix_future_datetimes);
     }
 
+    span_sanitize.finish();
+
+    TraceSpan span_lock("feed-db-lock-wait", "db");
     QMutexLocker lck(&m_mutexDb);
 
+    span_lock.finish();
+
     if (!feed->messageFilters().isEmpty()) {
+      TRACE_SCOPE("feed-filter", "filter");
+
       tmr.restart();
 
       // Perform per-message filtering.
@@ -398,8 +422,11 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
     removeTooOldMessages(feed, msgs);
 
     tmr.restart();
+    TraceSpan span_db("feed-db-update", "db");
     auto updated_messages = acc->updateMessages(msgs, feed, false, nullptr);
 
+    span_db.finish();
+
     qDebugNN << LOGSEC_FEEDDOWNLOADER << "Updating messages in DB took" << NONQUOTE_W_SPACE(tmr.nsecsElapsed() / 1000)
              << "microseconds.";
 
@@ -413,7 +440,12 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
              << NONQUOTE_W_SPACE(updated_messages.m_all.size()) "total messages for feed"
              << QUOTE_W_SPACE(feed->customId()) << "stored in DB.";
 
-    m_results.appendUpdatedFeed(feed, updated_messages.m_unread);
+    m_results.appendUpdatedFeed(feed, updated_messages);
+    lck.unlock();
+
+    if (feed->prefetchFullArticles()) {
+      prefetchFullArticles(database, feed);
+    }
   }
   catch (const FeedFetchException& feed_ex) {
     qCriticalNN << LOGSEC_NETWORK << "Error when fetching feed:" << QUOTE_W_SPACE(feed_ex.feedStatus())
@@ -439,6 +471,20 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
 void FeedDownloader::finalizeUpdate() {
   qDebugNN << LOGSEC_FEEDDOWNLOADER << "Finished feed updates in thread" << QUOTE_W_SPACE_DOT(getThreadID());
 
+  // Counts of "special" nodes are refreshed only once per
+  // account, not after each updated feed.
+  QSet<ServiceRoot*> accounts;
+
+  for (const FeedUpdateRequest& fu : std::as_const(m_feeds)) {
+    accounts.insert(fu.account);
+  }
+
+  removeUnwantedArticles(accounts);
+
+  for (ServiceRoot* acc : std::as_const(accounts)) {
+    acc->updateCountsOfDirtyNodes();
+  }
+
   m_feeds.clear();
 
   // Update of feeds has finished.
@@ -448,6 +494,36 @@ void FeedDownloader::finalizeUpdate() {
   emit updateFinished(m_results);
 }
 
+void FeedDownloader::removeUnwantedArticles(const QSet<ServiceRoot*>& accounts) {
+  if (accounts.isEmpty()) {
+    return;
+  }
+
+  QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(metaObject()->className());
+  QList<int> account_ids;
+
+  for (ServiceRoot* acc : accounts) {
+    account_ids.append(acc->accountId());
+  }
+
+  try {
+    int removed = DatabaseQueries::removeUnwantedArticles(database,
+                                                          account_ids,
+                                                          Feed::ArticleIgnoreLimit::fromSettings());
+
+    if (removed > 0) {
+      m_results.setAnyArticlesRemoved(true);
+
+      for (ServiceRoot* acc : accounts) {
+        acc->updateCountsOfAllFeeds(database);
+      }
+    }
+  }
+  catch (const ApplicationException& ex) {
+    qCriticalNN << LOGSEC_FEEDDOWNLOADER << "Failed to remove old articles:" << QUOTE_W_SPACE_DOT(ex.message());
+  }
+}
+
 bool FeedDownloader::isCacheSynchronizationRunning() const {
   return m_isCacheSynchronizationRunning;
 }
@@ -465,8 +541,10 @@ void FeedDownloader::removeDuplicateMessages(QList<Message>& messages) {
       };
     }
     else if (message.m_customId.isEmpty()) {
+      // NOTE: Articles with same hash cannot be stored both.
       is_duplicate = [](const Message& a, const Message& b) {
-        return std::tie(a.m_title, a.m_url, a.m_author) == std::tie(b.m_title, b.m_url, b.m_author);
+        return (!a.m_contentHash.isEmpty() && a.m_contentHash == b.m_contentHash) ||
+               std::tie(a.m_title, a.m_url, a.m_author) == std::tie(b.m_title, b.m_url, b.m_author);
       };
     }
     else {
@@ -517,45 +595,221 @@ void FeedDownloader::removeDuplicateMessages(QList<Message>& messages) {
   }
 }
 
-void FeedDownloader::removeTooOldMessages(Feed* feed, QList<Message>& msgs) {
-  const Feed::ArticleIgnoreLimit art = feed->articleIgnoreLimit();
+void FeedDownloader::prefetchFullArticles(const QSqlDatabase& db, Feed* feed) {
+  TRACE_SCOPE("feed-prefetch", "fetch");
+
+  if (m_stopFeedUpdate) {
+    return;
+  }
+
+  // NOTE: Articles are picked after message filters and article limits did
+  // their job, older articles are included if they were not prefetched yet
+  // and they are not ignored by age limits of the feed.
+  const QList<QPair<int, QString>> articles =
+    DatabaseQueries::getArticlesWithoutFullContents(db, feed, dateTimeToAvoid(feed), ARTICLE_PREFETCH_BATCH);
+
+  if (articles.isEmpty()) {
+    return;
+  }
+
+  QElapsedTimer tmr;
+  tmr.start();
+
+  auto batch = QSharedPointer<FullArticleBatch>::create();
+  const QList<QPair<QByteArray, QByteArray>> headers = feed->articleHttpHeaders();
+  const QNetworkProxy proxy = feed->getParentServiceRoot()->networkProxy();
+  const int timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
+  QList<FullArticleDownload> downloads;
+
+  downloads.reserve(articles.size());
+
+  for (const QPair<int, QString>& article : articles) {
+    FullArticleDownload download;
+
+    download.m_articleId = article.first;
+    download.m_url = article.second;
+    download.m_headers = headers;
+    download.m_proxy = proxy;
+    download.m_timeout = timeout;
+    download.m_batch = batch;
+    downloads.append(download);
+  }
 
-  if (!art.m_addAnyArticlesToDb) {
-    QDateTime dt_to_avoid;
+  enqueueFullArticles(downloads);
 
-    if (art.m_dtToAvoid.isValid() && art.m_dtToAvoid.toMSecsSinceEpoch() > 0) {
-      dt_to_avoid = art.m_dtToAvoid;
+  // NOTE: Pending downloads are dropped by workers when feed update is stopped,
+  // we then only store pages which were already downloaded.
+  for (int finished = 0; finished < downloads.size();) {
+    if (batch->m_finished.tryAcquire(1, ARTICLE_PREFETCH_WAIT_STEP)) {
+      finished++;
+    }
+    else if (m_stopFeedUpdate) {
+      qWarningNN << LOGSEC_FEEDDOWNLOADER << "Aborting prefetching of full articles for feed"
+                 << QUOTE_W_SPACE_DOT(feed->customId());
+      break;
     }
-    else if (art.m_hoursToAvoid > 0) {
-      dt_to_avoid = QDateTime::currentDateTimeUtc().addSecs((art.m_hoursToAvoid * -3600));
+  }
+
+  QHash<int, QString> contents;
+
+  {
+    QMutexLocker lck(&batch->m_mutex);
+
+    contents = batch->m_contents;
+  }
+
+  int prefetched = 0;
+
+  for (const QString& content : std::as_const(contents)) {
+    if (!content.isEmpty()) {
+      prefetched++;
+    }
+  }
+
+  {
+    // NOTE: Pages without extractable content are stored too (as empty
+    // full contents), so that they are not downloaded again and again.
+    QMutexLocker lck(&m_mutexDb);
+
+    DatabaseQueries::storeFullContents(db, contents);
+  }
+
+  TRACE_COUNTER("feed-articles-prefetched", prefetched);
+
+  qDebugNN << LOGSEC_FEEDDOWNLOADER << "Prefetched" << NONQUOTE_W_SPACE(prefetched) << "of"
+           << NONQUOTE_W_SPACE(downloads.size()) << "full articles for feed" << QUOTE_W_SPACE_COMMA(feed->customId())
+           << "operation took" << NONQUOTE_W_SPACE(tmr.elapsed()) << "ms.";
+}
+
+void FeedDownloader::enqueueFullArticles(const QList<FullArticleDownload>& downloads) {
+  QMutexLocker lck(&m_mutexPrefetch);
+  QSet<QString> hosts;
+
+  for (const FullArticleDownload& download : downloads) {
+    const QString host = QUrl(download.m_url).host();
+
+    m_prefetchQueues[host].append(download);
+    hosts.insert(host);
+  }
+
+  for (const QString& host : std::as_const(hosts)) {
+    int& workers = m_prefetchWorkers[host];
+    const int needed_workers = std::min(int(ARTICLE_PREFETCH_PER_HOST), int(m_prefetchQueues.value(host).size()));
+
+    for (; workers < needed_workers; workers++) {
+      QtConcurrent::run(&m_prefetchPool, [this, host]() {
+        processFullArticleQueue(host);
+      });
     }
-    else if (qApp->settings()->value(GROUP(Messages), SETTING(Messages::AvoidOldArticles)).toBool()) {
-      QDateTime global_dt_to_avoid =
-        qApp->settings()->value(GROUP(Messages), SETTING(Messages::DateTimeToAvoidArticle)).toDateTime();
-      int global_hours_to_avoid =
-        qApp->settings()->value(GROUP(Messages), SETTING(Messages::HoursToAvoidArticle)).toInt();
-
-      if (global_dt_to_avoid.isValid() && global_dt_to_avoid.toMSecsSinceEpoch() > 0) {
-        dt_to_avoid = global_dt_to_avoid;
+  }
+}
+
+void FeedDownloader::processFullArticleQueue(const QString& host) {
+  forever {
+    FullArticleDownload download;
+
+    {
+      QMutexLocker lck(&m_mutexPrefetch);
+      QList<FullArticleDownload>& queue = m_prefetchQueues[host];
+
+      if (m_stopFeedUpdate) {
+        queue.clear();
       }
-      else if (global_hours_to_avoid > 0) {
-        dt_to_avoid = QDateTime::currentDateTimeUtc().addSecs(global_hours_to_avoid * -3600);
+
+      if (queue.isEmpty()) {
+        m_prefetchQueues.remove(host);
+
+        if (--m_prefetchWorkers[host] <= 0) {
+          m_prefetchWorkers.remove(host);
+        }
+
+        return;
       }
+
+      download = queue.takeFirst();
     }
 
-    if (dt_to_avoid.isValid()) {
-      for (int i = 0; i < msgs.size(); i++) {
-        const auto& mss = msgs.at(i);
+    const QString contents = downloadFullArticle(download);
 
-        if (mss.m_createdFromFeed && mss.m_created < dt_to_avoid) {
-          qDebugNN << LOGSEC_CORE << "Removing message" << QUOTE_W_SPACE(mss.m_title) << "for being too old.";
-          msgs.removeAt(i--);
-        }
+    {
+      QMutexLocker lck(&download.m_batch->m_mutex);
+
+      download.m_batch->m_contents.insert(download.m_articleId, contents);
+    }
+
+    download.m_batch->m_finished.release();
+  }
+}
+
+QString FeedDownloader::downloadFullArticle(const FullArticleDownload& download) {
+  QByteArray data;
+  NetworkResult res = NetworkFactory::performNetworkOperation(download.m_url,
+                                                              download.m_timeout,
+                                                              {},
+                                                              data,
+                                                              QNetworkAccessManager::Operation::GetOperation,
+                                                              download.m_headers,
+                                                              false,
+                                                              {},
+                                                              {},
+                                                              download.m_proxy);
+
+  if (res.m_networkError != QNetworkReply::NetworkError::NoError) {
+    qWarningNN << LOGSEC_FEEDDOWNLOADER << "Failed to download full article" << QUOTE_W_SPACE_COMMA(download.m_url)
+               << "error:" << QUOTE_W_SPACE_DOT(res.m_networkError);
+    return {};
+  }
+
+  return ArticleExtractor::extract(ArticleExtractor::decodeHtml(data, res.m_contentType), QUrl(download.m_url))
+    .m_content;
+}
+
+void FeedDownloader::removeTooOldMessages(Feed* feed, QList<Message>& msgs) {
+  const QDateTime dt_to_avoid = dateTimeToAvoid(feed);
+
+  if (dt_to_avoid.isValid()) {
+    for (int i = 0; i < msgs.size(); i++) {
+      const auto& mss = msgs.at(i);
+
+      if (mss.m_createdFromFeed && mss.m_created < dt_to_avoid) {
+        qDebugNN << LOGSEC_CORE << "Removing message" << QUOTE_W_SPACE(mss.m_title) << "for being too old.";
+        msgs.removeAt(i--);
       }
     }
   }
 }
 
+QDateTime FeedDownloader::dateTimeToAvoid(Feed* feed) const {
+  const Feed::ArticleIgnoreLimit art = feed->articleIgnoreLimit();
+
+  if (art.m_addAnyArticlesToDb) {
+    return {};
+  }
+
+  if (art.m_dtToAvoid.isValid() && art.m_dtToAvoid.toMSecsSinceEpoch() > 0) {
+    return art.m_dtToAvoid;
+  }
+  else if (art.m_hoursToAvoid > 0) {
+    return QDateTime::currentDateTimeUtc().addSecs((art.m_hoursToAvoid * -3600));
+  }
+
+  const QSharedPointer<const SettingsSnapshot> settings = qApp->settings()->snapshot();
+
+  if (settings->m_avoidOldArticles) {
+    QDateTime global_dt_to_avoid = settings->m_dateTimeToAvoidArticle;
+    int global_hours_to_avoid = settings->m_hoursToAvoidArticle;
+
+    if (global_dt_to_avoid.isValid() && global_dt_to_avoid.toMSecsSinceEpoch() > 0) {
+      return global_dt_to_avoid;
+    }
+    else if (global_hours_to_avoid > 0) {
+      return QDateTime::currentDateTimeUtc().addSecs(global_hours_to_avoid * -3600);
+    }
+  }
+
+  return {};
+}
+
 QString FeedDownloadResults::overview(int how_many_feeds) const {
   QStringList result;
 
@@ -579,16 +833,36 @@ QString FeedDownloadResults::overview(int how_many_feeds) const {
   return res_str;
 }
 
-void FeedDownloadResults::appendUpdatedFeed(Feed* feed, const QList<Message>& updated_unread_msgs) {
-  if (!updated_unread_msgs.isEmpty()) {
-    m_updatedFeeds.insert(feed, updated_unread_msgs);
+void FeedDownloadResults::appendUpdatedFeed(Feed* feed, const UpdatedArticles& updated_msgs) {
+  if (!updated_msgs.m_unread.isEmpty()) {
+    m_updatedFeeds.insert(feed, updated_msgs.m_unread);
   }
+
+  for (const Message& msg : updated_msgs.m_all) {
+    if (msg.m_id > 0) {
+      m_updatedArticleIds.append(msg.m_id);
+    }
+  }
+}
+
+void FeedDownloadResults::setAnyArticlesRemoved(bool removed) {
+  m_anyArticlesRemoved = removed;
 }
 
 void FeedDownloadResults::clear() {
   m_updatedFeeds.clear();
+  m_updatedArticleIds.clear();
+  m_anyArticlesRemoved = false;
 }
 
 QHash<Feed*, QList<Message>> FeedDownloadResults::updatedFeeds() const {
   return m_updatedFeeds;
 }
+
+QList<int> FeedDownloadResults::updatedArticleIds() const {
+  return m_updatedArticleIds;
+}
+
+bool FeedDownloadResults::anyArticlesRemoved() const {
+  return m_anyArticlesRemoved;
+}
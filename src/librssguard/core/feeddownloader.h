@@ -4,14 +4,23 @@
 #define FEEDDOWNLOADER_H
 
 #include "core/message.h"
+#include "definitions/typedefs.h"
 #include "exceptions/applicationexception.h"
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/feed.h"
 
 #include <QFutureWatcher>
 #include <QHash>
+#include <QMutex>
+#include <QNetworkProxy>
 #include <QObject>
 #include <QPair>
+#include <QSemaphore>
+#include <QSet>
+#include <QSharedPointer>
+#include <QThreadPool>
+
+#include <atomic>
 
 class MessageFilter;
 
@@ -19,13 +28,23 @@ class MessageFilter;
 class FeedDownloadResults {
   public:
     QHash<Feed*, QList<Message>> updatedFeeds() const;
+
+    // IDs of all inserted or updated articles.
+    QList<int> updatedArticleIds() const;
+
+    // Some articles were removed from DB during update.
+    bool anyArticlesRemoved() const;
+
     QString overview(int how_many_feeds) const;
-    void appendUpdatedFeed(Feed* feed, const QList<Message>& updated_unread_msgs);
+    void appendUpdatedFeed(Feed* feed, const UpdatedArticles& updated_msgs);
+    void setAnyArticlesRemoved(bool removed);
     void clear();
 
   private:
     // QString represents title if the feed, int represents count of newly downloaded messages.
     QHash<Feed*, QList<Message>> m_updatedFeeds;
+    QList<int> m_updatedArticleIds;
+    bool m_anyArticlesRemoved = false;
 };
 
 struct FeedUpdateRequest {
@@ -39,6 +58,24 @@ struct FeedUpdateResult {
     Feed* feed = nullptr;
 };
 
+// Collects extracted contents of linked pages of articles of one feed.
+struct FullArticleBatch {
+    QMutex m_mutex;
+    QHash<int, QString> m_contents;
+
+    // Released once for each finished download.
+    QSemaphore m_finished;
+};
+
+struct FullArticleDownload {
+    int m_articleId = 0;
+    QString m_url;
+    QList<QPair<QByteArray, QByteArray>> m_headers;
+    QNetworkProxy m_proxy;
+    int m_timeout = 0;
+    QSharedPointer<FullArticleBatch> m_batch;
+};
+
 // This class offers means to "update" feeds and "special" categories.
 // NOTE: This class is used within separate thread.
 class FeedDownloader : public QObject {
@@ -69,19 +106,46 @@ class FeedDownloader : public QObject {
                        const QHash<ServiceRoot::BagOfMessages, QStringList>& stated_messages,
                        const QHash<QString, QStringList>& tagged_messages);
     void finalizeUpdate();
+
+    // Applies article limits of all feeds of given accounts with set-based queries,
+    // which is much cheaper than doing it for each feed separately.
+    void removeUnwantedArticles(const QSet<ServiceRoot*>& accounts);
     void removeDuplicateMessages(QList<Message>& messages);
     void removeTooOldMessages(Feed* feed, QList<Message>& msgs);
 
+    // Returns date/time before which articles of the feed are ignored,
+    // invalid date/time is returned if all articles are accepted.
+    QDateTime dateTimeToAvoid(Feed* feed) const;
+
+    // Downloads linked pages of stored articles of the feed which do not have
+    // full contents yet and stores extracted main contents of those pages.
+    // Waiting for downloads is interrupted when feed update is stopped.
+    void prefetchFullArticles(const QSqlDatabase& db, Feed* feed);
+
+    // Appends downloads to queues of their hosts and starts workers
+    // for hosts which are not served by enough workers.
+    void enqueueFullArticles(const QList<FullArticleDownload>& downloads);
+    void processFullArticleQueue(const QString& host);
+    QString downloadFullArticle(const FullArticleDownload& download);
+
     FeedUpdateResult updateThreadedFeed(const FeedUpdateRequest& fd);
 
   private:
     bool m_isCacheSynchronizationRunning;
     bool m_stopCacheSynchronization;
+    std::atomic_bool m_stopFeedUpdate;
     QMutex m_mutexDb;
     QHash<ServiceRoot*, ApplicationException> m_erroredAccounts;
     QList<FeedUpdateRequest> m_feeds = {};
     QFutureWatcher<FeedUpdateResult> m_watcherLookup;
     FeedDownloadResults m_results;
+
+    // Bounded pool for downloading of full articles. Each host has its own queue
+    // of downloads, which is processed by limited number of workers.
+    QThreadPool m_prefetchPool;
+    QMutex m_mutexPrefetch;
+    QHash<QString, QList<FullArticleDownload>> m_prefetchQueues;
+    QHash<QString, int> m_prefetchWorkers;
 };
 
 #endif // FEEDDOWNLOADER_H
@@ -16,11 +16,13 @@
 #include "services/abstract/serviceentrypoint.h"
 #include "services/abstract/serviceroot.h"
 
+#include <QElapsedTimer>
 #include <QMimeData>
 #include <QPair>
 #include <QSqlError>
 #include <QStack>
 #include <QTimer>
+#include <QtConcurrentMap>
 
 FeedsModel::FeedsModel(QObject* parent) : QAbstractItemModel(parent), m_rootItem(new RootItem()) {
   setObjectName(QSL("FeedsModel"));
@@ -483,17 +485,48 @@ void FeedsModel::sortDirectDescendants(RootItem* item, RootItem::Kind kind_to_so
 
 void FeedsModel::loadActivatedServiceAccounts() {
   auto serv = qApp->feedReader()->feedServices();
+  QList<ServiceRoot*> roots;
+  QElapsedTimer tmr;
+
+  tmr.start();
+
+  // NOTE: Icon store is prepared in main thread, so that accounts
+  // are then read from database strictly read-only.
+  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+
+  DatabaseQueries::moveLegacyIconsToStore(database);
+  qApp->icons()->loadIconStore(database);
 
   // Iterate all globally available feed "service plugins".
   for (const ServiceEntryPoint* entry_point : std::as_const(serv)) {
-    // Load all stored root nodes from the entry point and add those to the model.
-    QList<ServiceRoot*> roots = entry_point->initializeSubtree();
+    // Load all stored root nodes from the entry point.
+    roots.append(entry_point->initializeSubtree());
+  }
+
+  qDebugNN << LOGSEC_CORE << "Loading" << NONQUOTE_W_SPACE(roots.size()) << "accounts took"
+           << NONQUOTE_W_SPACE(tmr.restart()) << "ms.";
+
+  // Feeds, categories and article counts of all accounts are read in parallel,
+  // each worker thread uses its own database connection.
+  QtConcurrent::blockingMap(
+#if QT_VERSION_MAJOR > 5
+    qApp->workHorsePool(),
+#endif
+    roots,
+    [](ServiceRoot* root) {
+      root->preloadFromDatabase();
+    });
 
-    for (ServiceRoot* root : roots) {
-      addServiceAccount(root, false);
-    }
+  qDebugNN << LOGSEC_CORE << "Preloading structure of accounts took" << NONQUOTE_W_SPACE(tmr.restart()) << "ms.";
+
+  // Add accounts to the model, they assemble their trees from preloaded data
+  // and then perform their service-specific initialization.
+  for (ServiceRoot* root : std::as_const(roots)) {
+    addServiceAccount(root, false);
   }
 
+  qDebugNN << LOGSEC_CORE << "Starting accounts took" << NONQUOTE_W_SPACE(tmr.elapsed()) << "ms.";
+
   if (serviceRoots().isEmpty()) {
     QTimer::singleShot(2000, qApp->mainForm(), []() {
       qApp->mainForm()->showAddAccountDialog();
@@ -19,7 +19,9 @@ using RootItemPtr = RootItem*;
 
 FeedsProxyModel::FeedsProxyModel(FeedsModel* source_model, QObject* parent)
   : QSortFilterProxyModel(parent), m_sourceModel(source_model), m_view(nullptr), m_selectedItem(nullptr),
-    m_showUnreadOnly(false), m_sortAlphabetically(false) {
+    m_showUnreadOnly(false), m_sortAlphabetically(false), m_filterMode(SearchLineEdit::SearchMode::FixedString),
+    m_filterSensitivity(Qt::CaseSensitivity::CaseInsensitive), m_filterTitleOnly(true), m_filterNarrowing(false),
+    m_filterGeneration(0) {
   setObjectName(QSL("FeedsProxyModel"));
 
   setSortRole(Qt::ItemDataRole::EditRole);
@@ -41,6 +43,10 @@ FeedsProxyModel::FeedsProxyModel(FeedsModel* source_model, QObject* parent)
                   RootItem::Kind::Important,
                   RootItem::Kind::Unread,
                   RootItem::Kind::Bin};
+
+  // NOTE: Cached items might get deleted, drop the cache.
+  connect(m_sourceModel, &FeedsModel::rowsAboutToBeRemoved, this, &FeedsProxyModel::clearFilterCache);
+  connect(m_sourceModel, &FeedsModel::modelAboutToBeReset, this, &FeedsProxyModel::clearFilterCache);
 }
 
 FeedsProxyModel::~FeedsProxyModel() {
@@ -383,7 +389,7 @@ bool FeedsProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source
                                 .toString())
              << "was previously hidden and now shows up, expand.";
 
-    const_cast<FeedsProxyModel*>(this)->m_hiddenIndices.removeAll(QPair<int, QModelIndex>(source_row, source_parent));
+    const_cast<FeedsProxyModel*>(this)->m_hiddenIndices.remove(QPair<int, QModelIndex>(source_row, source_parent));
 
     // Now, item now should be displayed and previously it was not.
     // Expand!
@@ -391,7 +397,7 @@ bool FeedsProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source
   }
 
   if (!should_show) {
-    const_cast<FeedsProxyModel*>(this)->m_hiddenIndices.append(QPair<int, QModelIndex>(source_row, source_parent));
+    const_cast<FeedsProxyModel*>(this)->m_hiddenIndices.insert(QPair<int, QModelIndex>(source_row, source_parent));
   }
 
   return should_show;
@@ -430,7 +436,7 @@ bool FeedsProxyModel::filterAcceptsRowInternal(int source_row, const QModelIndex
 
   if (!m_showUnreadOnly) {
     // Take only regexp filtering into account.
-    return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+    return filterAcceptsItem(item);
   }
   else {
     // NOTE: If item has < 0 of unread messages it may mean, that the count
@@ -442,8 +448,102 @@ bool FeedsProxyModel::filterAcceptsRowInternal(int source_row, const QModelIndex
     // "show unread only" is enabled too and user for example selects last unread
     // article in a feed -> then the feed would disappear from list suddenly.
     return m_selectedItem == item ||
-           (item->countOfUnreadMessages() != 0 && QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent));
+           (item->countOfUnreadMessages() != 0 && filterAcceptsItem(item));
+  }
+}
+
+bool FeedsProxyModel::filterAcceptsItem(const RootItem* item) const {
+  if (m_filterPhrase.isEmpty()) {
+    return true;
+  }
+
+  FilterCacheEntry& entry = m_filterCache[item];
+  const int unread_count = m_filterTitleOnly ? 0 : item->countOfUnreadMessages();
+
+  if (entry.m_title != item->title() || entry.m_unreadCount != unread_count) {
+    entry.m_title = item->title();
+    entry.m_lowerTitle = entry.m_title.toLower();
+    entry.m_unreadCount = unread_count;
+    entry.m_generation = -1;
+  }
+
+  if (entry.m_generation == m_filterGeneration) {
+    return entry.m_matches;
+  }
+
+  // NOTE: When new phrase only narrows the previous one, then items
+  // which did not match previous phrase cannot match the new one.
+  if (!m_filterNarrowing || entry.m_generation != m_filterGeneration - 1 || entry.m_matches) {
+    entry.m_matches = matchesFilter(entry);
+  }
+
+  entry.m_generation = m_filterGeneration;
+  return entry.m_matches;
+}
+
+bool FeedsProxyModel::matchesFilter(const FilterCacheEntry& entry) const {
+  switch (m_filterMode) {
+    case SearchLineEdit::SearchMode::Wildcard:
+    case SearchLineEdit::SearchMode::RegularExpression:
+      return m_filterRegex.match(entry.m_title).hasMatch() ||
+             (!m_filterTitleOnly && m_filterRegex.match(QString::number(entry.m_unreadCount)).hasMatch());
+
+    case SearchLineEdit::SearchMode::FixedString:
+    default: {
+      // NOTE: Phrase is already lowercased for case-insensitive search.
+      const QString& title =
+        m_filterSensitivity == Qt::CaseSensitivity::CaseInsensitive ? entry.m_lowerTitle : entry.m_title;
+
+      return title.contains(m_filterPhrase) ||
+             (!m_filterTitleOnly && QString::number(entry.m_unreadCount).contains(m_filterPhrase));
+    }
+  }
+}
+
+void FeedsProxyModel::clearFilterCache() {
+  m_filterCache.clear();
+}
+
+void FeedsProxyModel::setFilter(SearchLineEdit::SearchMode mode,
+                                Qt::CaseSensitivity sensitivity,
+                                bool title_only,
+                                const QString& phrase) {
+  const QString new_phrase = (mode == SearchLineEdit::SearchMode::FixedString &&
+                              sensitivity == Qt::CaseSensitivity::CaseInsensitive)
+                               ? phrase.toLower()
+                               : phrase;
+  const bool same_criteria =
+    mode == m_filterMode && sensitivity == m_filterSensitivity && title_only == m_filterTitleOnly;
+
+  if (same_criteria && new_phrase == m_filterPhrase) {
+    return;
+  }
+
+  m_filterNarrowing = same_criteria && mode == SearchLineEdit::SearchMode::FixedString && !m_filterPhrase.isEmpty() &&
+                      new_phrase.contains(m_filterPhrase);
+  m_filterMode = mode;
+  m_filterSensitivity = sensitivity;
+  m_filterTitleOnly = title_only;
+  m_filterPhrase = new_phrase;
+  m_filterGeneration++;
+
+  if (mode == SearchLineEdit::SearchMode::FixedString || new_phrase.isEmpty()) {
+    m_filterRegex = QRegularExpression();
+  }
+  else {
+    QRegularExpression::PatternOptions options = QRegularExpression::PatternOption::UseUnicodePropertiesOption;
+
+    if (sensitivity == Qt::CaseSensitivity::CaseInsensitive) {
+      options |= QRegularExpression::PatternOption::CaseInsensitiveOption;
+    }
+
+    const QString pattern =
+      mode == SearchLineEdit::SearchMode::Wildcard ? RegexFactory::wildcardToRegularExpression(phrase) : phrase;
+
+    m_filterRegex = QRegularExpression(pattern, options);
   }
+
+  invalidateFilter();
 }
 
 bool FeedsProxyModel::sortAlphabetically() const {
@@ -3,14 +3,17 @@
 #ifndef FEEDSPROXYMODEL_H
 #define FEEDSPROXYMODEL_H
 
+#include "gui/reusable/searchlineedit.h"
 #include "services/abstract/rootitem.h"
 
+#include <QRegularExpression>
+#include <QSet>
 #include <QSortFilterProxyModel>
 
 class FeedsModel;
 class FeedsView;
 
-class FeedsProxyModel : public QSortFilterProxyModel {
+class RSSGUARD_DLLSPEC FeedsProxyModel : public QSortFilterProxyModel {
     Q_OBJECT
 
   public:
@@ -52,6 +55,14 @@ class FeedsProxyModel : public QSortFilterProxyModel {
     bool sortAlphabetically() const;
     void setSortAlphabetically(bool sort_alphabetically);
 
+    // Sets phrase used for filtering of feeds/categories/labels. Phrase is compiled
+    // only once. If new fixed-string phrase only extends the previous one, then
+    // only items which matched the previous phrase are checked again.
+    void setFilter(SearchLineEdit::SearchMode mode,
+                   Qt::CaseSensitivity sensitivity,
+                   bool title_only,
+                   const QString& phrase);
+
   public slots:
     void invalidateReadFeedsFilter(bool set_new_value = false, bool show_unread_only = false);
 
@@ -66,8 +77,20 @@ class FeedsProxyModel : public QSortFilterProxyModel {
     virtual bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const;
 
   private:
+    struct FilterCacheEntry {
+        QString m_title;
+        QString m_lowerTitle;
+        int m_unreadCount = 0;
+        int m_generation = -1;
+        bool m_matches = false;
+    };
+
     virtual bool filterAcceptsRowInternal(int source_row, const QModelIndex& source_parent) const;
 
+    bool filterAcceptsItem(const RootItem* item) const;
+    bool matchesFilter(const FilterCacheEntry& entry) const;
+    void clearFilterCache();
+
     // Source model pointer.
     FeedsModel* m_sourceModel;
     FeedsView* m_view;
@@ -79,7 +102,17 @@ class FeedsProxyModel : public QSortFilterProxyModel {
     bool m_showNodeLabels;
     bool m_showNodeImportant;
     QList<RootItem::Kind> m_priorities;
-    QList<QPair<int, QModelIndex>> m_hiddenIndices;
+    QSet<QPair<int, QModelIndex>> m_hiddenIndices;
+
+    // Compiled filter and per-item cache of titles and results of matching.
+    SearchLineEdit::SearchMode m_filterMode;
+    Qt::CaseSensitivity m_filterSensitivity;
+    bool m_filterTitleOnly;
+    bool m_filterNarrowing;
+    int m_filterGeneration;
+    QString m_filterPhrase;
+    QRegularExpression m_filterRegex;
+    mutable QHash<const RootItem*, FilterCacheEntry> m_filterCache;
 };
 
 #endif // FEEDSPROXYMODEL_H
@@ -8,11 +8,11 @@
 #include "services/abstract/feed.h"
 #include "services/abstract/label.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QFlags>
 #include <QJsonArray>
 #include <QJsonObject>
-#include <QRegularExpression>
 #include <QUrl>
 #include <QVariant>
 #include <QVector>
@@ -118,26 +118,8 @@ Message::Message() {
 }
 
 void Message::sanitize(const Feed* feed, bool fix_future_datetimes) {
-  static QRegularExpression reg_spaces(QString::fromUtf8(QByteArray("[\xE2\x80\xAF]")));
-  static QRegularExpression reg_whites(QSL("[\\s]{2,}"));
-  static QRegularExpression reg_news(QSL("([\\n\\r])|(^\\s)"));
-
   // Sanitize title.
-  m_title = qApp->web()->stripTags(WebFactory::unescapeHtml(m_title));
-
-  m_title = m_title
-
-              // Remove non-breaking spaces.
-              .replace(reg_spaces, QSL(" "))
-
-              // Shrink consecutive whitespaces.
-              .replace(reg_whites, QSL(" "))
-
-              // Remove all newlines and leading white space.
-              .remove(reg_news)
-
-              // Remove non-breaking zero-width spaces.
-              .remove(QChar(65279));
+  m_title = TextFactory::simplifyTitle(qApp->web()->stripTags(WebFactory::unescapeHtml(m_title)));
 
   // Sanitize author.
   m_author = qApp->web()->stripTags(WebFactory::unescapeHtml(m_author));
@@ -170,6 +152,27 @@ void Message::sanitize(const Feed* feed, bool fix_future_datetimes) {
     m_createdFromFeed = false;
     m_created = QDateTime::currentDateTimeUtc();
   }
+
+  if (m_customId.isEmpty()) {
+    m_contentHash = contentHash();
+  }
+}
+
+QString Message::contentHash() const {
+  // NOTE: Scheme is ignored as many publishers switched their sites
+  // from HTTP to HTTPS, date is only used when article has no URL, because
+  // it is often changed when article is edited. Author is ignored too, feeds
+  // often omit it in some of their versions or change its format (name, e-mail),
+  // while URL and title identify the article well enough.
+  const QString url = QUrl(m_url).toString(QUrl::UrlFormattingOption::RemoveScheme |
+                                           QUrl::UrlFormattingOption::RemoveFragment |
+                                           QUrl::UrlFormattingOption::StripTrailingSlash |
+                                           QUrl::UrlFormattingOption::NormalizePathSegments);
+  const QString date = (url.isEmpty() && m_createdFromFeed) ? QString::number(m_created.toMSecsSinceEpoch())
+                                                            : QString();
+  const QString data = url + QL1C('\n') + m_title.simplified().toLower() + QL1C('\n') + date;
+
+  return QString::fromLatin1(QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Algorithm::Sha256).toHex());
 }
 
 QJsonObject Message::toJson() const {
@@ -57,6 +57,10 @@ class RSSGUARD_DLLSPEC Message {
 
     void sanitize(const Feed* feed, bool fix_future_datetimes);
 
+    // Returns hash of normalized URL, title and (for articles without URL)
+    // date of the article. Articles without custom ID are recognized by it.
+    QString contentHash() const;
+
     QJsonObject toJson() const;
 
     // Creates Message from given record, which contains
@@ -80,6 +84,11 @@ class RSSGUARD_DLLSPEC Message {
     int m_id;
     QString m_customId;
     QString m_customHash;
+
+    // Articles without custom ID are recognized by this hash, see contentHash().
+    // NOTE: Unlike custom hash, which belongs to services, this is only used
+    // when storing articles to DB.
+    QString m_contentHash;
     bool m_isRead;
     bool m_isImportant;
     bool m_isDeleted;
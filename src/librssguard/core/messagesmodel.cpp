@@ -14,22 +14,28 @@
 #include "miscellaneous/settings.h"
 #include "miscellaneous/skinfactory.h"
 #include "miscellaneous/textfactory.h"
+#include "miscellaneous/tracer.h"
+#include "services/abstract/label.h"
+#include "services/abstract/labelsnode.h"
 #include "services/abstract/recyclebin.h"
 #include "services/abstract/serviceroot.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <QPainter>
 #include <QPainterPath>
 #include <QSqlError>
 #include <QSqlField>
+#include <QSqlQuery>
 
 MessagesModel::MessagesModel(QObject* parent)
-  : QSqlQueryModel(parent), m_view(nullptr), m_cache(new MessagesModelCache(this)),
+  : QAbstractTableModel(parent), m_view(nullptr), m_cache(new MessagesModelCache(this)),
     m_messageHighlighter(MessageHighlighter::NoHighlighting), m_customDateFormat(QString()),
     m_customTimeFormat(QString()), m_customFormatForDatesOnly(QString()), m_newerArticlesRelativeTime(-1),
     m_selectedItem(nullptr), m_unreadIconType(MessageUnreadIcon::Dot),
-    m_multilineListItems(qApp->settings()->value(GROUP(Messages), SETTING(Messages::MultilineArticleList)).toBool()) {
+    m_multilineListItems(qApp->settings()->value(GROUP(Messages), SETTING(Messages::MultilineArticleList)).toBool()),
+    m_bodiesCache(MSG_BODIES_CACHE_SIZE), m_layoutCache(MSG_LAYOUT_CACHE_SIZE) {
   updateFeedIconsDisplay();
   updateDateFormat();
 
@@ -143,27 +149,158 @@ MessagesModelCache* MessagesModel::cache() const {
 }
 
 void MessagesModel::repopulate(int additional_article_id) {
+  TRACE_SCOPE("model-repopulate", "gui");
+
+  beginResetModel();
+
   m_cache->clear();
+  m_bodiesCache.clear();
+  m_records.clear();
+  setupLabelNames();
 
   QString statemnt = selectStatement(additional_article_id);
+  QSqlQuery q(m_db);
 
-  setQuery(statemnt, m_db);
+  q.setForwardOnly(true);
 
-  if (lastError().isValid()) {
+  if (q.exec(statemnt)) {
+    while (q.next()) {
+      m_records.append(q.record());
+    }
+  }
+  else {
     qCriticalNN << LOGSEC_MESSAGEMODEL
-                << "Error when setting new msg view query:" << QUOTE_W_SPACE_DOT(lastError().text());
+                << "Error when setting new msg view query:" << QUOTE_W_SPACE_DOT(q.lastError().text());
     qCriticalNN << LOGSEC_MESSAGEMODEL << "Used SQL select statement:" << QUOTE_W_SPACE_DOT(statemnt);
   }
 
-  while (canFetchMore()) {
-    fetchMore();
-  }
+  rebuildIdIndex();
+  endResetModel();
 
   qDebugNN << LOGSEC_MESSAGEMODEL << "Repopulated model, SQL statement is now:\n" << QUOTE_W_SPACE_DOT(statemnt);
 }
 
+bool MessagesModel::mergeArticles(const QList<int>& article_ids) {
+  if (article_ids.isEmpty()) {
+    return true;
+  }
+
+  if (m_selectedItem == nullptr || !canCompareRecords()) {
+    return false;
+  }
+
+  TRACE_SCOPE("model-merge", "gui");
+
+  QSqlQuery q(m_db);
+
+  q.setForwardOnly(true);
+
+  if (!q.exec(selectStatementForArticles(article_ids))) {
+    qCriticalNN << LOGSEC_MESSAGEMODEL << "Error when merging articles:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+    return false;
+  }
+
+  QList<QSqlRecord> new_records;
+  QList<int> moved_rows;
+
+  while (q.next()) {
+    const QSqlRecord rec = q.record();
+    const int id = rec.value(MSG_DB_ID_INDEX).toInt();
+    const int row = rowOfMessage(id);
+
+    m_bodiesCache.remove(id);
+    m_layoutCache.remove(id);
+
+    if (row < 0) {
+      new_records.append(rec);
+    }
+    else if (recordLessThan(rec, m_records.at(row)) || recordLessThan(m_records.at(row), rec)) {
+      // Sort key of displayed article changed, row must be moved to its new position.
+      moved_rows.append(row);
+      new_records.append(rec);
+    }
+    else {
+      // Article is already displayed, refresh it.
+      m_records[row] = rec;
+      m_cache->setRecord(row, rec);
+
+      emit dataChanged(index(row, 0), index(row, MSG_DB_LABELS_IDS));
+    }
+  }
+
+  if (!moved_rows.isEmpty()) {
+    std::sort(moved_rows.begin(), moved_rows.end(), std::greater<int>());
+
+    for (int row : std::as_const(moved_rows)) {
+      beginRemoveRows(QModelIndex(), row, row);
+      m_records.removeAt(row);
+      m_cache->shiftRows(row + 1, -1);
+      endRemoveRows();
+    }
+  }
+
+  for (const QSqlRecord& rec : std::as_const(new_records)) {
+    // Find position after all rows which are not "greater" than new row.
+    int low = 0, high = m_records.size();
+
+    while (low < high) {
+      const int mid = (low + high) / 2;
+
+      if (recordLessThan(rec, m_records.at(mid))) {
+        high = mid;
+      }
+      else {
+        low = mid + 1;
+      }
+    }
+
+    beginInsertRows(QModelIndex(), low, low);
+    m_records.insert(low, rec);
+    m_cache->shiftRows(low, 1);
+    endInsertRows();
+  }
+
+  if (!new_records.isEmpty()) {
+    rebuildIdIndex();
+  }
+
+  qDebugNN << LOGSEC_MESSAGEMODEL << "Merged" << NONQUOTE_W_SPACE(new_records.size() - moved_rows.size())
+           << "new articles into model, moved" << NONQUOTE_W_SPACE(moved_rows.size()) << "articles.";
+  return true;
+}
+
+int MessagesModel::rowOfMessage(int id) const {
+  return m_idIndex.value(id, -1);
+}
+
+int MessagesModel::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : int(m_records.size());
+}
+
+int MessagesModel::columnCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : m_headerData.size();
+}
+
+QSqlRecord MessagesModel::record(int row_index) const {
+  return row_index >= 0 && row_index < m_records.size() ? m_records.at(row_index) : QSqlRecord();
+}
+
+QVariant MessagesModel::recordData(const QModelIndex& idx) const {
+  return idx.isValid() && idx.row() < m_records.size() ? m_records.at(idx.row()).value(idx.column()) : QVariant();
+}
+
+void MessagesModel::rebuildIdIndex() {
+  m_idIndex.clear();
+  m_idIndex.reserve(m_records.size());
+
+  for (int i = 0; i < m_records.size(); i++) {
+    m_idIndex.insert(m_records.at(i).value(MSG_DB_ID_INDEX).toInt(), i);
+  }
+}
+
 bool MessagesModel::setData(const QModelIndex& idx, const QVariant& value, int role) {
   Q_UNUSED(role)
+  m_layoutCache.remove(messageId(idx.row()));
   m_cache->setData(idx, value);
 
   emit dataChanged(index(idx.row(), 0), index(idx.row(), MSG_DB_LABELS_IDS));
@@ -212,21 +349,19 @@ void MessagesModel::loadMessages(RootItem* item) {
 }
 
 bool MessagesModel::setMessageImportantById(int id, RootItem::Importance important) {
-  for (int i = 0; i < rowCount(); i++) {
-    int found_id = data(i, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
+  const int row = rowOfMessage(id);
 
-    if (found_id == id) {
-      bool set = setData(index(i, MSG_DB_IMPORTANT_INDEX), int(important));
+  if (row < 0) {
+    return false;
+  }
 
-      if (set) {
-        emit dataChanged(index(i, 0), index(i, MSG_DB_LABELS_IDS));
-      }
+  bool set = setData(index(row, MSG_DB_IMPORTANT_INDEX), int(important));
 
-      return set;
-    }
+  if (set) {
+    emit dataChanged(index(row, 0), index(row, MSG_DB_LABELS_IDS));
   }
 
-  return false;
+  return set;
 }
 
 void MessagesModel::highlightMessages(MessagesModel::MessageHighlighter highlighter) {
@@ -285,9 +420,91 @@ void MessagesModel::reloadWholeLayout() {
 }
 
 Message MessagesModel::messageAt(int row_index) const {
+  QList<Message> msgs = {messageHeaderAt(row_index)};
+
+  loadMessageBodies(msgs);
+  return msgs.first();
+}
+
+Message MessagesModel::messageHeaderAt(int row_index) const {
   return Message::fromSqlRecord(m_cache->containsData(row_index) ? m_cache->record(row_index) : record(row_index));
 }
 
+void MessagesModel::loadMessageBodies(QList<Message>& messages) const {
+  QList<Message> to_load;
+
+  for (Message& msg : messages) {
+    Message* cached = m_bodiesCache.object(msg.m_id);
+
+    if (cached != nullptr) {
+      msg.m_contents = cached->m_contents;
+      msg.m_enclosures = cached->m_enclosures;
+    }
+    else {
+      to_load.append(msg);
+    }
+  }
+
+  if (to_load.isEmpty() || !DatabaseQueries::fillMessageBodies(m_db, to_load)) {
+    return;
+  }
+
+  QHash<int, Message*> loaded;
+
+  for (Message& msg : to_load) {
+    loaded.insert(msg.m_id, &msg);
+  }
+
+  for (Message& msg : messages) {
+    Message* body = loaded.value(msg.m_id);
+
+    if (body != nullptr) {
+      msg.m_contents = body->m_contents;
+      msg.m_enclosures = body->m_enclosures;
+
+      Message* cached = new Message();
+
+      cached->m_contents = body->m_contents;
+      cached->m_enclosures = body->m_enclosures;
+      m_bodiesCache.insert(msg.m_id, cached);
+    }
+  }
+}
+
+void MessagesModel::setupLabelNames() {
+  m_labelNames.clear();
+
+  if (m_selectedItem == nullptr || m_selectedItem->getParentServiceRoot()->labelsNode() == nullptr) {
+    return;
+  }
+
+  const QList<Label*> labels = m_selectedItem->getParentServiceRoot()->labelsNode()->labels();
+
+  for (const Label* lbl : labels) {
+    m_labelNames.insert(lbl->customId(), lbl->title());
+  }
+}
+
+QString MessagesModel::labelNames(const QString& label_ids) const {
+  const QStringList ids = label_ids.split(QL1C('.'),
+#if QT_VERSION >= 0x050F00 // Qt >= 5.15.0
+                                          Qt::SplitBehaviorFlags::SkipEmptyParts);
+#else
+                                          QString::SplitBehavior::SkipEmptyParts);
+#endif
+  QStringList names;
+
+  for (const QString& label_id : ids) {
+    auto name = m_labelNames.constFind(label_id);
+
+    if (name != m_labelNames.constEnd()) {
+      names.append(name.value());
+    }
+  }
+
+  return names.join(QL1C(','));
+}
+
 void MessagesModel::setupHeaderData() {
   m_headerData <<
 
@@ -334,9 +551,10 @@ QList<Message> MessagesModel::messagesAt(const QList<int>& row_indices) const {
   msgs.reserve(row_indices.size());
 
   for (int idx : row_indices) {
-    msgs << messageAt(idx);
+    msgs << messageHeaderAt(idx);
   }
 
+  loadMessageBodies(msgs);
   return msgs;
 }
 
@@ -353,7 +571,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
 
       if (index_column == MSG_DB_DCREATED_INDEX) {
         QDateTime utc_dt =
-          TextFactory::parseDateTime(QSqlQueryModel::data(idx, Qt::ItemDataRole::EditRole).value<qint64>());
+          TextFactory::parseDateTime(recordData(idx).value<qint64>());
         QDateTime dt = utc_dt.toLocalTime();
 
         if (dt.date() == QDate::currentDate() && !m_customTimeFormat.isEmpty()) {
@@ -406,23 +624,20 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
         // Trim feed title.
         return data(idx, Qt::ItemDataRole::EditRole).toString().simplified();
       }
-      else if (index_column == MSG_DB_CONTENTS_INDEX) {
-        // Do not display full contents here.
-        QString contents = data(idx, Qt::ItemDataRole::EditRole).toString().mid(0, 64).simplified() + QL1S("...");
-
-        return contents;
+      else if (index_column == MSG_DB_LABELS) {
+        return labelNames(data(idx.row(), MSG_DB_LABELS_IDS, Qt::ItemDataRole::EditRole).toString());
       }
       else if (index_column == MSG_DB_LABELS_IDS) {
-        return m_cache->containsData(idx.row()) ? m_cache->data(idx) : QSqlQueryModel::data(idx, role);
+        return m_cache->containsData(idx.row()) ? m_cache->data(idx) : recordData(idx);
       }
       else if (index_column == MSG_DB_AUTHOR_INDEX) {
-        const QString author_name = QSqlQueryModel::data(idx, role).toString();
+        const QString author_name = recordData(idx).toString();
 
         return author_name.isEmpty() ? QSL("-") : author_name;
       }
       else if (index_column != MSG_DB_IMPORTANT_INDEX && index_column != MSG_DB_READ_INDEX &&
                index_column != MSG_DB_HAS_ENCLOSURES && index_column != MSG_DB_SCORE_INDEX) {
-        return QSqlQueryModel::data(idx, role);
+        return recordData(idx);
       }
       else {
         return QVariant();
@@ -439,7 +654,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
       else {
         return (m_cache->containsData(idx.row())
                   ? m_cache->data(index(idx.row(), MSG_DB_FEED_IS_RTL_INDEX))
-                  : QSqlQueryModel::data(index(idx.row(), MSG_DB_FEED_IS_RTL_INDEX), Qt::ItemDataRole::EditRole))
+                  : recordData(index(idx.row(), MSG_DB_FEED_IS_RTL_INDEX)))
                      .toInt() == 0
                  ? Qt::LayoutDirection::LayoutDirectionAuto
                  : Qt::LayoutDirection::RightToLeft;
@@ -449,10 +664,10 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
     case LOWER_TITLE_ROLE:
       return m_cache->containsData(idx.row())
                ? m_cache->data(idx).toString().toLower()
-               : QSqlQueryModel::data(idx, Qt::ItemDataRole::EditRole).toString().toLower();
+               : recordData(idx).toString().toLower();
 
     case Qt::ItemDataRole::EditRole:
-      return m_cache->containsData(idx.row()) ? m_cache->data(idx) : QSqlQueryModel::data(idx, role);
+      return m_cache->containsData(idx.row()) ? m_cache->data(idx) : recordData(idx);
 
     case Qt::ItemDataRole::ToolTipRole: {
       if (!qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::EnableTooltipsFeedsMessages)).toBool()) {
@@ -510,7 +725,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
       if (Globals::hasFlag(m_messageHighlighter, MessageHighlighter::HighlightImportant)) {
         QModelIndex idx_important = index(idx.row(), MSG_DB_IMPORTANT_INDEX);
         QVariant dta = m_cache->containsData(idx_important.row()) ? m_cache->data(idx_important)
-                                                                  : QSqlQueryModel::data(idx_important);
+                                                                  : recordData(idx_important);
 
         if (dta.toInt() == 1) {
           return qApp->skins()->colorForModel(role == Qt::ItemDataRole::ForegroundRole
@@ -521,7 +736,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
 
       if (Globals::hasFlag(m_messageHighlighter, MessageHighlighter::HighlightUnread)) {
         QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
-        QVariant dta = m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : QSqlQueryModel::data(idx_read);
+        QVariant dta = m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : recordData(idx_read);
 
         if (dta.toInt() == 0) {
           return qApp->skins()->colorForModel(role == Qt::ItemDataRole::ForegroundRole
@@ -539,21 +754,32 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
         return {};
       }
       else {
-        auto wd = m_view->columnWidth(idx.column());
-        QString str = data(idx, Qt::ItemDataRole::DisplayRole).toString();
+        const int wd = m_view->columnWidth(idx.column());
+        const int id = messageId(idx.row());
+        const QString str = data(idx, Qt::ItemDataRole::DisplayRole).toString();
+        const QFont fnt = data(idx, Qt::ItemDataRole::FontRole).value<QFont>();
+        RowLayout* layout = m_layoutCache.object(id);
+
+        // NOTE: Text layout is expensive, so it is computed only when the row is seen for
+        // the first time or when its text, font or width of the column changes.
+        if (layout == nullptr || layout->m_width != wd || layout->m_font != fnt || layout->m_text != str) {
+          QSize size;
+
+          if (!str.simplified().isEmpty()) {
+            QFontMetrics fm(fnt);
+
+            size = fm.boundingRect(QRect(QPoint(0, 0), QPoint(wd - 5, 100000)),
+                                   Qt::TextFlag::TextWordWrap | Qt::AlignmentFlag::AlignLeft |
+                                     Qt::AlignmentFlag::AlignVCenter,
+                                   str)
+                     .size();
+          }
 
-        if (str.simplified().isEmpty()) {
-          return {};
+          layout = new RowLayout{wd, fnt, str, size};
+          m_layoutCache.insert(id, layout);
         }
 
-        QFontMetrics fm(data(idx, Qt::ItemDataRole::FontRole).value<QFont>());
-        auto rct =
-          fm.boundingRect(QRect(QPoint(0, 0), QPoint(wd - 5, 100000)),
-                          Qt::TextFlag::TextWordWrap | Qt::AlignmentFlag::AlignLeft | Qt::AlignmentFlag::AlignVCenter,
-                          str)
-            .size();
-
-        return rct;
+        return layout->m_size.isValid() ? QVariant(layout->m_size) : QVariant();
       }
     }
 
@@ -564,7 +790,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
         if (m_unreadIconType == MessageUnreadIcon::FeedIcon && m_selectedItem != nullptr) {
           QModelIndex idx_feedid = index(idx.row(), MSG_DB_FEED_CUSTOM_ID_INDEX);
           QVariant dta =
-            m_cache->containsData(idx_feedid.row()) ? m_cache->data(idx_feedid) : QSqlQueryModel::data(idx_feedid);
+            m_cache->containsData(idx_feedid.row()) ? m_cache->data(idx_feedid) : recordData(idx_feedid);
           QString feed_custom_id = dta.toString();
 
           // TODO: Very slow and repeats itself.
@@ -580,7 +806,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
         else {
           QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
           QVariant dta =
-            m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : QSqlQueryModel::data(idx_read);
+            m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : recordData(idx_read);
 
           if (m_unreadIconType == MessageUnreadIcon::Dot) {
             return dta.toInt() == 1 ? QVariant() : m_unreadIcon;
@@ -593,18 +819,18 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
       else if (index_column == MSG_DB_IMPORTANT_INDEX) {
         QModelIndex idx_important = index(idx.row(), MSG_DB_IMPORTANT_INDEX);
         QVariant dta = m_cache->containsData(idx_important.row()) ? m_cache->data(idx_important)
-                                                                  : QSqlQueryModel::data(idx_important);
+                                                                  : recordData(idx_important);
 
         return dta.toInt() == 1 ? m_favoriteIcon : QVariant();
       }
       else if (index_column == MSG_DB_HAS_ENCLOSURES) {
         QModelIndex idx_enc = index(idx.row(), MSG_DB_HAS_ENCLOSURES);
-        QVariant dta = QSqlQueryModel::data(idx_enc);
+        QVariant dta = recordData(idx_enc);
 
         return dta.toBool() ? m_enclosuresIcon : QVariant();
       }
       else if (index_column == MSG_DB_SCORE_INDEX) {
-        QVariant dta = QSqlQueryModel::data(idx);
+        QVariant dta = recordData(idx);
         int level = std::min(MSG_SCORE_MAX, std::max(MSG_SCORE_MIN, std::floor(dta.toDouble() / 10.0)));
 
         return m_scoreIcons.at(level);
@@ -635,7 +861,7 @@ bool MessagesModel::setMessageRead(int row_index, RootItem::ReadStatus read) {
     return true;
   }
 
-  Message message = messageAt(row_index);
+  Message message = messageHeaderAt(row_index);
 
   if (!m_selectedItem->getParentServiceRoot()->onBeforeSetMessagesRead(m_selectedItem, {message}, read)) {
     // Cannot change read status of the item. Abort.
@@ -662,40 +888,36 @@ bool MessagesModel::setMessageRead(int row_index, RootItem::ReadStatus read) {
 }
 
 bool MessagesModel::setMessageReadById(int id, RootItem::ReadStatus read) {
-  for (int i = 0; i < rowCount(); i++) {
-    int found_id = data(i, MSG_DB_ID_INDEX, Qt::ItemDataRole::EditRole).toInt();
+  const int row = rowOfMessage(id);
 
-    if (found_id == id) {
-      bool set = setData(index(i, MSG_DB_READ_INDEX), int(read));
+  if (row < 0) {
+    return false;
+  }
 
-      if (set) {
-        emit dataChanged(index(i, 0), index(i, MSG_DB_LABELS_IDS));
-      }
+  bool set = setData(index(row, MSG_DB_READ_INDEX), int(read));
 
-      return set;
-    }
+  if (set) {
+    emit dataChanged(index(row, 0), index(row, MSG_DB_LABELS_IDS));
   }
 
-  return false;
+  return set;
 }
 
 bool MessagesModel::setMessageLabelsById(int id, const QStringList& label_ids) {
-  for (int i = 0; i < rowCount(); i++) {
-    int found_id = data(i, MSG_DB_ID_INDEX, Qt::ItemDataRole::EditRole).toInt();
+  const int row = rowOfMessage(id);
 
-    if (found_id == id) {
-      QString enc_ids = label_ids.isEmpty() ? QSL(".") : QSL(".") + label_ids.join('.') + QSL(".");
-      bool set = setData(index(i, MSG_DB_LABELS_IDS), enc_ids);
+  if (row < 0) {
+    return false;
+  }
 
-      if (set) {
-        emit dataChanged(index(i, 0), index(i, MSG_DB_LABELS_IDS));
-      }
+  QString enc_ids = label_ids.isEmpty() ? QSL(".") : QSL(".") + label_ids.join('.') + QSL(".");
+  bool set = setData(index(row, MSG_DB_LABELS_IDS), enc_ids);
 
-      return set;
-    }
+  if (set) {
+    emit dataChanged(index(row, 0), index(row, MSG_DB_LABELS_IDS));
   }
 
-  return false;
+  return set;
 }
 
 bool MessagesModel::switchMessageImportance(int row_index) {
@@ -704,7 +926,7 @@ bool MessagesModel::switchMessageImportance(int row_index) {
   const RootItem::Importance next_importance = current_importance == RootItem::Importance::Important
                                                  ? RootItem::Importance::NotImportant
                                                  : RootItem::Importance::Important;
-  const Message message = messageAt(row_index);
+  const Message message = messageHeaderAt(row_index);
   const QPair<Message, RootItem::Importance> pair(message, next_importance);
 
   if (!m_selectedItem->getParentServiceRoot()
@@ -743,7 +965,7 @@ bool MessagesModel::switchBatchMessageImportance(const QModelIndexList& messages
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    const Message msg = messageAt(message.row());
+    const Message msg = messageHeaderAt(message.row());
 
     RootItem::Importance message_importance = messageImportance((message.row()));
 
@@ -781,7 +1003,7 @@ bool MessagesModel::setBatchMessagesDeleted(const QModelIndexList& messages) {
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    const Message msg = messageAt(message.row());
+    const Message msg = messageHeaderAt(message.row());
 
     msgs.append(msg);
     message_ids.append(QString::number(msg.m_id));
@@ -825,7 +1047,7 @@ bool MessagesModel::setBatchMessagesRead(const QModelIndexList& messages, RootIt
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    Message msg = messageAt(message.row());
+    Message msg = messageHeaderAt(message.row());
 
     msgs.append(msg);
     message_ids.append(QString::number(msg.m_id));
@@ -854,7 +1076,7 @@ bool MessagesModel::setBatchMessagesRestored(const QModelIndexList& messages) {
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    const Message msg = messageAt(message.row());
+    const Message msg = messageHeaderAt(message.row());
 
     msgs.append(msg);
     message_ids.append(QString::number(msg.m_id));
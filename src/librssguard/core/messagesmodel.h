@@ -8,14 +8,16 @@
 #include "definitions/definitions.h"
 #include "services/abstract/rootitem.h"
 
+#include <QAbstractTableModel>
+#include <QCache>
 #include <QFont>
 #include <QIcon>
-#include <QSqlQueryModel>
+#include <QSqlRecord>
 
 class MessagesView;
 class MessagesModelCache;
 
-class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
+class MessagesModel : public QAbstractTableModel, public MessagesModelSqlLayer {
     Q_OBJECT
 
   public:
@@ -43,7 +45,18 @@ class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
     // NOTE: This activates the SQL query and populates the model with new data.
     void repopulate(int additional_article_id = 0);
 
+    // Inserts new and refreshes existing rows of given articles without
+    // reloading whole model. New rows are placed according to current sort order.
+    // Returns false if articles could not be merged and model should be repopulated instead.
+    bool mergeArticles(const QList<int>& article_ids);
+
+    // Returns row of article with given ID or -1.
+    int rowOfMessage(int id) const;
+
     // Model implementation.
+    int rowCount(const QModelIndex& parent = QModelIndex()) const;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const;
+    QSqlRecord record(int row_index) const;
     bool setData(const QModelIndex& idx, const QVariant& value, int role = Qt::EditRole);
     QVariant data(const QModelIndex& idx, int role = Qt::DisplayRole) const;
     QVariant data(int row, int column, int role = Qt::DisplayRole) const;
@@ -96,8 +109,30 @@ class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
     bool setMessageLabelsById(int id, const QStringList& label_ids);
 
   private:
+    // Computed layout of title of article in multiline list mode.
+    struct RowLayout {
+        int m_width;
+        QFont m_font;
+        QString m_text;
+        QSize m_size;
+    };
+
     void setupHeaderData();
     void setupIcons();
+    void setupLabelNames();
+    void rebuildIdIndex();
+
+    // Returns raw data as loaded from DB, without cached changes.
+    QVariant recordData(const QModelIndex& idx) const;
+
+    // Creates message from the list row, its contents and enclosures are NOT loaded.
+    Message messageHeaderAt(int row_index) const;
+
+    // Loads contents and enclosures of given messages, recently
+    // loaded bodies are served from cache.
+    void loadMessageBodies(QList<Message>& messages) const;
+
+    QString labelNames(const QString& label_ids) const;
 
   private:
     MessagesView* m_view;
@@ -121,6 +156,11 @@ class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
     QList<QIcon> m_scoreIcons;
     MessageUnreadIcon m_unreadIconType;
     bool m_multilineListItems;
+    QList<QSqlRecord> m_records;
+    QHash<int, int> m_idIndex;
+    QHash<QString, QString> m_labelNames;
+    mutable QCache<int, Message> m_bodiesCache;
+    mutable QCache<int, RowLayout> m_layoutCache;
 };
 
 Q_DECLARE_METATYPE(MessagesModel::MessageHighlighter)
@@ -17,3 +17,30 @@ void MessagesModelCache::setData(const QModelIndex& index, const QVariant& value
 QVariant MessagesModelCache::data(const QModelIndex& idx) {
   return m_msgCache[idx.row()].value(idx.column());
 }
+
+void MessagesModelCache::setRecord(int row_idx, const QSqlRecord& record) {
+  if (m_msgCache.contains(row_idx)) {
+    m_msgCache[row_idx] = record;
+  }
+}
+
+void MessagesModelCache::shiftRows(int first_row, int count) {
+  if (m_msgCache.isEmpty()) {
+    return;
+  }
+
+  QHash<int, QSqlRecord> shifted;
+
+  shifted.reserve(m_msgCache.size());
+
+  for (auto it = m_msgCache.cbegin(); it != m_msgCache.cend(); it++) {
+    if (it.key() < first_row && it.key() >= first_row + count) {
+      // Row is removed.
+      continue;
+    }
+
+    shifted.insert(it.key() >= first_row ? it.key() + count : it.key(), it.value());
+  }
+
+  m_msgCache = shifted;
+}
@@ -23,6 +23,13 @@ class MessagesModelCache : public QObject {
     void clear();
     void setData(const QModelIndex& index, const QVariant& value);
 
+    // Replaces cached record with fresh one, if the row is cached.
+    void setRecord(int row_idx, const QSqlRecord& record);
+
+    // Moves cached rows when new rows are inserted into (count > 0)
+    // or rows before "first_row" are removed from (count < 0) the model.
+    void shiftRows(int first_row, int count);
+
   private:
     QHash<int, QSqlRecord> m_msgCache;
 };
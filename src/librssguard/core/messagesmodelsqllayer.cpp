@@ -2,18 +2,24 @@
 
 #include "core/messagesmodelsqllayer.h"
 
+#include "database/databasefactory.h"
 #include "database/databasequeries.h"
 #include "definitions/definitions.h"
 #include "definitions/globals.h"
 #include "miscellaneous/application.h"
 
+#include <cstring>
+
+#include <QDateTime>
+
 MessagesModelSqlLayer::MessagesModelSqlLayer()
-  : m_filter(QSL(DEFAULT_SQL_MESSAGES_FILTER)), m_fieldNames({}), m_orderByNames({}), m_sortColumns({}),
-    m_numericColumns({}), m_sortOrders({}) {
+  : m_filter(QSL(DEFAULT_SQL_MESSAGES_FILTER)),
+    m_messageListFilter(MessagesProxyModel::MessageListFilter::NoFiltering), m_fieldNames({}), m_orderByNames({}),
+    m_sortColumns({}), m_numericColumns({}), m_sortOrders({}) {
   m_db = qApp->database()->driver()->connection(QSL("MessagesModel"));
 
   // Used in <x>: SELECT <x1>, <x2> FROM ....;
-  m_fieldNames = DatabaseQueries::messageTableAttributes(false, m_db.driverName() == QSL(APP_DB_SQLITE_DRIVER));
+  m_fieldNames = DatabaseQueries::messageTableAttributes(false, false);
 
   // Used in <x>: SELECT ... FROM ... ORDER BY <x1> DESC, <x2> ASC;
   m_orderByNames[MSG_DB_ID_INDEX] = QSL("Messages.id");
@@ -26,7 +32,7 @@ MessagesModelSqlLayer::MessagesModelSqlLayer()
   m_orderByNames[MSG_DB_URL_INDEX] = QSL("Messages.url");
   m_orderByNames[MSG_DB_AUTHOR_INDEX] = QSL("Messages.author");
   m_orderByNames[MSG_DB_DCREATED_INDEX] = QSL("Messages.date_created");
-  m_orderByNames[MSG_DB_CONTENTS_INDEX] = QSL("Messages.contents");
+  m_orderByNames[MSG_DB_CONTENTS_INDEX] = DatabaseQueries::contentsColumn();
   m_orderByNames[MSG_DB_ENCLOSURES_INDEX] = QSL("Messages.enclosures");
   m_orderByNames[MSG_DB_SCORE_INDEX] = QSL("Messages.score");
   m_orderByNames[MSG_DB_ACCOUNT_ID_INDEX] = QSL("Messages.account_id");
@@ -34,8 +40,8 @@ MessagesModelSqlLayer::MessagesModelSqlLayer()
   m_orderByNames[MSG_DB_CUSTOM_HASH_INDEX] = QSL("Messages.custom_hash");
   m_orderByNames[MSG_DB_FEED_TITLE_INDEX] = QSL("Feeds.title");
   m_orderByNames[MSG_DB_FEED_IS_RTL_INDEX] = QSL("Feeds.is_rtl");
-  m_orderByNames[MSG_DB_HAS_ENCLOSURES] = QSL("has_enclosures");
-  m_orderByNames[MSG_DB_LABELS] = QSL("msg_labels");
+  m_orderByNames[MSG_DB_HAS_ENCLOSURES] = QSL("Messages.has_enclosures");
+  m_orderByNames[MSG_DB_LABELS] = QSL("Messages.labels");
   m_orderByNames[MSG_DB_LABELS_IDS] = QSL("Messages.labels");
 
   m_numericColumns << MSG_DB_ID_INDEX << MSG_DB_READ_INDEX << MSG_DB_DELETED_INDEX << MSG_DB_PDELETED_INDEX
@@ -79,6 +85,10 @@ void MessagesModelSqlLayer::setFilter(const QString& filter) {
   m_filter = filter;
 }
 
+void MessagesModelSqlLayer::setMessageListFilter(MessagesProxyModel::MessageListFilter filter) {
+  m_messageListFilter = filter;
+}
+
 SortColumnsAndOrders MessagesModelSqlLayer::sortColumnAndOrders() const {
   SortColumnsAndOrders res;
 
@@ -96,14 +106,81 @@ bool MessagesModelSqlLayer::isColumnNumeric(int column_id) const {
   return m_numericColumns.contains(column_id);
 }
 
+QString MessagesModelSqlLayer::filterClause() const {
+  const QString list_filter = messageListFilterClause();
+
+  return list_filter.isEmpty() ? m_filter : QSL("(%1) AND %2").arg(m_filter, list_filter);
+}
+
+QString MessagesModelSqlLayer::messageListFilterClause() const {
+  using Filter = MessagesProxyModel::MessageListFilter;
+
+  if (m_messageListFilter == Filter::NoFiltering) {
+    return QString();
+  }
+
+  const QDateTime current_dt = QDateTime::currentDateTime();
+  const QDate current_d = current_dt.date();
+  const QDate this_week = current_d.addDays(1 - current_d.dayOfWeek());
+  const QDate last_week = this_week.addDays(-7);
+  auto created_between = [](const QDateTime& from, const QDateTime& to) {
+    return QSL("Messages.date_created BETWEEN %1 AND %2")
+      .arg(QString::number(from.toMSecsSinceEpoch()), QString::number(to.toMSecsSinceEpoch()));
+  };
+  QStringList conditions;
+
+  // NOTE: Article is displayed if it matches any of active filters.
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowUnread)) {
+    conditions.append(QSL("Messages.is_read = 0"));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowImportant)) {
+    conditions.append(QSL("Messages.is_important = 1"));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowToday)) {
+    conditions.append(created_between(current_d.startOfDay(), current_d.endOfDay()));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowYesterday)) {
+    conditions.append(created_between(current_d.addDays(-1).startOfDay(), current_d.addDays(-1).endOfDay()));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowLast24Hours)) {
+    conditions.append(created_between(current_dt.addSecs(-24 * 60 * 60), current_dt));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowLast48Hours)) {
+    conditions.append(created_between(current_dt.addSecs(-48 * 60 * 60), current_dt));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowThisWeek)) {
+    conditions.append(created_between(this_week.startOfDay(), this_week.addDays(6).endOfDay()));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowLastWeek)) {
+    conditions.append(created_between(last_week.startOfDay(), last_week.addDays(6).endOfDay()));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowOnlyWithAttachments)) {
+    conditions.append(QSL("Messages.has_enclosures = 1"));
+  }
+
+  if (Globals::hasFlag(m_messageListFilter, Filter::ShowOnlyWithScore)) {
+    conditions.append(QSL("Messages.score > %1").arg(MSG_SCORE_MIN));
+  }
+
+  return conditions.isEmpty() ? QString() : QSL("(%1)").arg(conditions.join(QSL(" OR ")));
+}
+
 QString MessagesModelSqlLayer::selectStatement(int additional_article_id) const {
   QString fltr;
 
   if (additional_article_id <= 0) {
-    fltr = m_filter;
+    fltr = filterClause();
   }
   else {
-    fltr = QSL("(%1) OR Messages.id = %2").arg(m_filter, QString::number(additional_article_id));
+    fltr = QSL("(%1) OR Messages.id = %2").arg(filterClause(), QString::number(additional_article_id));
   }
 
   return QL1S("SELECT ") + formatFields() + QL1C(' ') +
@@ -113,6 +190,91 @@ QString MessagesModelSqlLayer::selectStatement(int additional_article_id) const
          fltr + orderByClause() + QL1C(';');
 }
 
+QString MessagesModelSqlLayer::selectStatementForArticles(const QList<int>& article_ids) const {
+  QStringList ids;
+
+  ids.reserve(article_ids.size());
+
+  for (int id : article_ids) {
+    ids.append(QString::number(id));
+  }
+
+  return QL1S("SELECT ") + formatFields() + QL1C(' ') +
+         QL1S("FROM Messages LEFT JOIN Feeds ON Messages.feed = Feeds.custom_id AND Messages.account_id = "
+              "Feeds.account_id "
+              "WHERE ") +
+         QSL("(%1) AND Messages.id IN (%2)").arg(filterClause(), ids.join(QSL(", "))) + QL1C(';');
+}
+
+bool MessagesModelSqlLayer::canCompareRecords() const {
+  if (qApp->database()->activeDatabaseDriver() == DatabaseDriver::DriverType::SQLite) {
+    return true;
+  }
+
+  // NOTE: Text columns are ordered by collation of the database server.
+  for (int column : m_sortColumns) {
+    if (!isColumnNumeric(column)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int MessagesModelSqlLayer::compareSqliteText(const QVariant& lhs, const QVariant& rhs) {
+  // NOTE: SQLite's LOWER() only folds ASCII letters and text
+  // is compared byte by byte in UTF-8.
+  auto lower_ascii = [](const QVariant& val) {
+    QByteArray bytes = val.toString().toUtf8();
+
+    for (char& chr : bytes) {
+      if (chr >= 'A' && chr <= 'Z') {
+        chr = char(chr + ('a' - 'A'));
+      }
+    }
+
+    return bytes;
+  };
+
+  const QByteArray lhs_bytes = lower_ascii(lhs);
+  const QByteArray rhs_bytes = lower_ascii(rhs);
+  const int cmp =
+    std::memcmp(lhs_bytes.constData(), rhs_bytes.constData(), size_t(qMin(lhs_bytes.size(), rhs_bytes.size())));
+
+  return cmp != 0 ? cmp : int(lhs_bytes.size() - rhs_bytes.size());
+}
+
+bool MessagesModelSqlLayer::recordLessThan(const QSqlRecord& lhs, const QSqlRecord& rhs) const {
+  for (int i = 0; i < m_sortColumns.size(); i++) {
+    // NOTE: Names of labels are not part of records, list
+    // is sorted by IDs of labels.
+    const int column = m_sortColumns[i] == MSG_DB_LABELS ? MSG_DB_LABELS_IDS : m_sortColumns[i];
+    const QVariant lhs_val = lhs.value(column);
+    const QVariant rhs_val = rhs.value(column);
+    int cmp;
+
+    if (lhs_val.isNull() || rhs_val.isNull()) {
+      // NULL values are sorted before all other values.
+      cmp = int(rhs_val.isNull()) - int(lhs_val.isNull());
+    }
+    else if (isColumnNumeric(column)) {
+      const double lhs_num = lhs_val.toDouble();
+      const double rhs_num = rhs_val.toDouble();
+
+      cmp = lhs_num < rhs_num ? -1 : (lhs_num > rhs_num ? 1 : 0);
+    }
+    else {
+      cmp = compareSqliteText(lhs_val, rhs_val);
+    }
+
+    if (cmp != 0) {
+      return m_sortOrders[i] == Qt::SortOrder::AscendingOrder ? cmp < 0 : cmp > 0;
+    }
+  }
+
+  return false;
+}
+
 QString MessagesModelSqlLayer::orderByClause() const {
   if (m_sortColumns.isEmpty()) {
     return QString();
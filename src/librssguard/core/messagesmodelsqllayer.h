@@ -3,10 +3,13 @@
 #ifndef MESSAGESMODELSQLLAYER_H
 #define MESSAGESMODELSQLLAYER_H
 
+#include "core/messagesproxymodel.h"
+
 #include <QList>
 #include <QMap>
 #include <QPair>
 #include <QSqlDatabase>
+#include <QSqlRecord>
 
 struct SortColumnsAndOrders {
     QList<int> m_columns;
@@ -23,19 +26,41 @@ class MessagesModelSqlLayer {
     // Sets SQL WHERE clause, without "WHERE" keyword.
     void setFilter(const QString& filter);
 
+    // Sets quick filter, which further restricts articles selected by SQL WHERE clause.
+    void setMessageListFilter(MessagesProxyModel::MessageListFilter filter);
+
     SortColumnsAndOrders sortColumnAndOrders() const;
 
   protected:
     QString orderByClause() const;
     QString selectStatement(int additional_article_id = -1) const;
+
+    // Selects only articles with given IDs which match current filter.
+    QString selectStatementForArticles(const QList<int>& article_ids) const;
     QString formatFields() const;
 
+    // Client-side equivalent of ORDER BY clause for records
+    // returned by select statements above.
+    bool recordLessThan(const QSqlRecord& lhs, const QSqlRecord& rhs) const;
+
+    // Returns false if records cannot be ordered exactly as database orders them
+    // with current sort columns. In that case, model must be repopulated.
+    bool canCompareRecords() const;
+
     bool isColumnNumeric(int column_id) const;
 
     QSqlDatabase m_db;
 
   private:
+    // Returns complete SQL WHERE clause, quick filter is translated
+    // to conditions with bounds calculated for current date/time.
+    QString filterClause() const;
+
+    static int compareSqliteText(const QVariant& lhs, const QVariant& rhs);
+    QString messageListFilterClause() const;
+
     QString m_filter;
+    MessagesProxyModel::MessageListFilter m_messageListFilter;
 
     // NOTE: These two lists contain data for multicolumn sorting.
     // They are always same length. Most important sort column/order
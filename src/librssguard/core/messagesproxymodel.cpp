@@ -3,20 +3,13 @@
 #include "core/messagesproxymodel.h"
 
 #include "core/messagesmodel.h"
-#include "core/messagesmodelcache.h"
 #include "definitions/globals.h"
 #include "miscellaneous/regexfactory.h"
-#include "miscellaneous/textfactory.h"
-
-#include <QTimer>
 
 MessagesProxyModel::MessagesProxyModel(MessagesModel* source_model, QObject* parent)
-  : QSortFilterProxyModel(parent), m_sourceModel(source_model), m_filter(MessageListFilter::NoFiltering),
-    m_additionalArticleId(0) {
+  : QSortFilterProxyModel(parent), m_sourceModel(source_model) {
   setObjectName(QSL("MessagesProxyModel"));
 
-  initializeFilters();
-
   setSortRole(Qt::ItemDataRole::EditRole);
   setSortCaseSensitivity(Qt::CaseSensitivity::CaseInsensitive);
 
@@ -31,109 +24,6 @@ MessagesProxyModel::~MessagesProxyModel() {
   qDebugNN << LOGSEC_MESSAGEMODEL << "Destroying MessagesProxyModel instance.";
 }
 
-void MessagesProxyModel::initializeFilters() {
-  m_filters[MessageListFilter::ShowUnread] = [this](int msg_row_index) {
-    return !m_sourceModel->data(msg_row_index, MSG_DB_READ_INDEX, Qt::ItemDataRole::EditRole).toBool();
-  };
-
-  m_filters[MessageListFilter::ShowImportant] = [this](int msg_row_index) {
-    return m_sourceModel->data(msg_row_index, MSG_DB_IMPORTANT_INDEX, Qt::ItemDataRole::EditRole).toBool();
-  };
-
-  m_filters[MessageListFilter::ShowToday] = [this](int msg_row_index) {
-    const QDateTime current_dt = QDateTime::currentDateTime();
-    const QDate current_d = current_dt.date();
-    const QDateTime msg_created =
-      TextFactory::parseDateTime(m_sourceModel->data(msg_row_index, MSG_DB_DCREATED_INDEX, Qt::ItemDataRole::EditRole)
-                                   .value<qint64>());
-
-    return current_d.startOfDay() <= msg_created && msg_created <= current_d.endOfDay();
-  };
-
-  m_filters[MessageListFilter::ShowYesterday] = [this](int msg_row_index) {
-    const QDateTime current_dt = QDateTime::currentDateTime();
-    const QDate current_d = current_dt.date();
-    const QDateTime msg_created =
-      TextFactory::parseDateTime(m_sourceModel->data(msg_row_index, MSG_DB_DCREATED_INDEX, Qt::ItemDataRole::EditRole)
-                                   .value<qint64>());
-
-    return current_d.addDays(-1).startOfDay() <= msg_created && msg_created <= current_d.addDays(-1).endOfDay();
-  };
-
-  m_filters[MessageListFilter::ShowLast24Hours] = [this](int msg_row_index) {
-    const QDateTime current_dt = QDateTime::currentDateTime();
-    const QDateTime msg_created =
-      TextFactory::parseDateTime(m_sourceModel->data(msg_row_index, MSG_DB_DCREATED_INDEX, Qt::ItemDataRole::EditRole)
-                                   .value<qint64>());
-
-    return current_dt.addSecs(-24 * 60 * 60) <= msg_created && msg_created <= current_dt;
-  };
-
-  m_filters[MessageListFilter::ShowLast48Hours] = [this](int msg_row_index) {
-    const QDateTime current_dt = QDateTime::currentDateTime();
-    const QDateTime msg_created =
-      TextFactory::parseDateTime(m_sourceModel->data(msg_row_index, MSG_DB_DCREATED_INDEX, Qt::ItemDataRole::EditRole)
-                                   .value<qint64>());
-
-    return current_dt.addSecs(-48 * 60 * 60) <= msg_created && msg_created <= current_dt;
-  };
-
-  m_filters[MessageListFilter::ShowThisWeek] = [this](int msg_row_index) {
-    const QDateTime current_dt = QDateTime::currentDateTime();
-    const QDate current_d = current_dt.date();
-    const QDateTime msg_created =
-      TextFactory::parseDateTime(m_sourceModel->data(msg_row_index, MSG_DB_DCREATED_INDEX, Qt::ItemDataRole::EditRole)
-                                   .value<qint64>());
-
-    return current_d.year() == msg_created.date().year() && current_d.weekNumber() == msg_created.date().weekNumber();
-  };
-
-  m_filters[MessageListFilter::ShowLastWeek] = [this](int msg_row_index) {
-    const QDateTime current_dt = QDateTime::currentDateTime();
-    const QDate current_d = current_dt.date();
-    const QDateTime msg_created =
-      TextFactory::parseDateTime(m_sourceModel->data(msg_row_index, MSG_DB_DCREATED_INDEX, Qt::ItemDataRole::EditRole)
-                                   .value<qint64>());
-
-    return current_d.addDays(-7).year() == msg_created.date().year() &&
-           current_d.addDays(-7).weekNumber() == msg_created.date().weekNumber();
-  };
-
-  m_filters[MessageListFilter::ShowOnlyWithAttachments] = [this](int msg_row_index) {
-    const bool msg_has_enclosures =
-      m_sourceModel->data(msg_row_index, MSG_DB_HAS_ENCLOSURES, Qt::ItemDataRole::EditRole).toBool();
-
-    return msg_has_enclosures;
-  };
-
-  m_filters[MessageListFilter::ShowOnlyWithScore] = [this](int msg_row_index) {
-    const int msg_score = m_sourceModel->data(msg_row_index, MSG_DB_SCORE_INDEX, Qt::ItemDataRole::EditRole).toDouble();
-
-    return msg_score > MSG_SCORE_MIN;
-  };
-
-  m_filterKeys = m_filters.keys();
-}
-
-bool MessagesProxyModel::filterAcceptsMessage(int msg_row_index) const {
-  if (m_filter == MessageListFilter::NoFiltering) {
-    return true;
-  }
-  else if (m_additionalArticleId > 0 &&
-           m_sourceModel->data(msg_row_index, MSG_DB_ID_INDEX, Qt::ItemDataRole::EditRole).toInt() ==
-             m_additionalArticleId) {
-    return true;
-  }
-
-  for (MessageListFilter val : m_filterKeys) {
-    if (Globals::hasFlag(m_filter, val) && m_filters[val](msg_row_index)) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 QModelIndex MessagesProxyModel::getNextPreviousImportantItemIndex(int default_row) const {
   const bool started_from_zero = default_row == 0;
   QModelIndex next_index = getNextImportantItemIndex(default_row, rowCount() - 1);
@@ -159,18 +49,9 @@ QModelIndex MessagesProxyModel::getNextPreviousUnreadItemIndex(int default_row)
 }
 
 QModelIndex MessagesProxyModel::indexFromMessage(const Message& msg) const {
-  for (int i = 0; i < rowCount(); i++) {
-    auto idx = index(i, 0);
-    auto id =
-      m_sourceModel->data(m_sourceModel->index(mapToSource(idx).row(), MSG_DB_ID_INDEX), Qt::ItemDataRole::EditRole)
-        .toInt();
-
-    if (id == msg.m_id) {
-      return idx;
-    }
-  }
+  const int source_row = m_sourceModel->rowOfMessage(msg.m_id);
 
-  return QModelIndex();
+  return source_row < 0 ? QModelIndex() : mapFromSource(m_sourceModel->index(source_row, 0));
 }
 
 QModelIndex MessagesProxyModel::getNextImportantItemIndex(int default_row, int max_row) const {
@@ -220,28 +101,9 @@ bool MessagesProxyModel::lessThan(const QModelIndex& left, const QModelIndex& ri
   return false;
 }
 
-bool MessagesProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const {
-  // We want to show only regexped messages when "all" should be visible
-  // and we want to show only regexped AND unread messages when unread should be visible.
-  //
-  // But also, we want to see messages which have their dirty states cached, because
-  // otherwise they would just disappear from the list for example when batch marked as read
-  // which is distracting.
-  return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent) &&
-         (m_sourceModel->cache()->containsData(source_row) || filterAcceptsMessage(source_row));
-}
-
-int MessagesProxyModel::additionalArticleId() const {
-  return m_additionalArticleId;
-}
-
-void MessagesProxyModel::setAdditionalArticleId(int newAdditionalArticleId) {
-  m_additionalArticleId = newAdditionalArticleId;
-}
-
 void MessagesProxyModel::setMessageListFilter(MessageListFilter filter) {
-  m_filter = filter;
-  m_additionalArticleId = 0;
+  // NOTE: Filtering is done by SQL server itself when model is repopulated.
+  m_sourceModel->setMessageListFilter(filter);
 }
 
 QModelIndexList MessagesProxyModel::mapListFromSource(const QModelIndexList& indexes, bool deep) const {
@@ -52,26 +52,14 @@ class MessagesProxyModel : public QSortFilterProxyModel {
     // Performs sort of items.
     virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
 
-    int additionalArticleId() const;
-    void setAdditionalArticleId(int newAdditionalArticleId);
-
   private:
-    void initializeFilters();
-
     QModelIndex getNextImportantItemIndex(int default_row, int max_row) const;
     QModelIndex getNextUnreadItemIndex(int default_row, int max_row) const;
 
-    bool filterAcceptsMessage(int msg_row_index) const;
-
     virtual bool lessThan(const QModelIndex& left, const QModelIndex& right) const;
-    virtual bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const;
 
     // Source model pointer.
     MessagesModel* m_sourceModel;
-    MessageListFilter m_filter;
-    QMap<MessageListFilter, std::function<bool(int)>> m_filters;
-    QList<MessageListFilter> m_filterKeys;
-    int m_additionalArticleId;
 };
 
 Q_DECLARE_METATYPE(MessagesProxyModel::MessageListFilter)
@@ -2,89 +2,130 @@
 
 #include "database/databasecleaner.h"
 
-#include "database/databasequeries.h"
 #include "miscellaneous/application.h"
+#include "miscellaneous/settings.h"
 #include "miscellaneous/thread.h"
 
 #include <QDebug>
 
-DatabaseCleaner::DatabaseCleaner(QObject* parent) : QObject(parent) {}
+DatabaseCleaner::DatabaseCleaner(QObject* parent) : QObject(parent), m_cancelRequested(false) {
+  qRegisterMetaType<CleanerOrders>("CleanerOrders");
+}
+
+void DatabaseCleaner::cancelPurging() {
+  m_cancelRequested = true;
+}
+
+bool DatabaseCleaner::isPurgingCancelled() const {
+  return m_cancelRequested;
+}
 
 void DatabaseCleaner::purgeDatabaseData(CleanerOrders which_data) {
   qDebugNN << LOGSEC_DB << "Performing database cleanup in thread:" << QUOTE_W_SPACE_DOT(getThreadID());
 
+  m_cancelRequested = false;
+
   // Inform everyone about the start of the process.
   emit purgeStarted();
   bool result = true;
   const int difference = 99 / 12;
   int progress = 0;
-  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+  QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(metaObject()->className());
 
-  if (which_data.m_removeReadMessages) {
+  if (which_data.m_removeReadMessages && !m_cancelRequested) {
     progress += difference;
     emit purgeProgress(progress, tr("Removing read articles..."));
 
     // Remove read messages.
-    result &= purgeReadMessages(database);
+    result &= purgeReadMessages(database, purgeReporter(progress, tr("Removing read articles...")));
     progress += difference;
     emit purgeProgress(progress, tr("Read articles purged..."));
   }
 
-  if (which_data.m_removeRecycleBin) {
+  if (which_data.m_removeRecycleBin && !m_cancelRequested) {
     progress += difference;
     emit purgeProgress(progress, tr("Purging recycle bin..."));
 
     // Remove read messages.
-    result &= purgeRecycleBin(database);
+    result &= purgeRecycleBin(database, purgeReporter(progress, tr("Purging recycle bin...")));
     progress += difference;
     emit purgeProgress(progress, tr("Recycle bin purged..."));
   }
 
-  if (which_data.m_removeOldMessages) {
+  if (which_data.m_removeOldMessages && !m_cancelRequested) {
     progress += difference;
     emit purgeProgress(progress, tr("Removing old articles..."));
 
     // Remove old messages.
-    result &= purgeOldMessages(database, which_data.m_barrierForRemovingOldMessagesInDays);
+    result &= purgeOldMessages(database,
+                               which_data.m_barrierForRemovingOldMessagesInDays,
+                               purgeReporter(progress, tr("Removing old articles...")));
     progress += difference;
     emit purgeProgress(progress, tr("Old articles purged..."));
   }
 
-  if (which_data.m_removeStarredMessages) {
+  if (which_data.m_removeStarredMessages && !m_cancelRequested) {
     progress += difference;
     emit purgeProgress(progress, tr("Removing starred articles..."));
 
     // Remove old messages.
-    result &= purgeStarredMessages(database);
+    result &= purgeStarredMessages(database, purgeReporter(progress, tr("Removing starred articles...")));
     progress += difference;
     emit purgeProgress(progress, tr("Starred articles purged..."));
   }
 
-  if (which_data.m_shrinkDatabase) {
+  if (which_data.m_shrinkDatabase && !m_cancelRequested) {
     progress += difference;
     emit purgeProgress(progress, tr("Shrinking database file..."));
 
+    result &= DatabaseQueries::purgeUnusedIcons(database);
+
+    if (qApp->settings()->snapshot()->m_compressArticleContents && !m_cancelRequested) {
+      result &= DatabaseQueries::compressArticleContents(database, [this, progress](int compressed_count) {
+        emit purgeProgress(progress,
+                           tr("Shrinking database file...") + QL1C(' ') +
+                             tr("%n article(s) compressed.", nullptr, compressed_count));
+
+        return !m_cancelRequested;
+      });
+    }
+
     // Call driver-specific vacuuming function.
     result &= qApp->database()->driver()->vacuumDatabase();
     progress += difference;
     emit purgeProgress(progress, tr("Database file shrinked..."));
   }
 
+  if (m_cancelRequested) {
+    qDebugNN << LOGSEC_DB << "Database cleanup was cancelled.";
+  }
+
   emit purgeFinished(result);
 }
 
-bool DatabaseCleaner::purgeStarredMessages(const QSqlDatabase& database) {
-  return DatabaseQueries::purgeImportantMessages(database);
+DatabaseQueries::PurgeReporter DatabaseCleaner::purgeReporter(int progress, const QString& description) {
+  return [this, progress, description](int removed_count) {
+    emit purgeProgress(progress, description + QL1C(' ') + tr("%n article(s) removed.", nullptr, removed_count));
+
+    return !m_cancelRequested;
+  };
+}
+
+bool DatabaseCleaner::purgeStarredMessages(const QSqlDatabase& database,
+                                           const DatabaseQueries::PurgeReporter& reporter) {
+  return DatabaseQueries::purgeImportantMessages(database, reporter);
 }
 
-bool DatabaseCleaner::purgeReadMessages(const QSqlDatabase& database) {
-  return DatabaseQueries::purgeReadMessages(database);
+bool DatabaseCleaner::purgeReadMessages(const QSqlDatabase& database, const DatabaseQueries::PurgeReporter& reporter) {
+  return DatabaseQueries::purgeReadMessages(database, reporter);
 }
 
-bool DatabaseCleaner::purgeOldMessages(const QSqlDatabase& database, int days) {
-  return DatabaseQueries::purgeOldMessages(database, days);
+bool DatabaseCleaner::purgeOldMessages(const QSqlDatabase& database,
+                                       int days,
+                                       const DatabaseQueries::PurgeReporter& reporter) {
+  return DatabaseQueries::purgeOldMessages(database, days, reporter);
 }
 
-bool DatabaseCleaner::purgeRecycleBin(const QSqlDatabase& database) {
-  return DatabaseQueries::purgeRecycleBin(database);
+bool DatabaseCleaner::purgeRecycleBin(const QSqlDatabase& database, const DatabaseQueries::PurgeReporter& reporter) {
+  return DatabaseQueries::purgeRecycleBin(database, reporter);
 }
@@ -3,9 +3,13 @@
 #ifndef DATABASECLEANER_H
 #define DATABASECLEANER_H
 
+#include "database/databasequeries.h"
+
 #include <QObject>
 #include <QSqlDatabase>
 
+#include <atomic>
+
 struct CleanerOrders {
     bool m_removeReadMessages;
     bool m_shrinkDatabase;
@@ -15,6 +19,8 @@ struct CleanerOrders {
     int m_barrierForRemovingOldMessagesInDays;
 };
 
+// Performs database cleanup. Cleaner is supposed to live in its own thread,
+// running cleanup can be cancelled from any thread.
 class DatabaseCleaner : public QObject {
     Q_OBJECT
 
@@ -22,6 +28,11 @@ class DatabaseCleaner : public QObject {
     explicit DatabaseCleaner(QObject* parent = nullptr);
     virtual ~DatabaseCleaner() = default;
 
+    // Requests cancellation of running cleanup, which stops after
+    // currently processed chunk of articles.
+    void cancelPurging();
+    bool isPurgingCancelled() const;
+
   signals:
     void purgeStarted();
     void purgeProgress(int progress, const QString& description);
@@ -31,10 +42,15 @@ class DatabaseCleaner : public QObject {
     void purgeDatabaseData(CleanerOrders which_data);
 
   private:
-    bool purgeStarredMessages(const QSqlDatabase& database);
-    bool purgeReadMessages(const QSqlDatabase& database);
-    bool purgeOldMessages(const QSqlDatabase& database, int days);
-    bool purgeRecycleBin(const QSqlDatabase& database);
+    DatabaseQueries::PurgeReporter purgeReporter(int progress, const QString& description);
+
+    bool purgeStarredMessages(const QSqlDatabase& database, const DatabaseQueries::PurgeReporter& reporter);
+    bool purgeReadMessages(const QSqlDatabase& database, const DatabaseQueries::PurgeReporter& reporter);
+    bool purgeOldMessages(const QSqlDatabase& database, int days, const DatabaseQueries::PurgeReporter& reporter);
+    bool purgeRecycleBin(const QSqlDatabase& database, const DatabaseQueries::PurgeReporter& reporter);
+
+  private:
+    std::atomic_bool m_cancelRequested;
 };
 
 #endif // DATABASECLEANER_H
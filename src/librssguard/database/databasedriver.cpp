@@ -2,6 +2,7 @@
 
 #include "database/databasedriver.h"
 
+#include "database/databasequeries.h"
 #include "definitions/definitions.h"
 #include "exceptions/applicationexception.h"
 #include "miscellaneous/iofactory.h"
@@ -14,6 +15,43 @@
 
 DatabaseDriver::DatabaseDriver(QObject* parent) : QObject(parent) {}
 
+DatabaseDriver::~DatabaseDriver() {
+  for (const QHash<QString, QSqlQuery*>& queries : std::as_const(m_preparedQueries)) {
+    qDeleteAll(queries);
+  }
+}
+
+QSqlQuery& DatabaseDriver::preparedQuery(const QSqlDatabase& db, const QString& statement) {
+  QMutexLocker lck(&m_preparedQueriesMutex);
+  QHash<QString, QSqlQuery*>& queries = m_preparedQueries[db.connectionName()];
+  QSqlQuery* query = queries.value(statement);
+
+  if (query == nullptr) {
+    query = new QSqlQuery(db);
+    query->setForwardOnly(true);
+    queries.insert(statement, query);
+  }
+  else if (!query->lastError().isValid()) {
+    // Query is prepared already, just make sure its previous results are released.
+    query->finish();
+    return *query;
+  }
+
+  // NOTE: Query is (re)prepared if it is new or if its last execution failed,
+  // for example because connection to database server was lost.
+  if (!query->prepare(statement)) {
+    qWarningNN << LOGSEC_DB << "Failed to prepare query:" << QUOTE_W_SPACE_DOT(query->lastError().text());
+  }
+
+  return *query;
+}
+
+void DatabaseDriver::clearPreparedQueries(const QString& connection_name) {
+  QMutexLocker lck(&m_preparedQueriesMutex);
+
+  qDeleteAll(m_preparedQueries.take(connection_name));
+}
+
 QSqlDatabase DatabaseDriver::threadSafeConnection(const QString& connection_name, DesiredStorageType desired_type) {
   qlonglong thread_id = getThreadID();
   bool is_main_thread = QThread::currentThread() == qApp->thread();
@@ -24,7 +62,23 @@ QSqlDatabase DatabaseDriver::threadSafeConnection(const QString& connection_name
   return database;
 }
 
-void DatabaseDriver::updateDatabaseSchema(QSqlQuery& query,
+void DatabaseDriver::removeThreadSafeConnection() {
+  if (QThread::currentThread() == qApp->thread()) {
+    return;
+  }
+
+  const QString connection_name = QSL("db_connection_%1").arg(getThreadID());
+
+  if (QSqlDatabase::contains(connection_name)) {
+    qDebugNN << LOGSEC_DB << "Removing database connection" << QUOTE_W_SPACE_DOT(connection_name);
+
+    clearPreparedQueries(connection_name);
+    QSqlDatabase::removeDatabase(connection_name);
+  }
+}
+
+void DatabaseDriver::updateDatabaseSchema(const QSqlDatabase& database,
+                                          QSqlQuery& query,
                                           int source_db_schema_version,
                                           const QString& database_name) {
   const int current_version = QSL(APP_DB_SCHEMA_VERSION).toInt();
@@ -48,6 +102,11 @@ void DatabaseDriver::updateDatabaseSchema(QSqlQuery& query,
              << QUOTE_W_SPACE_DOT(source_db_schema_version + 1);
 
     source_db_schema_version++;
+
+    // NOTE: Hashes of stored articles are calculated by application, not by SQL script.
+    if (source_db_schema_version == 12) {
+      DatabaseQueries::fillContentHashes(database);
+    }
   }
 
   setSchemaVersion(query, current_version, false);
@@ -103,6 +162,7 @@ QStringList DatabaseDriver::prepareScript(const QString& base_sql_folder,
   statements = statements.replaceInStrings(QSL(APP_DB_NAME_PLACEHOLDER), database_name);
   statements = statements.replaceInStrings(QSL(APP_DB_AUTO_INC_PRIM_KEY_PLACEHOLDER), autoIncrementPrimaryKey());
   statements = statements.replaceInStrings(QSL(APP_DB_BLOB_PLACEHOLDER), blob());
+  statements = statements.replaceInStrings(QSL(APP_DB_TEXT_KEY_LENGTH_PLACEHOLDER), textKeyLength());
 
   return statements;
 }
@@ -3,6 +3,8 @@
 #ifndef DATABASEDRIVER_H
 #define DATABASEDRIVER_H
 
+#include <QHash>
+#include <QMutex>
 #include <QObject>
 #include <QSqlDatabase>
 #include <QSqlQuery>
@@ -25,11 +27,29 @@ class RSSGUARD_DLLSPEC DatabaseDriver : public QObject {
     };
 
     explicit DatabaseDriver(QObject* parent = nullptr);
+    virtual ~DatabaseDriver();
 
     QSqlDatabase threadSafeConnection(const QString& connection_name,
                                       DatabaseDriver::DesiredStorageType desired_type =
                                         DatabaseDriver::DesiredStorageType::FromSettings);
 
+    // Removes connection which was created by threadSafeConnection() for calling worker thread.
+    // Must be called by the thread before it finishes, otherwise the connection would be
+    // reused by some later thread with the same ID.
+    void removeThreadSafeConnection();
+
+    // Returns query with given statement prepared for given connection. Queries are
+    // cached per connection, so that frequently executed statements are sent to
+    // database server only once and then only executed with new bound values.
+    //
+    // NOTE: Returned query is owned by the driver and can only be used by the thread
+    // which uses the connection. Caller should call finish() when done with results.
+    QSqlQuery& preparedQuery(const QSqlDatabase& db, const QString& statement);
+
+    // Drops all cached queries of given connection. This must be done
+    // before the connection is closed, reopened or removed.
+    void clearPreparedQueries(const QString& connection_name);
+
     // API.
     virtual QString location() const = 0;
     virtual QString humanDriverType() const = 0;
@@ -38,6 +58,9 @@ class RSSGUARD_DLLSPEC DatabaseDriver : public QObject {
     virtual DriverType driverType() const = 0;
     virtual QString autoIncrementPrimaryKey() const = 0;
     virtual QString blob() const = 0;
+
+    // Length of indexed prefix of TEXT columns.
+    virtual QString textKeyLength() const = 0;
     virtual bool vacuumDatabase() = 0;
     virtual bool saveDatabase() = 0;
     virtual void backupDatabase(const QString& backup_folder, const QString& backup_name) = 0;
@@ -49,13 +72,20 @@ class RSSGUARD_DLLSPEC DatabaseDriver : public QObject {
                                       DatabaseDriver::DesiredStorageType::FromSettings) = 0;
 
   protected:
-    void updateDatabaseSchema(QSqlQuery& query, int source_db_schema_version, const QString& database_name = {});
+    void updateDatabaseSchema(const QSqlDatabase& database,
+                              QSqlQuery& query,
+                              int source_db_schema_version,
+                              const QString& database_name = {});
 
     void setSchemaVersion(QSqlQuery& query, int new_schema_version, bool empty_table);
 
     QStringList prepareScript(const QString& base_sql_folder,
                               const QString& sql_file,
                               const QString& database_name = {});
+
+  private:
+    QMutex m_preparedQueriesMutex;
+    QHash<QString, QHash<QString, QSqlQuery*>> m_preparedQueries;
 };
 
 #endif // DATABASEDRIVER_H
@@ -18,12 +18,19 @@
 #include <QSqlResult>
 #include <QVariant>
 
+#include <algorithm>
+
 DatabaseFactory::DatabaseFactory(QObject* parent) : QObject(parent), m_dbDriver(nullptr) {
   determineDriver();
 }
 
 void DatabaseFactory::removeConnection(const QString& connection_name) {
   qDebugNN << LOGSEC_DB << "Removing database connection '" << connection_name << "'.";
+
+  if (m_dbDriver != nullptr) {
+    m_dbDriver->clearPreparedQueries(connection_name);
+  }
+
   QSqlDatabase::removeDatabase(connection_name);
 }
 
@@ -104,6 +111,34 @@ QString DatabaseFactory::escapeQuery(const QString& query) {
   //.replace(QSL("\""), QSL("\\\""));
 }
 
+QByteArray DatabaseFactory::compress(const QByteArray& data) {
+  if (data.isEmpty()) {
+    return {};
+  }
+
+  // NOTE: Qt prefixes compressed data with big-endian size of original
+  // data, MariaDB stores the size in little-endian byte order.
+  QByteArray compressed = qCompress(data);
+
+  std::reverse(compressed.begin(), compressed.begin() + 4);
+  return compressed;
+}
+
+QByteArray DatabaseFactory::uncompress(const QByteArray& data) {
+  if (data.size() <= 4) {
+    return {};
+  }
+
+  QByteArray compressed = data;
+
+  std::reverse(compressed.begin(), compressed.begin() + 4);
+
+  // MariaDB uses only lower 30 bits of the size.
+  compressed[0] = char(compressed.at(0) & 0x3F);
+
+  return qUncompress(compressed);
+}
+
 DatabaseDriver::DriverType DatabaseFactory::activeDatabaseDriver() const {
   return m_dbDriver->driverType();
 }
@@ -26,6 +26,11 @@ class RSSGUARD_DLLSPEC DatabaseFactory : public QObject {
     static QString lastExecutedQuery(const QSqlQuery& query);
     static QString escapeQuery(const QString& query);
 
+    // Compresses or decompresses data in the format of COMPRESS() and UNCOMPRESS()
+    // MariaDB functions. SQLite connections are given the same SQL functions.
+    static QByteArray compress(const QByteArray& data);
+    static QByteArray uncompress(const QByteArray& data);
+
   private:
     void determineDriver();
 
@@ -8,13 +8,15 @@
 #include "miscellaneous/application.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/settings.h"
+#include "miscellaneous/textfactory.h"
+#include "miscellaneous/tracer.h"
 #include "services/abstract/category.h"
 
 #include <QSqlDriver>
 #include <QUrl>
 #include <QVariant>
 
-QMap<int, QString> DatabaseQueries::messageTableAttributes(bool only_msg_table, bool is_sqlite) {
+QMap<int, QString> DatabaseQueries::messageTableAttributes(bool only_msg_table, bool with_bodies) {
   QMap<int, QString> field_names;
 
   field_names[MSG_DB_ID_INDEX] = QSL("Messages.id");
@@ -27,40 +29,64 @@ QMap<int, QString> DatabaseQueries::messageTableAttributes(bool only_msg_table,
   field_names[MSG_DB_URL_INDEX] = QSL("Messages.url");
   field_names[MSG_DB_AUTHOR_INDEX] = QSL("Messages.author");
   field_names[MSG_DB_DCREATED_INDEX] = QSL("Messages.date_created");
-  field_names[MSG_DB_CONTENTS_INDEX] = QSL("Messages.contents");
-  field_names[MSG_DB_ENCLOSURES_INDEX] = QSL("Messages.enclosures");
+
+  // NOTE: Article list does not need bodies, they are
+  // loaded lazily via getMessageBodies() when needed.
+  field_names[MSG_DB_CONTENTS_INDEX] = with_bodies ? contentsColumn() + QSL(" AS contents") : QSL("'' AS contents");
+  field_names[MSG_DB_ENCLOSURES_INDEX] = with_bodies ? QSL("Messages.enclosures") : QSL("'' AS enclosures");
   field_names[MSG_DB_SCORE_INDEX] = QSL("Messages.score");
   field_names[MSG_DB_ACCOUNT_ID_INDEX] = QSL("Messages.account_id");
   field_names[MSG_DB_CUSTOM_ID_INDEX] = QSL("Messages.custom_id");
   field_names[MSG_DB_CUSTOM_HASH_INDEX] = QSL("Messages.custom_hash");
   field_names[MSG_DB_FEED_TITLE_INDEX] = only_msg_table ? QSL("Messages.feed") : QSL("Feeds.title");
   field_names[MSG_DB_FEED_IS_RTL_INDEX] = only_msg_table ? QSL("0") : QSL("Feeds.is_rtl");
-  field_names[MSG_DB_HAS_ENCLOSURES] = QSL("CASE WHEN LENGTH(Messages.enclosures) > 10 "
-                                           "THEN 'true' "
-                                           "ELSE 'false' "
-                                           "END AS has_enclosures");
+  field_names[MSG_DB_HAS_ENCLOSURES] = QSL("Messages.has_enclosures");
+
+  // NOTE: Names of labels are resolved from label IDs
+  // in memory, see MessagesModel::labelNames().
+  field_names[MSG_DB_LABELS] = QSL("'' AS msg_labels");
+  field_names[MSG_DB_LABELS_IDS] = QSL("Messages.labels");
+
+  return field_names;
+}
 
-  if (is_sqlite) {
-    field_names[MSG_DB_LABELS] = QSL("(SELECT GROUP_CONCAT(Labels.name) FROM Labels WHERE Messages.labels LIKE '%.' || "
-                                     "Labels.custom_id || '.%') as msg_labels");
+QString DatabaseQueries::contentsColumn() {
+  if (qApp->database()->activeDatabaseDriver() == DatabaseDriver::DriverType::MySQL) {
+    return QSL("COALESCE(CONVERT(UNCOMPRESS(Messages.contents_compressed) USING utf8mb4), Messages.contents)");
   }
   else {
-    field_names[MSG_DB_LABELS] =
-      QSL("(SELECT GROUP_CONCAT(Labels.name) FROM Labels WHERE Messages.labels LIKE CONCAT('%.', "
-          "Labels.custom_id, '.%')) as msg_labels");
+    return QSL("COALESCE(UNCOMPRESS(Messages.contents_compressed), Messages.contents)");
   }
+}
 
-  field_names[MSG_DB_LABELS_IDS] = QSL("Messages.labels");
+QString DatabaseQueries::fullContentsColumn() {
+  // NOTE: Empty full contents mean that extraction failed.
+  if (qApp->database()->activeDatabaseDriver() == DatabaseDriver::DriverType::MySQL) {
+    return QSL("COALESCE(CONVERT(UNCOMPRESS(Messages.full_contents_compressed) USING utf8mb4), "
+               "NULLIF(Messages.full_contents, ''), %1)")
+      .arg(contentsColumn());
+  }
+  else {
+    return QSL("COALESCE(UNCOMPRESS(Messages.full_contents_compressed), NULLIF(Messages.full_contents, ''), %1)")
+      .arg(contentsColumn());
+  }
+}
 
-  // TODO: zpomaluje zobrazení seznamu zpráv
-  /*
-  field_names[MSG_DB_LABELS] =
-    QSL("(SELECT GROUP_CONCAT(Labels.name) FROM Labels WHERE Labels.custom_id IN (SELECT "
-        "LabelsInMessages.label FROM LabelsInMessages WHERE LabelsInMessages.account_id = "
-        "Messages.account_id AND LabelsInMessages.message = Messages.custom_id)) as msg_labels");
-        */
+void DatabaseQueries::setConnectionReadOnly(const QSqlDatabase& db, bool read_only) {
+  QSqlQuery q(db);
+  QString statement;
 
-  return field_names;
+  if (qApp->database()->activeDatabaseDriver() == DatabaseDriver::DriverType::MySQL) {
+    statement = read_only ? QSL("SET SESSION TRANSACTION READ ONLY;") : QSL("SET SESSION TRANSACTION READ WRITE;");
+  }
+  else {
+    statement = QSL("PRAGMA query_only = %1;").arg(read_only ? 1 : 0);
+  }
+
+  if (!q.exec(statement)) {
+    qWarningNN << LOGSEC_DB << "Failed to switch read-only mode of connection:"
+               << QUOTE_W_SPACE_DOT(q.lastError().text());
+  }
 }
 
 QString DatabaseQueries::serializeCustomData(const QVariantHash& data) {
@@ -84,30 +110,27 @@ QVariantHash DatabaseQueries::deserializeCustomData(const QString& data) {
 }
 
 bool DatabaseQueries::isLabelAssignedToMessage(const QSqlDatabase& db, Label* label, const Message& msg) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("SELECT COUNT(*) FROM Messages "
-                "WHERE "
-                "  Messages.labels LIKE :label AND "
-                "  Messages.custom_id = :message AND "
-                "  account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("SELECT COUNT(*) FROM Messages "
+                                   "WHERE "
+                                   "  Messages.labels LIKE :label AND "
+                                   "  Messages.custom_id = :message AND "
+                                   "  account_id = :account_id;"));
   q.bindValue(QSL(":label"), QSL("%.%1.%").arg(label->customId()));
   q.bindValue(QSL(":message"), msg.m_customId);
   q.bindValue(QSL(":account_id"), label->getParentServiceRoot()->accountId());
 
-  q.exec() && q.next();
+  const bool assigned = q.exec() && q.next() && q.value(0).toInt() > 0;
 
-  return q.record().value(0).toInt() > 0;
+  q.finish();
+  return assigned;
 }
 
 bool DatabaseQueries::deassignLabelFromMessage(const QSqlDatabase& db, Label* label, const Message& msg) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("UPDATE Messages "
-                "SET labels = REPLACE(Messages.labels, :label, \".\") "
-                "WHERE Messages.custom_id = :message AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("UPDATE Messages "
+                                   "SET labels = REPLACE(Messages.labels, :label, \".\") "
+                                   "WHERE Messages.custom_id = :message AND account_id = :account_id;"));
   q.bindValue(QSL(":label"), QSL(".%1.").arg(label->customId()));
   q.bindValue(QSL(":message"), msg.m_customId.isEmpty() ? QString::number(msg.m_id) : msg.m_customId);
   q.bindValue(QSL(":account_id"), label->getParentServiceRoot()->accountId());
@@ -118,21 +141,21 @@ bool DatabaseQueries::deassignLabelFromMessage(const QSqlDatabase& db, Label* la
 bool DatabaseQueries::assignLabelToMessage(const QSqlDatabase& db, Label* label, const Message& msg) {
   deassignLabelFromMessage(db, label, msg);
 
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
+  QString statement;
 
   if (db.driverName() == QSL(APP_DB_MYSQL_DRIVER)) {
-    q.prepare(QSL("UPDATE Messages "
-                  "SET labels = CONCAT(Messages.labels, :label) "
-                  "WHERE Messages.custom_id = :message AND account_id = :account_id;"));
+    statement = QSL("UPDATE Messages "
+                    "SET labels = CONCAT(Messages.labels, :label) "
+                    "WHERE Messages.custom_id = :message AND account_id = :account_id;");
   }
   else {
-    q.prepare(QSL("UPDATE Messages "
-                  "SET labels = Messages.labels || :label "
-                  "WHERE Messages.custom_id = :message AND account_id = :account_id;"));
+    statement = QSL("UPDATE Messages "
+                    "SET labels = Messages.labels || :label "
+                    "WHERE Messages.custom_id = :message AND account_id = :account_id;");
   }
 
+  QSqlQuery& q = preparedQuery(db, statement);
+
   q.bindValue(QSL(":label"), QSL("%1.").arg(label->customId()));
   q.bindValue(QSL(":message"), msg.m_customId.isEmpty() ? QString::number(msg.m_id) : msg.m_customId);
   q.bindValue(QSL(":account_id"), label->getParentServiceRoot()->accountId());
@@ -141,8 +164,6 @@ bool DatabaseQueries::assignLabelToMessage(const QSqlDatabase& db, Label* label,
 }
 
 bool DatabaseQueries::setLabelsForMessage(const QSqlDatabase& db, const QList<Label*>& labels, const Message& msg) {
-  QSqlQuery q(db);
-
   auto std_lbls = boolinq::from(labels)
                     .select([](Label* lbl) {
                       return lbl->customId();
@@ -152,10 +173,10 @@ bool DatabaseQueries::setLabelsForMessage(const QSqlDatabase& db, const QList<La
   QStringList lbls = FROM_STD_LIST(QStringList, std_lbls);
   QString lblss = QSL(".") + lbls.join('.') + QSL(".");
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("UPDATE Messages "
-                "SET labels = :labels "
-                "WHERE Messages.custom_id = :message AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("UPDATE Messages "
+                                   "SET labels = :labels "
+                                   "WHERE Messages.custom_id = :message AND account_id = :account_id;"));
   q.bindValue(QSL(":labels"), lblss);
   q.bindValue(QSL(":message"), msg.m_customId.isEmpty() ? QString::number(msg.m_id) : msg.m_customId);
   q.bindValue(QSL(":account_id"), msg.m_accountId);
@@ -163,6 +184,45 @@ bool DatabaseQueries::setLabelsForMessage(const QSqlDatabase& db, const QList<La
   return q.exec();
 }
 
+bool DatabaseQueries::setLabelsForMessages(const QSqlDatabase& db, const QList<Message>& messages, int account_id) {
+  QHash<QString, QStringList> ids_per_labels;
+
+  for (const Message& msg : messages) {
+    if (msg.m_customId.isEmpty() && msg.m_id <= 0) {
+      continue;
+    }
+
+    QStringList lbls;
+
+    for (const Label* lbl : msg.m_assignedLabels) {
+      lbls.append(lbl->customId());
+    }
+
+    const QString id = msg.m_customId.isEmpty() ? QString::number(msg.m_id) : msg.m_customId;
+
+    ids_per_labels[QSL(".") + lbls.join('.') + QSL(".")].append(QSL("'%1'").arg(DatabaseFactory::escapeQuery(id)));
+  }
+
+  bool ok = true;
+
+  for (auto it = ids_per_labels.constBegin(); it != ids_per_labels.constEnd(); it++) {
+    for (int i = 0; i < it.value().size(); i += 500) {
+      QSqlQuery q(db);
+
+      if (!q.exec(QSL("UPDATE Messages SET labels = '%1' "
+                      "WHERE account_id = %2 AND custom_id IN (%3);")
+                    .arg(DatabaseFactory::escapeQuery(it.key()),
+                         QString::number(account_id),
+                         it.value().mid(i, 500).join(QSL(", "))))) {
+        qCriticalNN << LOGSEC_DB << "Failed to set labels of articles:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+        ok = false;
+      }
+    }
+  }
+
+  return ok;
+}
+
 QList<Label*> DatabaseQueries::getLabelsForAccount(const QSqlDatabase& db, int account_id) {
   QList<Label*> labels;
   QSqlQuery q(db);
@@ -368,15 +428,13 @@ void DatabaseQueries::deleteProbe(const QSqlDatabase& db, Search* probe) {
 }
 
 bool DatabaseQueries::markLabelledMessagesReadUnread(const QSqlDatabase& db, Label* label, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("UPDATE Messages SET is_read = :read "
-                "WHERE "
-                "    is_deleted = 0 AND "
-                "    is_pdeleted = 0 AND "
-                "    account_id = :account_id AND "
-                "    labels LIKE :label;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("UPDATE Messages SET is_read = :read "
+                                   "WHERE "
+                                   "    is_deleted = 0 AND "
+                                   "    is_pdeleted = 0 AND "
+                                   "    account_id = :account_id AND "
+                                   "    labels LIKE :label;"));
   q.bindValue(QSL(":read"), read == RootItem::ReadStatus::Read ? 1 : 0);
   q.bindValue(QSL(":account_id"), label->getParentServiceRoot()->accountId());
   q.bindValue(QSL(":label"), QSL("%.%1.%").arg(label->customId()));
@@ -387,22 +445,20 @@ bool DatabaseQueries::markLabelledMessagesReadUnread(const QSqlDatabase& db, Lab
 bool DatabaseQueries::markImportantMessagesReadUnread(const QSqlDatabase& db,
                                                       int account_id,
                                                       RootItem::ReadStatus read) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("UPDATE Messages SET is_read = :read "
-                "WHERE is_important = 1 AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("UPDATE Messages SET is_read = :read "
+                                   "WHERE is_important = 1 AND is_deleted = 0 AND is_pdeleted = 0 AND "
+                                   "account_id = :account_id;"));
   q.bindValue(QSL(":read"), read == RootItem::ReadStatus::Read ? 1 : 0);
   q.bindValue(QSL(":account_id"), account_id);
   return q.exec();
 }
 
 bool DatabaseQueries::markUnreadMessagesRead(const QSqlDatabase& db, int account_id) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("UPDATE Messages SET is_read = :read "
-                "WHERE is_read = 0 AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("UPDATE Messages SET is_read = :read "
+                                   "WHERE is_read = 0 AND is_deleted = 0 AND is_pdeleted = 0 AND "
+                                   "account_id = :account_id;"));
   q.bindValue(QSL(":read"), 1);
   q.bindValue(QSL(":account_id"), account_id);
   return q.exec();
@@ -461,11 +517,9 @@ void DatabaseQueries::markMessagesReadUnreadImportant(const QSqlDatabase& db,
 }
 
 bool DatabaseQueries::markMessageImportant(const QSqlDatabase& db, int id, RootItem::Importance importance) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
+  QSqlQuery& q = preparedQuery(db, QSL("UPDATE Messages SET is_important = :important WHERE id = :id;"));
 
-  if (!q.prepare(QSL("UPDATE Messages SET is_important = :important WHERE id = :id;"))) {
+  if (q.lastError().isValid()) {
     qWarningNN << LOGSEC_DB << "Query preparation failed for message importance switch.";
     return false;
   }
@@ -493,21 +547,18 @@ bool DatabaseQueries::markFeedsReadUnread(const QSqlDatabase& db,
 }
 
 bool DatabaseQueries::markBinReadUnread(const QSqlDatabase& db, int account_id, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("UPDATE Messages SET is_read = :read "
-                "WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("UPDATE Messages SET is_read = :read "
+                                   "WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;"));
   q.bindValue(QSL(":read"), read == RootItem::ReadStatus::Read ? 1 : 0);
   q.bindValue(QSL(":account_id"), account_id);
   return q.exec();
 }
 
 bool DatabaseQueries::markAccountReadUnread(const QSqlDatabase& db, int account_id, RootItem::ReadStatus read) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("UPDATE Messages SET is_read = :read WHERE is_pdeleted = 0 AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("UPDATE Messages SET is_read = :read "
+                                   "WHERE is_pdeleted = 0 AND account_id = :account_id;"));
   q.bindValue(QSL(":account_id"), account_id);
   q.bindValue(QSL(":read"), read == RootItem::ReadStatus::Read ? 1 : 0);
   return q.exec();
@@ -545,93 +596,108 @@ bool DatabaseQueries::restoreBin(const QSqlDatabase& db, int account_id) {
   return q.exec();
 }
 
-bool DatabaseQueries::removeUnwantedArticlesFromFeed(const QSqlDatabase& db,
-                                                     const Feed* feed,
-                                                     const Feed::ArticleIgnoreLimit& feed_setup,
-                                                     const Feed::ArticleIgnoreLimit& app_setup) {
-  // Feed setup has higher preference.
-  int amount_to_keep =
-    feed_setup.m_customizeLimitting ? feed_setup.m_keepCountOfArticles : app_setup.m_keepCountOfArticles;
-  bool dont_remove_unread =
-    feed_setup.m_customizeLimitting ? feed_setup.m_doNotRemoveUnread : app_setup.m_doNotRemoveUnread;
-  bool dont_remove_starred =
-    feed_setup.m_customizeLimitting ? feed_setup.m_doNotRemoveStarred : app_setup.m_doNotRemoveStarred;
-  bool recycle_dont_purge =
-    feed_setup.m_customizeLimitting ? feed_setup.m_moveToBinDontPurge : app_setup.m_moveToBinDontPurge;
-
-  if (amount_to_keep <= 0) {
-    // No articles will be removed, quitting.
-    return false;
-  }
-
-  // We find datetime stamp of oldest article which will be NOT moved/removed.
-  QSqlQuery q(db);
+int DatabaseQueries::removeUnwantedArticles(const QSqlDatabase& db,
+                                            const QList<int>& account_ids,
+                                            const Feed::ArticleIgnoreLimit& app_setup) {
+  TRACE_SCOPE("db-article-retention", "db");
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("SELECT Messages.date_created "
-                "FROM Messages "
-                "WHERE "
-                "  Messages.account_id = :account_id AND "
-                "  Messages.feed = :feed AND "
-                "  Messages.is_deleted = 0 AND "
-                "  Messages.is_pdeleted = 0 "
-                "ORDER BY Messages.date_created DESC "
-                "LIMIT 1 OFFSET :offset;"));
-
-  q.bindValue(QSL(":offset"), amount_to_keep - 1);
-  q.bindValue(QSL(":feed"), feed->customId());
-  q.bindValue(QSL(":account_id"), feed->getParentServiceRoot()->accountId());
-
-  if (!q.exec()) {
-    throw ApplicationException(q.lastError().text());
-  }
-
-  if (!q.next()) {
-    return false;
-  }
-
-  qlonglong last_kept_stamp = q.value(0).toLongLong();
-
-  if (recycle_dont_purge) {
-    // We mark all older articles as deleted.
-    q.prepare(QSL("UPDATE Messages "
-                  "SET is_deleted = 1 "
-                  "WHERE "
-                  "  Messages.account_id = :account_id AND "
-                  "  Messages.feed = :feed AND "
-                  "  Messages.is_deleted = 0 AND "
-                  "  Messages.is_pdeleted = 0 AND "
-                  "  Messages.is_important != :is_important AND "
-                  "  Messages.is_read != :is_read AND "
-                  "  Messages.date_created < :stamp"));
-  }
-  else {
-    // We purge all older articles.
-    q.prepare(QSL("DELETE FROM Messages "
-                  "WHERE "
-                  "  Messages.account_id = :account_id AND "
-                  "  Messages.feed = :feed AND "
-                  "  (Messages.is_deleted = 1 OR Messages.is_important != :is_important) AND "
-                  "  (Messages.is_deleted = 1 OR Messages.is_read != :is_read) AND "
-                  "  Messages.date_created < :stamp"));
+  if (account_ids.isEmpty()) {
+    return 0;
   }
 
-  q.bindValue(QSL(":is_important"), dont_remove_starred ? 1 : 2);
-  q.bindValue(QSL(":is_read"), dont_remove_unread ? 0 : 2);
-  q.bindValue(QSL(":feed"), feed->customId());
-  q.bindValue(QSL(":stamp"), last_kept_stamp);
-  q.bindValue(QSL(":account_id"), feed->getParentServiceRoot()->accountId());
-
-  if (!q.exec()) {
-    throw ApplicationException(q.lastError().text());
-  }
+  QStringList ids;
 
-  int rows_deleted = q.numRowsAffected();
+  for (int account_id : account_ids) {
+    ids.append(QString::number(account_id));
+  }
+
+  int rows_removed = 0;
+
+  for (bool recycle_dont_purge : {true, false}) {
+    QSqlQuery q(db);
+    QString statement;
+
+    // NOTE: Candidates are wrapped in derived table, so that MariaDB
+    // allows to modify the table which is also read in subquery.
+    if (recycle_dont_purge) {
+      // We mark all older articles as deleted.
+      statement = QSL("UPDATE Messages "
+                      "SET is_deleted = 1 "
+                      "WHERE id IN ("
+                      "  SELECT Candidates.id FROM ("
+                      "    SELECT M.id "
+                      "    FROM Messages AS M "
+                      "    INNER JOIN (%1) AS Stamps ON M.account_id = Stamps.account_id AND M.feed = Stamps.feed "
+                      "    WHERE "
+                      "      M.is_deleted = 0 AND "
+                      "      M.is_pdeleted = 0 AND "
+                      "      (Stamps.keep_starred = 0 OR M.is_important = 0) AND "
+                      "      (Stamps.keep_unread = 0 OR M.is_read = 1) AND "
+                      "      M.date_created < Stamps.stamp) AS Candidates);");
+    }
+    else {
+      // We purge all older articles.
+      statement = QSL("DELETE FROM Messages "
+                      "WHERE id IN ("
+                      "  SELECT Candidates.id FROM ("
+                      "    SELECT M.id "
+                      "    FROM Messages AS M "
+                      "    INNER JOIN (%1) AS Stamps ON M.account_id = Stamps.account_id AND M.feed = Stamps.feed "
+                      "    WHERE "
+                      "      (M.is_deleted = 1 OR Stamps.keep_starred = 0 OR M.is_important = 0) AND "
+                      "      (M.is_deleted = 1 OR Stamps.keep_unread = 0 OR M.is_read = 1) AND "
+                      "      M.date_created < Stamps.stamp) AS Candidates);");
+    }
+
+    q.setForwardOnly(true);
+    q.prepare(statement.arg(articleRetentionStamps(ids.join(QSL(", ")), recycle_dont_purge)));
+
+    // Feed setup has higher preference.
+    q.bindValue(QSL(":keep_count"), app_setup.m_keepCountOfArticles);
+    q.bindValue(QSL(":keep_unread"), app_setup.m_doNotRemoveUnread ? 1 : 0);
+    q.bindValue(QSL(":keep_starred"), app_setup.m_doNotRemoveStarred ? 1 : 0);
+    q.bindValue(QSL(":recycle"), app_setup.m_moveToBinDontPurge ? 1 : 0);
 
-  qDebugNN << LOGSEC_DB << "Feed cleanup has recycled/purged" << NONQUOTE_W_SPACE(rows_deleted)
-           << "old articles from feed" << QUOTE_W_SPACE_DOT(feed->customId());
+    if (!q.exec()) {
+      throw ApplicationException(q.lastError().text());
+    }
 
-  return rows_deleted > 0;
+    rows_removed += qMax(q.numRowsAffected(), 0);
+  }
+
+  qDebugNN << LOGSEC_DB << "Article retention has recycled/purged" << NONQUOTE_W_SPACE(rows_removed)
+           << "old articles from accounts" << QUOTE_W_SPACE_DOT(ids.join(QSL(", ")));
+
+  return rows_removed;
+}
+
+QString DatabaseQueries::articleRetentionStamps(const QString& account_ids, bool recycle_dont_purge) {
+  // Finds datetime stamp of oldest article which will be NOT moved/removed, for each
+  // feed with given retention policy. Articles are ranked per feed with window function.
+  return QSL("SELECT Ranked.account_id, Ranked.feed, Ranked.date_created AS stamp, "
+             "       Policies.keep_unread, Policies.keep_starred "
+             "FROM ("
+             "  SELECT account_id, feed, date_created, "
+             "         ROW_NUMBER() OVER (PARTITION BY account_id, feed ORDER BY date_created DESC) AS article_rank "
+             "  FROM Messages "
+             "  WHERE is_deleted = 0 AND is_pdeleted = 0 AND account_id IN (%1)) AS Ranked "
+             "INNER JOIN ("
+             "  SELECT "
+             "    account_id, "
+             "    custom_id AS feed, "
+             "    CASE WHEN keep_article_customize = 1 THEN keep_article_count ELSE :keep_count END AS keep_count, "
+             "    CASE WHEN keep_article_customize = 1 THEN keep_unread_articles ELSE :keep_unread END AS keep_unread, "
+             "    CASE WHEN keep_article_customize = 1 THEN keep_starred_articles ELSE :keep_starred END "
+             "      AS keep_starred, "
+             "    CASE WHEN keep_article_customize = 1 THEN recycle_articles ELSE :recycle END AS recycle "
+             "  FROM Feeds "
+             "  WHERE account_id IN (%1)) AS Policies "
+             "ON Ranked.account_id = Policies.account_id AND Ranked.feed = Policies.feed "
+             "WHERE "
+             "  Policies.recycle = %2 AND "
+             "  Policies.keep_count > 0 AND "
+             "  Ranked.article_rank = Policies.keep_count")
+    .arg(account_ids, recycle_dont_purge ? QSL("1") : QSL("0"));
 }
 
 bool DatabaseQueries::purgeMessage(const QSqlDatabase& db, int message_id) {
@@ -644,60 +710,94 @@ bool DatabaseQueries::purgeMessage(const QSqlDatabase& db, int message_id) {
   return q.exec();
 }
 
-bool DatabaseQueries::purgeImportantMessages(const QSqlDatabase& db) {
+bool DatabaseQueries::purgeMessages(const QSqlDatabase& db, const QStringList& ids) {
   QSqlQuery q(db);
 
   q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages WHERE is_important = 1 AND is_deleted = :is_deleted;"));
-
-  // Remove only messages which are NOT in recycle bin.
-  q.bindValue(QSL(":is_deleted"), 0);
-
-  return q.exec();
+  return q.exec(QSL("DELETE FROM Messages WHERE id IN (%1);").arg(ids.join(QSL(", "))));
 }
 
-bool DatabaseQueries::purgeReadMessages(const QSqlDatabase& db) {
-  QSqlQuery q(db);
-
-  q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages "
-                "WHERE is_important = :is_important AND is_deleted = :is_deleted AND is_read = :is_read;"));
-  q.bindValue(QSL(":is_read"), 1);
-
+bool DatabaseQueries::purgeImportantMessages(const QSqlDatabase& db, const PurgeReporter& reporter) {
   // Remove only messages which are NOT in recycle bin.
-  q.bindValue(QSL(":is_deleted"), 0);
-
-  // Remove only messages which are NOT starred.
-  q.bindValue(QSL(":is_important"), 0);
+  return purgeMessagesInChunks(db,
+                               QSL("is_important = 1 AND is_deleted = :is_deleted"),
+                               {{QSL(":is_deleted"), 0}},
+                               reporter);
+}
 
-  return q.exec();
+bool DatabaseQueries::purgeReadMessages(const QSqlDatabase& db, const PurgeReporter& reporter) {
+  // Remove only messages which are NOT in recycle bin and NOT starred.
+  return purgeMessagesInChunks(db,
+                               QSL("is_important = :is_important AND is_deleted = :is_deleted AND is_read = :is_read"),
+                               {{QSL(":is_read"), 1}, {QSL(":is_deleted"), 0}, {QSL(":is_important"), 0}},
+                               reporter);
 }
 
-bool DatabaseQueries::purgeOldMessages(const QSqlDatabase& db, int older_than_days) {
-  QSqlQuery q(db);
+bool DatabaseQueries::purgeOldMessages(const QSqlDatabase& db, int older_than_days, const PurgeReporter& reporter) {
   const qint64 since_epoch = older_than_days == 0
                                ? QDateTime::currentDateTimeUtc().addYears(10).toMSecsSinceEpoch()
                                : QDateTime::currentDateTimeUtc().addDays(-older_than_days).toMSecsSinceEpoch();
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages WHERE is_important = :is_important AND date_created < :date_created;"));
-  q.bindValue(QSL(":date_created"), since_epoch);
+  // Remove only messages which are NOT starred.
+  return purgeMessagesInChunks(db,
+                               QSL("is_important = :is_important AND date_created < :date_created"),
+                               {{QSL(":date_created"), since_epoch}, {QSL(":is_important"), 0}},
+                               reporter);
+}
 
+bool DatabaseQueries::purgeRecycleBin(const QSqlDatabase& db, const PurgeReporter& reporter) {
   // Remove only messages which are NOT starred.
-  q.bindValue(QSL(":is_important"), 0);
-  return q.exec();
+  return purgeMessagesInChunks(db,
+                               QSL("is_important = :is_important AND is_deleted = :is_deleted"),
+                               {{QSL(":is_deleted"), 1}, {QSL(":is_important"), 0}},
+                               reporter);
 }
 
-bool DatabaseQueries::purgeRecycleBin(const QSqlDatabase& db) {
+bool DatabaseQueries::purgeMessagesInChunks(const QSqlDatabase& db,
+                                            const QString& condition,
+                                            const QVariantMap& bindings,
+                                            const PurgeReporter& reporter) {
   QSqlQuery q(db);
+  QString statement;
+
+  // NOTE: MariaDB does not support LIMIT in IN subqueries, but supports it directly
+  // in DELETE statements. SQLite usually has the latter disabled.
+  if (db.driverName() == QSL(APP_DB_MYSQL_DRIVER)) {
+    statement = QSL("DELETE FROM Messages WHERE %1 LIMIT %2;");
+  }
+  else {
+    statement = QSL("DELETE FROM Messages WHERE id IN (SELECT id FROM Messages WHERE %1 LIMIT %2);");
+  }
 
   q.setForwardOnly(true);
-  q.prepare(QSL("DELETE FROM Messages WHERE is_important = :is_important AND is_deleted = :is_deleted;"));
-  q.bindValue(QSL(":is_deleted"), 1);
+  q.prepare(statement.arg(condition, QString::number(APP_DB_PURGE_CHUNK_SIZE)));
 
-  // Remove only messages which are NOT starred.
-  q.bindValue(QSL(":is_important"), 0);
-  return q.exec();
+  for (auto i = bindings.cbegin(); i != bindings.cend(); i++) {
+    q.bindValue(i.key(), i.value());
+  }
+
+  int removed = 0;
+
+  while (true) {
+    if (!q.exec()) {
+      qWarningNN << LOGSEC_DB << "Failed to purge chunk of articles:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+      return false;
+    }
+
+    const int removed_now = q.numRowsAffected();
+
+    removed += qMax(removed_now, 0);
+
+    if (reporter && !reporter(removed)) {
+      qDebugNN << LOGSEC_DB << "Purging of articles was cancelled after" << NONQUOTE_W_SPACE(removed)
+               << "articles were removed.";
+      return true;
+    }
+
+    if (removed_now < APP_DB_PURGE_CHUNK_SIZE) {
+      return true;
+    }
+  }
 }
 
 QMap<QString, ArticleCounts> DatabaseQueries::getMessageCountsForCategory(const QSqlDatabase& db,
@@ -705,24 +805,28 @@ QMap<QString, ArticleCounts> DatabaseQueries::getMessageCountsForCategory(const
                                                                           int account_id,
                                                                           bool include_total_counts,
                                                                           bool* ok) {
-  QMap<QString, ArticleCounts> counts;
-  QSqlQuery q(db);
+  TRACE_SCOPE("db-counts-category", "db");
 
-  q.setForwardOnly(true);
+  QMap<QString, ArticleCounts> counts;
+  QString statement;
 
   if (include_total_counts) {
-    q.prepare(QSL("SELECT feed, SUM((is_read + 1) % 2), COUNT(*) FROM Messages "
-                  "WHERE feed IN (SELECT custom_id FROM Feeds WHERE category = :category AND account_id = :account_id) "
-                  "AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
-                  "GROUP BY feed;"));
+    statement = QSL("SELECT feed, SUM((is_read + 1) % 2), COUNT(*) FROM Messages "
+                    "WHERE feed IN "
+                    "(SELECT custom_id FROM Feeds WHERE category = :category AND account_id = :account_id) "
+                    "AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
+                    "GROUP BY feed;");
   }
   else {
-    q.prepare(QSL("SELECT feed, SUM((is_read + 1) % 2) FROM Messages "
-                  "WHERE feed IN (SELECT custom_id FROM Feeds WHERE category = :category AND account_id = :account_id) "
-                  "AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
-                  "GROUP BY feed;"));
+    statement = QSL("SELECT feed, SUM((is_read + 1) % 2) FROM Messages "
+                    "WHERE feed IN "
+                    "(SELECT custom_id FROM Feeds WHERE category = :category AND account_id = :account_id) "
+                    "AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
+                    "GROUP BY feed;");
   }
 
+  QSqlQuery& q = preparedQuery(db, statement);
+
   q.bindValue(QSL(":category"), custom_id);
   q.bindValue(QSL(":account_id"), account_id);
 
@@ -757,22 +861,24 @@ QMap<QString, ArticleCounts> DatabaseQueries::getMessageCountsForAccount(const Q
                                                                          int account_id,
                                                                          bool include_total_counts,
                                                                          bool* ok) {
-  QMap<QString, ArticleCounts> counts;
-  QSqlQuery q(db);
+  TRACE_SCOPE("db-counts-account", "db");
 
-  q.setForwardOnly(true);
+  QMap<QString, ArticleCounts> counts;
+  QString statement;
 
   if (include_total_counts) {
-    q.prepare(QSL("SELECT feed, SUM((is_read + 1) % 2), COUNT(*) FROM Messages "
-                  "WHERE is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
-                  "GROUP BY feed;"));
+    statement = QSL("SELECT feed, SUM((is_read + 1) % 2), COUNT(*) FROM Messages "
+                    "WHERE is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
+                    "GROUP BY feed;");
   }
   else {
-    q.prepare(QSL("SELECT feed, SUM((is_read + 1) % 2) FROM Messages "
-                  "WHERE is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
-                  "GROUP BY feed;"));
+    statement = QSL("SELECT feed, SUM((is_read + 1) % 2) FROM Messages "
+                    "WHERE is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id "
+                    "GROUP BY feed;");
   }
 
+  QSqlQuery& q = preparedQuery(db, statement);
+
   q.bindValue(QSL(":account_id"), account_id);
 
   if (q.exec()) {
@@ -806,11 +912,12 @@ ArticleCounts DatabaseQueries::getMessageCountsForFeed(const QSqlDatabase& db,
                                                        const QString& feed_custom_id,
                                                        int account_id,
                                                        bool* ok) {
-  QSqlQuery q(db);
+  TRACE_SCOPE("db-counts-feed", "db");
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
-                "WHERE feed = :feed AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
+                                   "WHERE feed = :feed AND is_deleted = 0 AND is_pdeleted = 0 AND "
+                                   "account_id = :account_id;"));
 
   q.bindValue(QSL(":feed"), feed_custom_id);
   q.bindValue(QSL(":account_id"), account_id);
@@ -825,6 +932,7 @@ ArticleCounts DatabaseQueries::getMessageCountsForFeed(const QSqlDatabase& db,
     ac.m_total = q.value(0).toInt();
     ac.m_unread = ac.m_total - q.value(1).toInt();
 
+    q.finish();
     return ac;
   }
   else {
@@ -840,15 +948,15 @@ ArticleCounts DatabaseQueries::getMessageCountsForLabel(const QSqlDatabase& db,
                                                         Label* label,
                                                         int account_id,
                                                         bool* ok) {
-  QSqlQuery q(db);
+  TRACE_SCOPE("db-counts-label", "db");
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
-                "WHERE "
-                "  is_deleted = 0 AND "
-                "  is_pdeleted = 0 AND "
-                "  account_id = :account_id AND "
-                "  labels LIKE :label;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
+                                   "WHERE "
+                                   "  is_deleted = 0 AND "
+                                   "  is_pdeleted = 0 AND "
+                                   "  account_id = :account_id AND "
+                                   "  labels LIKE :label;"));
 
   q.bindValue(QSL(":account_id"), account_id);
   q.bindValue(QSL(":label"), QSL("%.%1.%").arg(label->customId()));
@@ -863,6 +971,7 @@ ArticleCounts DatabaseQueries::getMessageCountsForLabel(const QSqlDatabase& db,
     ac.m_total = q.value(0).toInt();
     ac.m_unread = ac.m_total - q.value(1).toInt();
 
+    q.finish();
     return ac;
   }
   else {
@@ -875,6 +984,8 @@ ArticleCounts DatabaseQueries::getMessageCountsForLabel(const QSqlDatabase& db,
 }
 
 ArticleCounts DatabaseQueries::getMessageCountsForProbe(const QSqlDatabase& db, Search* probe, int account_id) {
+  TRACE_SCOPE("db-counts-probe", "db");
+
   QSqlQuery q(db);
 
   q.setForwardOnly(true);
@@ -883,7 +994,8 @@ ArticleCounts DatabaseQueries::getMessageCountsForProbe(const QSqlDatabase& db,
                 "  is_deleted = 0 AND "
                 "  is_pdeleted = 0 AND "
                 "  account_id = :account_id AND "
-                "  (title REGEXP :fltr OR contents REGEXP :fltr);"));
+                "  (title REGEXP :fltr OR %1 REGEXP :fltr);")
+              .arg(contentsColumn()));
 
   q.bindValue(QSL(":account_id"), account_id);
   q.bindValue(QSL(":fltr"), probe->filter());
@@ -904,6 +1016,8 @@ ArticleCounts DatabaseQueries::getMessageCountsForProbe(const QSqlDatabase& db,
 QMap<QString, ArticleCounts> DatabaseQueries::getMessageCountsForAllLabels(const QSqlDatabase& db,
                                                                            int account_id,
                                                                            bool* ok) {
+  TRACE_SCOPE("db-counts-all-labels", "db");
+
   QMap<QString, ArticleCounts> counts;
   QSqlQuery q(db);
 
@@ -1026,12 +1140,12 @@ QMap<QString, ArticleCounts> DatabaseQueries::getCountOfAssignedLabelsToMessages
 }
 
 ArticleCounts DatabaseQueries::getImportantMessageCounts(const QSqlDatabase& db, int account_id, bool* ok) {
-  QSqlQuery q(db);
+  TRACE_SCOPE("db-counts-important", "db");
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
-                "WHERE is_important = 1 AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = "
-                ":account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
+                                   "WHERE is_important = 1 AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = "
+                                   ":account_id;"));
   q.bindValue(QSL(":account_id"), account_id);
 
   if (q.exec() && q.next()) {
@@ -1044,6 +1158,7 @@ ArticleCounts DatabaseQueries::getImportantMessageCounts(const QSqlDatabase& db,
     ac.m_total = q.value(0).toInt();
     ac.m_unread = ac.m_total - q.value(1).toInt();
 
+    q.finish();
     return ac;
   }
   else {
@@ -1056,11 +1171,12 @@ ArticleCounts DatabaseQueries::getImportantMessageCounts(const QSqlDatabase& db,
 }
 
 int DatabaseQueries::getUnreadMessageCounts(const QSqlDatabase& db, int account_id, bool* ok) {
-  QSqlQuery q(db);
+  TRACE_SCOPE("db-counts-unread", "db");
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("SELECT COUNT(*) FROM Messages "
-                "WHERE is_read = 0 AND is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("SELECT COUNT(*) FROM Messages "
+                                   "WHERE is_read = 0 AND is_deleted = 0 AND is_pdeleted = 0 AND "
+                                   "account_id = :account_id;"));
 
   q.bindValue(QSL(":account_id"), account_id);
 
@@ -1069,7 +1185,10 @@ int DatabaseQueries::getUnreadMessageCounts(const QSqlDatabase& db, int account_
       *ok = true;
     }
 
-    return q.value(0).toInt();
+    const int count = q.value(0).toInt();
+
+    q.finish();
+    return count;
   }
   else {
     if (ok != nullptr) {
@@ -1081,11 +1200,11 @@ int DatabaseQueries::getUnreadMessageCounts(const QSqlDatabase& db, int account_
 }
 
 ArticleCounts DatabaseQueries::getMessageCountsForBin(const QSqlDatabase& db, int account_id, bool* ok) {
-  QSqlQuery q(db);
+  TRACE_SCOPE("db-counts-bin", "db");
 
-  q.setForwardOnly(true);
-  q.prepare(QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
-                "WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;"));
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("SELECT COUNT(*), SUM(is_read) FROM Messages "
+                                   "WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;"));
 
   q.bindValue(QSL(":account_id"), account_id);
 
@@ -1099,6 +1218,7 @@ ArticleCounts DatabaseQueries::getMessageCountsForBin(const QSqlDatabase& db, in
     ac.m_total = q.value(0).toInt();
     ac.m_unread = ac.m_total - q.value(1).toInt();
 
+    q.finish();
     return ac;
   }
   else {
@@ -1120,10 +1240,8 @@ QList<Message> DatabaseQueries::getUndeletedMessagesForProbe(const QSqlDatabase&
                 "  Messages.is_deleted = 0 AND "
                 "  Messages.is_pdeleted = 0 AND "
                 "  Messages.account_id = :account_id AND "
-                "  (title REGEXP :fltr OR contents REGEXP :fltr);")
-              .arg(messageTableAttributes(true, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+                "  (title REGEXP :fltr OR %2 REGEXP :fltr);")
+              .arg(messageTableAttributes(true).values().join(QSL(", ")), contentsColumn()));
   q.bindValue(QSL(":account_id"), probe->getParentServiceRoot()->accountId());
   q.bindValue(QSL(":fltr"), probe->filter());
 
@@ -1158,9 +1276,7 @@ QList<Message> DatabaseQueries::getUndeletedMessagesWithLabel(const QSqlDatabase
                 "  Messages.is_pdeleted = 0 AND "
                 "  Messages.account_id = :account_id AND "
                 "  Messages.labels LIKE :label;")
-              .arg(messageTableAttributes(false, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+              .arg(messageTableAttributes(false).values().join(QSL(", "))));
   q.bindValue(QSL(":account_id"), label->getParentServiceRoot()->accountId());
   q.bindValue(QSL(":label"), QSL("%.%1.%").arg(label->customId()));
 
@@ -1200,9 +1316,7 @@ QList<Message> DatabaseQueries::getUndeletedLabelledMessages(const QSqlDatabase&
                 "  Messages.is_pdeleted = 0 AND "
                 "  Messages.account_id = :account_id AND "
                 "  LENGTH(Messages.labels) > 2;")
-              .arg(messageTableAttributes(false, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+              .arg(messageTableAttributes(false).values().join(QSL(", "))));
   q.bindValue(QSL(":account_id"), account_id);
 
   if (q.exec()) {
@@ -1239,9 +1353,7 @@ QList<Message> DatabaseQueries::getUndeletedImportantMessages(const QSqlDatabase
                 "FROM Messages "
                 "WHERE is_important = 1 AND is_deleted = 0 AND "
                 "      is_pdeleted = 0 AND account_id = :account_id;")
-              .arg(messageTableAttributes(true, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+              .arg(messageTableAttributes(true).values().join(QSL(", "))));
   q.bindValue(QSL(":account_id"), account_id);
 
   if (q.exec()) {
@@ -1276,9 +1388,7 @@ QList<Message> DatabaseQueries::getUndeletedUnreadMessages(const QSqlDatabase& d
                 "FROM Messages "
                 "WHERE is_read = 0 AND is_deleted = 0 AND "
                 "      is_pdeleted = 0 AND account_id = :account_id;")
-              .arg(messageTableAttributes(true, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+              .arg(messageTableAttributes(true).values().join(QSL(", "))));
   q.bindValue(QSL(":account_id"), account_id);
 
   if (q.exec()) {
@@ -1313,6 +1423,8 @@ QList<Message> DatabaseQueries::getArticlesSlice(const QSqlDatabase& db,
                                                  qint64 start_after_article_date,
                                                  int row_offset,
                                                  int row_limit) {
+  TRACE_SCOPE("db-articles-slice", "db");
+
   QList<Message> messages;
   QSqlQuery q(db);
   QString feed_clause = !feed_custom_id.isEmpty() ? QSL("Messages.feed = :feed AND") : QString();
@@ -1343,7 +1455,7 @@ QList<Message> DatabaseQueries::getArticlesSlice(const QSqlDatabase& db,
                 "      Messages.is_pdeleted = 0 "
                 "ORDER BY Messages.date_created %2 "
                 "LIMIT :row_limit OFFSET :row_offset;")
-              .arg(messageTableAttributes(false, db.driverName() == QSL(APP_DB_SQLITE_DRIVER)).values().join(QSL(", ")),
+              .arg(messageTableAttributes(false).values().join(QSL(", ")),
                    newest_first ? QSL("DESC") : QSL("ASC"),
                    feed_clause,
                    date_created_clause,
@@ -1375,6 +1487,50 @@ QList<Message> DatabaseQueries::getArticlesSlice(const QSqlDatabase& db,
   return messages;
 }
 
+bool DatabaseQueries::fillMessageBodies(const QSqlDatabase& db, QList<Message>& messages) {
+  TRACE_SCOPE("db-message-bodies", "db");
+
+  QHash<int, int> indices;
+
+  for (int i = 0; i < messages.size(); i++) {
+    if (messages.at(i).m_id > 0) {
+      indices.insert(messages.at(i).m_id, i);
+    }
+  }
+
+  if (indices.isEmpty()) {
+    return true;
+  }
+
+  QStringList ids;
+
+  ids.reserve(indices.size());
+
+  for (auto it = indices.cbegin(); it != indices.cend(); it++) {
+    ids.append(QString::number(it.key()));
+  }
+
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+
+  // NOTE: Extracted contents of linked pages are preferred, if they were downloaded.
+  if (!q.exec(QSL("SELECT id, %1, enclosures FROM Messages WHERE id IN (%2);")
+                .arg(fullContentsColumn(), ids.join(QSL(", "))))) {
+    qCriticalNN << LOGSEC_DB << "Failed to load bodies of articles:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+    return false;
+  }
+
+  while (q.next()) {
+    Message& msg = messages[indices.value(q.value(0).toInt())];
+
+    msg.m_contents = q.value(1).toString();
+    msg.m_enclosures = Enclosures::decodeEnclosuresFromString(q.value(2).toString());
+  }
+
+  return true;
+}
+
 QList<Message> DatabaseQueries::getUndeletedMessagesForFeed(const QSqlDatabase& db,
                                                             const QString& feed_custom_id,
                                                             int account_id,
@@ -1387,9 +1543,7 @@ QList<Message> DatabaseQueries::getUndeletedMessagesForFeed(const QSqlDatabase&
                 "FROM Messages "
                 "WHERE is_deleted = 0 AND is_pdeleted = 0 AND "
                 "      feed = :feed AND account_id = :account_id;")
-              .arg(messageTableAttributes(true, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+              .arg(messageTableAttributes(true).values().join(QSL(", "))));
   q.bindValue(QSL(":feed"), feed_custom_id);
   q.bindValue(QSL(":account_id"), account_id);
 
@@ -1426,9 +1580,7 @@ QList<Message> DatabaseQueries::getUndeletedMessagesForBin(const QSqlDatabase& d
   q.prepare(QSL("SELECT %1 "
                 "FROM Messages "
                 "WHERE is_deleted = 1 AND is_pdeleted = 0 AND account_id = :account_id;")
-              .arg(messageTableAttributes(true, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+              .arg(messageTableAttributes(true).values().join(QSL(", "))));
   q.bindValue(QSL(":account_id"), account_id);
 
   if (q.exec()) {
@@ -1462,9 +1614,7 @@ QList<Message> DatabaseQueries::getUndeletedMessagesForAccount(const QSqlDatabas
   q.prepare(QSL("SELECT %1 "
                 "FROM Messages "
                 "WHERE is_deleted = 0 AND is_pdeleted = 0 AND account_id = :account_id;")
-              .arg(messageTableAttributes(true, db.driverName() == QSL(APP_DB_SQLITE_DRIVER))
-                     .values()
-                     .join(QSL(", "))));
+              .arg(messageTableAttributes(true).values().join(QSL(", "))));
   q.bindValue(QSL(":account_id"), account_id);
 
   if (q.exec()) {
@@ -1528,6 +1678,197 @@ QStringList DatabaseQueries::bagOfMessages(const QSqlDatabase& db, ServiceRoot::
   return ids;
 }
 
+bool DatabaseQueries::compressArticleContents(const QSqlDatabase& db, const PurgeReporter& reporter) {
+  QSqlQuery q(db);
+  QString statement;
+
+  // NOTE: Articles are compressed in chunks so that database is not locked for long
+  // and the operation can be cancelled, see purgeMessagesInChunks().
+  if (db.driverName() == QSL(APP_DB_MYSQL_DRIVER)) {
+    statement = QSL("UPDATE Messages SET contents_compressed = COMPRESS(contents), contents = '' "
+                    "WHERE %1 LIMIT %2;");
+  }
+  else {
+    statement = QSL("UPDATE Messages SET contents_compressed = COMPRESS(contents), contents = '' "
+                    "WHERE id IN (SELECT id FROM Messages WHERE %1 LIMIT %2);");
+  }
+
+  q.setForwardOnly(true);
+  q.prepare(statement.arg(QSL("contents_compressed IS NULL AND contents IS NOT NULL AND contents != ''"),
+                          QString::number(APP_DB_PURGE_CHUNK_SIZE)));
+
+  int compressed = 0;
+
+  while (true) {
+    if (!q.exec()) {
+      qCriticalNN << LOGSEC_DB << "Failed to compress contents of articles:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+      return false;
+    }
+
+    const int compressed_now = q.numRowsAffected();
+
+    compressed += qMax(compressed_now, 0);
+
+    if ((reporter && !reporter(compressed)) || compressed_now < APP_DB_PURGE_CHUNK_SIZE) {
+      break;
+    }
+  }
+
+  qDebugNN << LOGSEC_DB << "Compressed contents of" << NONQUOTE_W_SPACE(compressed) << "articles.";
+  return true;
+}
+
+bool DatabaseQueries::fillContentHashes(const QSqlDatabase& db) {
+  // NOTE: Articles without custom ID from feed are stored with their primary ID as custom ID.
+  // Articles without URL are skipped, their hashes contain date only if the date was provided
+  // by the feed, which is not known for stored articles. They are still recognized via their
+  // title and author, see updateMessages().
+  QSqlDatabase database = db;
+  QSqlQuery q(database);
+  QList<QPair<int, QString>> hashes;
+
+  q.setForwardOnly(true);
+
+  if (!q.exec(QSL("SELECT id, url, title FROM Messages "
+                  "WHERE content_hash IS NULL AND custom_id = id AND url IS NOT NULL AND url != '';"))) {
+    qCriticalNN << LOGSEC_DB << "Failed to load articles without hashes:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+    return false;
+  }
+
+  while (q.next()) {
+    Message msg;
+
+    msg.m_url = q.value(1).toString();
+    msg.m_title = q.value(2).toString();
+    hashes.append({q.value(0).toInt(), msg.contentHash()});
+  }
+
+  if (hashes.isEmpty()) {
+    return true;
+  }
+
+  if (!database.transaction()) {
+    qCriticalNN << LOGSEC_DB << "Failed to start transaction for hashes of articles:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    return false;
+  }
+
+  int filled = 0;
+
+  q.prepare(QSL("UPDATE Messages SET content_hash = :content_hash WHERE id = :id;"));
+
+  for (const QPair<int, QString>& hash : std::as_const(hashes)) {
+    q.bindValue(QSL(":content_hash"), hash.second);
+    q.bindValue(QSL(":id"), hash.first);
+
+    // NOTE: Hash of duplicate article is rejected by unique index, such
+    // article stays without hash and is recognized via its title and author.
+    if (q.exec()) {
+      filled++;
+    }
+    else {
+      qWarningNN << LOGSEC_DB << "Failed to store hash of article" << QUOTE_W_SPACE(hash.first)
+                 << "error:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+    }
+  }
+
+  if (!database.commit()) {
+    qCriticalNN << LOGSEC_DB << "Failed to commit hashes of articles:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    database.rollback();
+    return false;
+  }
+
+  qDebugNN << LOGSEC_DB << "Calculated hashes of" << NONQUOTE_W_SPACE(filled) << "of"
+           << NONQUOTE_W_SPACE(hashes.size()) << "stored articles.";
+  return true;
+}
+
+QList<QPair<int, QString>> DatabaseQueries::getArticlesWithoutFullContents(const QSqlDatabase& db,
+                                                                          const Feed* feed,
+                                                                          const QDateTime& dt_to_avoid,
+                                                                          int limit) {
+  QList<QPair<int, QString>> articles;
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT id, url "
+                "FROM Messages "
+                "WHERE "
+                "  account_id = :account_id AND "
+                "  feed = :feed AND "
+                "  is_deleted = 0 AND "
+                "  is_pdeleted = 0 AND "
+                "  full_contents IS NULL AND "
+                "  date_created >= :date_created AND "
+                "  url IS NOT NULL AND url != '' "
+                "ORDER BY date_created DESC "
+                "LIMIT :limit;"));
+  q.bindValue(QSL(":account_id"), feed->getParentServiceRoot()->accountId());
+  q.bindValue(QSL(":feed"), feed->customId());
+  q.bindValue(QSL(":date_created"), dt_to_avoid.isValid() ? dt_to_avoid.toMSecsSinceEpoch() : qint64(0));
+  q.bindValue(QSL(":limit"), limit);
+
+  if (!q.exec()) {
+    qWarningNN << LOGSEC_DB << "Failed to load articles without full contents:"
+               << QUOTE_W_SPACE_DOT(q.lastError().text());
+    return articles;
+  }
+
+  while (q.next()) {
+    articles.append({q.value(0).toInt(), q.value(1).toString()});
+  }
+
+  return articles;
+}
+
+bool DatabaseQueries::storeFullContents(const QSqlDatabase& db, const QHash<int, QString>& contents) {
+  if (contents.isEmpty()) {
+    return true;
+  }
+
+  // NOTE: Compressed contents are stored in separate column, "full_contents" column is empty then.
+  // Empty string is stored instead of NULL, so that the article is not picked for downloading again.
+  const bool compress_contents = qApp->settings()->snapshot()->m_compressArticleContents;
+  QSqlDatabase database = db;
+  QSqlQuery q(database);
+  QSqlQuery q_compressed(database);
+
+  q.prepare(QSL("UPDATE Messages SET full_contents = :full_contents, full_contents_compressed = NULL "
+                "WHERE id = :id;"));
+  q_compressed.prepare(QSL("UPDATE Messages SET full_contents = '', "
+                           "full_contents_compressed = COMPRESS(:full_contents) WHERE id = :id;"));
+
+  if (!database.transaction()) {
+    qCriticalNN << LOGSEC_DB << "Failed to start transaction for full contents of articles:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    return false;
+  }
+
+  for (auto it = contents.cbegin(); it != contents.cend(); it++) {
+    QSqlQuery& query = compress_contents && !it.value().isEmpty() ? q_compressed : q;
+
+    query.bindValue(QSL(":full_contents"), it.value().isNull() ? QSL("") : it.value());
+    query.bindValue(QSL(":id"), it.key());
+
+    if (!query.exec()) {
+      qWarningNN << LOGSEC_DB << "Failed to store full contents of article:"
+                 << QUOTE_W_SPACE_DOT(query.lastError().text());
+      database.rollback();
+      return false;
+    }
+  }
+
+  if (!database.commit()) {
+    qCriticalNN << LOGSEC_DB << "Failed to commit full contents of articles:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    database.rollback();
+    return false;
+  }
+
+  return true;
+}
+
 QHash<QString, QStringList> DatabaseQueries::bagsOfMessages(const QSqlDatabase& db, const QList<Label*>& labels) {
   QHash<QString, QStringList> ids;
   QSqlQuery q(db);
@@ -1555,12 +1896,88 @@ QHash<QString, QStringList> DatabaseQueries::bagsOfMessages(const QSqlDatabase&
   return ids;
 }
 
+QHash<QString, DatabaseQueries::StoredArticle> DatabaseQueries::getArticlesByHashes(const QSqlDatabase& db,
+                                                                                    int account_id,
+                                                                                    const QString& feed_custom_id,
+                                                                                    const QStringList& hashes) {
+  QHash<QString, StoredArticle> articles;
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+
+  // NOTE: Hashes are bound in batches to stay within limits of bound parameters.
+  for (int i = 0; i < hashes.size(); i += 500) {
+    const QStringList batch = hashes.mid(i, 500);
+    QStringList placeholders;
+
+    placeholders.reserve(batch.size());
+
+    for (int j = 0; j < batch.size(); j++) {
+      placeholders.append(QSL(":hash%1").arg(j));
+    }
+
+    q.prepare(QSL("SELECT content_hash, id, date_created, is_read, is_important, %1, feed, title, author "
+                  "FROM Messages "
+                  "WHERE account_id = :account_id AND feed = :feed AND content_hash IN (%2);")
+                .arg(contentsColumn(), placeholders.join(QSL(", "))));
+    q.bindValue(QSL(":account_id"), account_id);
+    q.bindValue(QSL(":feed"), feed_custom_id);
+
+    for (int j = 0; j < batch.size(); j++) {
+      q.bindValue(placeholders.at(j), batch.at(j));
+    }
+
+    if (!q.exec()) {
+      qWarningNN << LOGSEC_DB << "Failed to load articles via their hashes:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+      continue;
+    }
+
+    while (q.next()) {
+      StoredArticle article;
+
+      article.m_id = q.value(1).toInt();
+      article.m_created = q.value(2).value<qint64>();
+      article.m_isRead = q.value(3).toBool();
+      article.m_isImportant = q.value(4).toBool();
+      article.m_contents = q.value(5).toString();
+      article.m_feedId = q.value(6).toString();
+      article.m_title = q.value(7).toString();
+      article.m_author = q.value(8).toString();
+
+      articles.insert(q.value(0).toString(), article);
+    }
+  }
+
+  return articles;
+}
+
+bool DatabaseQueries::hasArticlesWithoutHashes(const QSqlDatabase& db,
+                                               int account_id,
+                                               const QString& feed_custom_id) {
+  // NOTE: Articles without custom ID from feed are stored with their primary ID as custom ID.
+  QSqlQuery& q = preparedQuery(db,
+                               QSL("SELECT 1 FROM Messages "
+                                   "WHERE account_id = :account_id AND feed = :feed AND "
+                                   "      content_hash IS NULL AND custom_id = id "
+                                   "LIMIT 1;"));
+
+  q.bindValue(QSL(":account_id"), account_id);
+  q.bindValue(QSL(":feed"), feed_custom_id);
+
+  const bool has_articles = q.exec() && q.next();
+
+  q.finish();
+  return has_articles;
+}
+
 UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
                                                 QList<Message>& messages,
                                                 Feed* feed,
                                                 bool force_update,
                                                 QMutex* db_mutex,
                                                 bool* ok) {
+  TRACE_SCOPE("db-update-messages", "db");
+
   if (messages.isEmpty()) {
     *ok = true;
     return {};
@@ -1571,53 +1988,94 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
   auto feed_custom_id = feed->customId();
 
   // Prepare queries.
-  QSqlQuery query_select_with_url(db);
-  QSqlQuery query_select_with_custom_id(db);
-  QSqlQuery query_select_with_custom_id_for_feed(db);
-  QSqlQuery query_select_with_id(db);
-  QSqlQuery query_update(db);
-
+  // NOTE: Queries are cached per connection, so they are sent to database
+  // server only once and not with each updated feed.
+  //
   // Here we have query which will check for existence of the "same" message in given feed.
   // The two message are the "same" if:
   //   1) they belong to the SAME FEED AND,
   //   2) they have same URL AND,
   //   3) they have same AUTHOR AND,
   //   4) they have same TITLE.
-  // NOTE: This only applies to messages from standard RSS/ATOM/JSON feeds without ID/GUID.
-  query_select_with_url.setForwardOnly(true);
-  query_select_with_url.prepare(QSL("SELECT id, date_created, is_read, is_important, contents, feed FROM Messages "
-                                    "WHERE feed = :feed AND title = :title AND url = :url AND author = :author AND "
-                                    "account_id = :account_id;"));
+  // NOTE: This only applies to messages from standard RSS/ATOM/JSON feeds without ID/GUID
+  // which were stored before their hashes were calculated.
+  QSqlQuery& query_select_with_url =
+    preparedQuery(db,
+                  QSL("SELECT id, date_created, is_read, is_important, %1, feed FROM Messages "
+                      "WHERE feed = :feed AND title = :title AND url = :url AND author = :author AND "
+                      "account_id = :account_id AND content_hash IS NULL;")
+                    .arg(contentsColumn()));
+
+  // Articles recognized via URL & AUTHOR & TITLE get their hashes, so that
+  // they are recognized via hashes next time.
+  QSqlQuery& query_update_hash =
+    preparedQuery(db, QSL("UPDATE Messages SET content_hash = :content_hash WHERE id = :id;"));
 
   // When we have custom ID of the message which is service-specific (synchronized services).
-  query_select_with_custom_id.setForwardOnly(true);
-  query_select_with_custom_id
-    .prepare(QSL("SELECT id, date_created, is_read, is_important, contents, feed, title, author FROM Messages "
-                 "WHERE custom_id = :custom_id AND account_id = :account_id;"));
+  QSqlQuery& query_select_with_custom_id =
+    preparedQuery(db,
+                  QSL("SELECT id, date_created, is_read, is_important, %1, feed, title, author FROM Messages "
+                      "WHERE custom_id = :custom_id AND account_id = :account_id;")
+                    .arg(contentsColumn()));
 
   // We have custom ID of message, but it is feed-specific not service-specific (standard RSS/ATOM/JSON).
-  query_select_with_custom_id_for_feed.setForwardOnly(true);
-  query_select_with_custom_id_for_feed
-    .prepare(QSL("SELECT id, date_created, is_read, is_important, contents, title, author FROM Messages "
-                 "WHERE feed = :feed AND custom_id = :custom_id AND account_id = :account_id;"));
+  QSqlQuery& query_select_with_custom_id_for_feed =
+    preparedQuery(db,
+                  QSL("SELECT id, date_created, is_read, is_important, %1, title, author FROM Messages "
+                      "WHERE feed = :feed AND custom_id = :custom_id AND account_id = :account_id;")
+                    .arg(contentsColumn()));
 
   // In some case, messages are already stored in the DB and they all have primary DB ID.
   // This is particularly the case when user runs some message filter manually on existing messages
   // of some feed.
-  query_select_with_id.setForwardOnly(true);
-  query_select_with_id
-    .prepare(QSL("SELECT date_created, is_read, is_important, contents, feed, title, author FROM Messages "
-                 "WHERE id = :id AND account_id = :account_id;"));
+  QSqlQuery& query_select_with_id =
+    preparedQuery(db,
+                  QSL("SELECT date_created, is_read, is_important, %1, feed, title, author FROM Messages "
+                      "WHERE id = :id AND account_id = :account_id;")
+                    .arg(contentsColumn()));
+
+  const QSharedPointer<const SettingsSnapshot> settings = qApp->settings()->snapshot();
 
   // Used to update existing messages.
-  query_update.setForwardOnly(true);
-  query_update.prepare(QSL("UPDATE Messages "
-                           "SET title = :title, is_read = :is_read, is_important = :is_important, is_deleted = "
-                           ":is_deleted, url = :url, author = :author, score = :score, date_created = :date_created, "
-                           "contents = :contents, enclosures = :enclosures, feed = :feed "
-                           "WHERE id = :id;"));
+  // NOTE: Compressed contents are stored in separate column, "contents" column is empty then.
+  const bool compress_contents = settings->m_compressArticleContents;
+  const QString contents_values = compress_contents
+                                    ? QSL("contents = '', contents_compressed = COMPRESS(:contents)")
+                                    : QSL("contents = :contents, contents_compressed = NULL");
+  QSqlQuery& query_update =
+    preparedQuery(db,
+                  QSL("UPDATE Messages "
+                      "SET title = :title, is_read = :is_read, is_important = :is_important, is_deleted = "
+                      ":is_deleted, url = :url, author = :author, score = :score, date_created = :date_created, "
+                      "%1, enclosures = :enclosures, has_enclosures = :has_enclosures, "
+                      "feed = :feed "
+                      "WHERE id = :id;")
+                    .arg(contents_values));
+
+  // Articles without custom ID are recognized via their hashes, they are
+  // all looked up at once. Articles which are not found are looked up via
+  // URL & AUTHOR & TITLE only if feed still has articles without hashes.
+  QHash<QString, StoredArticle> stored_by_hash;
+  bool legacy_lookup = false;
+
+  {
+    QMutexLocker lck(db_mutex);
+    QStringList hashes;
+
+    for (const Message& message : std::as_const(messages)) {
+      if (message.m_id <= 0 && message.m_customId.isEmpty() && !message.m_contentHash.isEmpty()) {
+        hashes.append(message.m_contentHash);
+      }
+    }
+
+    if (!hashes.isEmpty()) {
+      stored_by_hash = getArticlesByHashes(db, account_id, feed_custom_id, hashes);
+      legacy_lookup = hasArticlesWithoutHashes(db, account_id, feed_custom_id);
+    }
+  }
 
   QVector<Message*> msgs_to_insert;
+  QVector<Message*> msgs_to_insert_with_hash;
 
   for (Message& message : messages) {
     int id_existing_message = -1;
@@ -1660,10 +2118,26 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
 
       query_select_with_id.finish();
     }
-    else if (message.m_customId.isEmpty()) {
+    else if (message.m_customId.isEmpty() && stored_by_hash.contains(message.m_contentHash)) {
+      // Article without custom ID was recognized via its hash.
+      const StoredArticle& stored = stored_by_hash[message.m_contentHash];
+
+      id_existing_message = stored.m_id;
+      date_existing_message = stored.m_created;
+      is_read_existing_message = stored.m_isRead;
+      is_important_existing_message = stored.m_isImportant;
+      contents_existing_message = stored.m_contents;
+      feed_id_existing_message = stored.m_feedId;
+      title_existing_message = stored.m_title;
+      author_existing_message = stored.m_author;
+
+      qDebugNN << LOGSEC_DB << "Message with hash" << QUOTE_W_SPACE(message.m_contentHash)
+               << "is already present in DB and has DB ID" << QUOTE_W_SPACE_DOT(id_existing_message);
+    }
+    else if (message.m_customId.isEmpty() && (message.m_contentHash.isEmpty() || legacy_lookup)) {
       // We need to recognize existing messages according to URL & AUTHOR & TITLE.
       // NOTE: This concerns articles from RSS/ATOM/JSON which do not
-      // provide unique ID/GUID.
+      // provide unique ID/GUID and do not have hash.
       query_select_with_url.bindValue(QSL(":feed"), unnulifyString(feed_custom_id));
       query_select_with_url.bindValue(QSL(":title"), unnulifyString(message.m_title));
       query_select_with_url.bindValue(QSL(":url"), unnulifyString(message.m_url));
@@ -1693,6 +2167,21 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
       }
 
       query_select_with_url.finish();
+
+      if (id_existing_message >= 0 && !message.m_contentHash.isEmpty()) {
+        query_update_hash.bindValue(QSL(":content_hash"), message.m_contentHash);
+        query_update_hash.bindValue(QSL(":id"), id_existing_message);
+
+        if (!query_update_hash.exec()) {
+          qWarningNN << LOGSEC_DB << "Failed to store hash of article" << QUOTE_W_SPACE(id_existing_message)
+                     << "error:" << QUOTE_W_SPACE_DOT(query_update_hash.lastError().text());
+        }
+
+        query_update_hash.finish();
+      }
+    }
+    else if (message.m_customId.isEmpty()) {
+      qDebugNN << LOGSEC_DB << "Message with hash" << QUOTE_W_SPACE(message.m_contentHash) << "is not present in DB.";
     }
     else {
       // We can recognize existing messages via their custom ID.
@@ -1779,8 +2268,7 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
       //   4) FOR ALL SERVICES:
       //        Message update is forced, we want to overwrite message as some arbitrary atribute was changed,
       //        this particularly happens when manual message filter execution happens.
-      bool ignore_contents_changes =
-        qApp->settings()->value(GROUP(Messages), SETTING(Messages::IgnoreContentsChanges)).toBool();
+      bool ignore_contents_changes = settings->m_ignoreContentsChanges;
       bool cond_1 =
         !message.m_customId.isEmpty() && feed->getParentServiceRoot()->isSyncable() &&
         (message.m_created.toMSecsSinceEpoch() != date_existing_message ||
@@ -1816,6 +2304,7 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
         query_update.bindValue(QSL(":date_created"), message.m_created.toMSecsSinceEpoch());
         query_update.bindValue(QSL(":contents"), unnulifyString(message.m_contents));
         query_update.bindValue(QSL(":enclosures"), Enclosures::encodeEnclosuresToString(message.m_enclosures));
+        query_update.bindValue(QSL(":has_enclosures"), int(!message.m_enclosures.isEmpty()));
         query_update.bindValue(QSL(":feed"), message.m_feedId);
         query_update.bindValue(QSL(":score"), message.m_score);
         query_update.bindValue(QSL(":id"), id_existing_message);
@@ -1824,6 +2313,8 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
           qDebugNN << LOGSEC_DB << "Overwriting message with title" << QUOTE_W_SPACE(message.m_title) << "URL"
                    << QUOTE_W_SPACE(message.m_url) << "in DB.";
 
+          message.m_id = id_existing_message;
+
           if (!message.m_isRead) {
             updated_messages.m_unread.append(message);
           }
@@ -1839,15 +2330,103 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
         query_update.finish();
       }
     }
+    else if (message.m_customId.isEmpty() && !message.m_contentHash.isEmpty()) {
+      msgs_to_insert_with_hash.append(&message);
+    }
     else {
       msgs_to_insert.append(&message);
     }
   }
 
+  if (!msgs_to_insert_with_hash.isEmpty()) {
+    // NOTE: Articles with hashes are inserted one by one and article whose hash collides
+    // with hash of already stored article is skipped, instead of failing whole bulk insert.
+    const QString insert_with_hash =
+      QSL("%1 INTO Messages "
+          "(feed, title, is_read, is_important, is_deleted, url, author, score, date_created, "
+          "contents, contents_compressed, enclosures, has_enclosures, custom_id, custom_hash, content_hash, "
+          "account_id) "
+          "VALUES (:feed, :title, :is_read, :is_important, :is_deleted, :url, :author, :score, :date_created, "
+          "%2, :enclosures, :has_enclosures, '', :custom_hash, :content_hash, :account_id)%3;");
+    const bool is_mysql = qApp->database()->activeDatabaseDriver() == DatabaseDriver::DriverType::MySQL;
+    QSqlQuery& query_insert_with_hash =
+      preparedQuery(db,
+                    insert_with_hash.arg(is_mysql ? QSL("INSERT") : QSL("INSERT OR IGNORE"),
+                                         compress_contents ? QSL("'', COMPRESS(:contents)") : QSL(":contents, NULL"),
+                                         is_mysql ? QSL(" ON DUPLICATE KEY UPDATE id = id") : QString()));
+    QStringList ids_without_custom_id;
+    QMutexLocker lck(db_mutex);
+
+    for (Message* msg : std::as_const(msgs_to_insert_with_hash)) {
+      if (msg->m_title.isEmpty()) {
+        qCriticalNN << LOGSEC_DB << "Message" << QUOTE_W_SPACE(msg->m_contentHash)
+                    << "will not be inserted to DB because it does not meet DB constraints.";
+        continue;
+      }
+
+      query_insert_with_hash.bindValue(QSL(":feed"), unnulifyString(feed_custom_id));
+      query_insert_with_hash.bindValue(QSL(":title"), unnulifyString(msg->m_title));
+      query_insert_with_hash.bindValue(QSL(":is_read"), int(msg->m_isRead));
+      query_insert_with_hash.bindValue(QSL(":is_important"), int(msg->m_isImportant));
+      query_insert_with_hash.bindValue(QSL(":is_deleted"), int(msg->m_isDeleted));
+      query_insert_with_hash.bindValue(QSL(":url"), unnulifyString(msg->m_url));
+      query_insert_with_hash.bindValue(QSL(":author"), unnulifyString(msg->m_author));
+      query_insert_with_hash.bindValue(QSL(":score"), msg->m_score);
+      query_insert_with_hash.bindValue(QSL(":date_created"), msg->m_created.toMSecsSinceEpoch());
+      query_insert_with_hash.bindValue(QSL(":contents"), unnulifyString(msg->m_contents));
+      query_insert_with_hash.bindValue(QSL(":enclosures"), Enclosures::encodeEnclosuresToString(msg->m_enclosures));
+      query_insert_with_hash.bindValue(QSL(":has_enclosures"), int(!msg->m_enclosures.isEmpty()));
+      query_insert_with_hash.bindValue(QSL(":custom_hash"), unnulifyString(msg->m_customHash));
+      query_insert_with_hash.bindValue(QSL(":content_hash"), msg->m_contentHash);
+      query_insert_with_hash.bindValue(QSL(":account_id"), account_id);
+
+      if (!query_insert_with_hash.exec()) {
+        qCriticalNN << LOGSEC_DB << "Failed to insert article" << QUOTE_W_SPACE(msg->m_title)
+                    << "to DB:" << QUOTE_W_SPACE_DOT(query_insert_with_hash.lastError().text());
+      }
+      else if (query_insert_with_hash.numRowsAffected() <= 0) {
+        qWarningNN << LOGSEC_DB << "Article" << QUOTE_W_SPACE(msg->m_title)
+                   << "was not inserted to DB, because article with the same hash is already stored.";
+      }
+      else {
+        msg->m_insertedUpdated = true;
+        msg->m_id = query_insert_with_hash.lastInsertId().toInt();
+
+        // Article does not have custom ID, we use its primary ID,
+        // just to keep the data consistent.
+        msg->m_customId = QString::number(msg->m_id);
+        ids_without_custom_id.append(msg->m_customId);
+
+        if (!msg->m_isRead) {
+          updated_messages.m_unread.append(*msg);
+        }
+
+        updated_messages.m_all.append(*msg);
+      }
+
+      query_insert_with_hash.finish();
+    }
+
+    if (!ids_without_custom_id.isEmpty()) {
+      QSqlQuery fixup_custom_ids_query(QSL("UPDATE Messages "
+                                           "SET custom_id = id "
+                                           "WHERE id IN (%1);")
+                                         .arg(ids_without_custom_id.join(QSL(", "))),
+                                       db);
+      QSqlError fixup_custom_ids_error = fixup_custom_ids_query.lastError();
+
+      if (fixup_custom_ids_error.isValid()) {
+        qCriticalNN << LOGSEC_DB << "Failed to set custom ID for inserted messages:"
+                    << QUOTE_W_SPACE_DOT(fixup_custom_ids_error.text());
+      }
+    }
+  }
+
   if (!msgs_to_insert.isEmpty()) {
     QString bulk_insert = QSL("INSERT INTO Messages "
                               "(feed, title, is_read, is_important, is_deleted, url, author, score, date_created, "
-                              "contents, enclosures, custom_id, custom_hash, account_id) "
+                              "contents, contents_compressed, enclosures, has_enclosures, custom_id, custom_hash, "
+                              "account_id) "
                               "VALUES %1;");
 
     for (int i = 0; i < msgs_to_insert.size(); i += 1000) {
@@ -1865,8 +2444,9 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
         }
 
         vals.append(QSL("\n(':feed', ':title', :is_read, :is_important, :is_deleted, "
-                        "':url', ':author', :score, :date_created, ':contents', ':enclosures', "
+                        "':url', ':author', :score, :date_created, %1, ':enclosures', :has_enclosures, "
                         "':custom_id', ':custom_hash', :account_id)")
+                      .arg(compress_contents ? QSL("'', COMPRESS(':contents')") : QSL("':contents', NULL"))
                       .replace(QSL(":feed"), unnulifyString(feed_custom_id))
                       .replace(QSL(":title"), DatabaseFactory::escapeQuery(unnulifyString(msg->m_title)))
                       .replace(QSL(":is_read"), QString::number(int(msg->m_isRead)))
@@ -1878,6 +2458,7 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
                       .replace(QSL(":contents"), DatabaseFactory::escapeQuery(unnulifyString(msg->m_contents)))
                       .replace(QSL(":enclosures"),
                                DatabaseFactory::escapeQuery(Enclosures::encodeEnclosuresToString(msg->m_enclosures)))
+                      .replace(QSL(":has_enclosures"), QString::number(int(!msg->m_enclosures.isEmpty())))
                       .replace(QSL(":custom_id"), DatabaseFactory::escapeQuery(unnulifyString(msg->m_customId)))
                       .replace(QSL(":custom_hash"), unnulifyString(msg->m_customHash))
                       .replace(QSL(":score"), QString::number(msg->m_score))
@@ -1905,6 +2486,7 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
           //   https://www.sqlite.org/autoinc.html
           //   https://mariadb.com/kb/en/auto_increment
           int last_msg_id = bulk_query.lastInsertId().toInt();
+          QStringList ids_without_custom_id;
 
           for (int l = i, c = 1; l < (i + batch_length); l++, c++) {
             Message* msg = msgs_to_insert[l];
@@ -1919,12 +2501,33 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
             msg->m_insertedUpdated = true;
             msg->m_id = last_msg_id - batch_length + c;
 
+            if (msg->m_customId.isEmpty()) {
+              // Article does not have custom ID, we use its primary ID,
+              // just to keep the data consistent.
+              msg->m_customId = QString::number(msg->m_id);
+              ids_without_custom_id.append(msg->m_customId);
+            }
+
             if (!msg->m_isRead) {
               updated_messages.m_unread.append(*msg);
             }
 
             updated_messages.m_all.append(*msg);
           }
+
+          if (!ids_without_custom_id.isEmpty()) {
+            QSqlQuery fixup_custom_ids_query(QSL("UPDATE Messages "
+                                                 "SET custom_id = id "
+                                                 "WHERE id IN (%1);")
+                                               .arg(ids_without_custom_id.join(QSL(", "))),
+                                             db);
+            QSqlError fixup_custom_ids_error = fixup_custom_ids_query.lastError();
+
+            if (fixup_custom_ids_error.isValid()) {
+              qCriticalNN << LOGSEC_DB << "Failed to set custom ID for inserted messages:"
+                          << QUOTE_W_SPACE_DOT(fixup_custom_ids_error.text());
+            }
+          }
         }
       }
     }
@@ -1933,17 +2536,18 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
   const bool uses_online_labels = Globals::hasFlag(feed->getParentServiceRoot()->supportedLabelOperations(),
                                                    ServiceRoot::LabelOperation::Synchronised);
 
+  if (uses_online_labels) {
+    QMutexLocker lck(db_mutex);
+
+    // Store all labels obtained from server.
+    setLabelsForMessages(db, messages, account_id);
+  }
+
   for (Message& message : messages) {
     if (!message.m_customId.isEmpty() || message.m_id > 0) {
       QMutexLocker lck(db_mutex);
       // bool lbls_changed = false;
 
-      if (uses_online_labels) {
-        // Store all labels obtained from server.
-        setLabelsForMessage(db, message.m_assignedLabels, message);
-        // lbls_changed = true;
-      }
-
       // Adjust labels tweaked by filters.
       for (Label* assigned_by_filter : message.m_assignedLabelsByFilter) {
         assigned_by_filter->assignToMessage(message, false);
@@ -1980,20 +2584,7 @@ UpdatedArticles DatabaseQueries::updateMessages(const QSqlDatabase& db,
     }
   }
 
-  // Now, fixup custom IDS for messages which initially did not have them,
-  // just to keep the data consistent.
-  QMutexLocker lck(db_mutex);
-
-  QSqlQuery fixup_custom_ids_query(QSL("UPDATE Messages "
-                                       "SET custom_id = id "
-                                       "WHERE custom_id IS NULL OR custom_id = '';"),
-                                   db);
-  QSqlError fixup_custom_ids_error = fixup_custom_ids_query.lastError();
-
-  if (fixup_custom_ids_error.isValid()) {
-    qCriticalNN << LOGSEC_DB
-                << "Failed to set custom ID for all messages:" << QUOTE_W_SPACE_DOT(fixup_custom_ids_error.text());
-  }
+  TRACE_COUNTER("db-rows-written", updated_messages.m_all.size());
 
   if (ok != nullptr) {
     *ok = true;
@@ -2131,7 +2722,8 @@ void DatabaseQueries::cleanProbedMessages(const QSqlDatabase& db, bool clean_rea
                   "  is_pdeleted = 0 AND "
                   "  is_read = 1 AND "
                   "  account_id = :account_id AND "
-                  "  (title REGEXP :fltr OR contents REGEXP :fltr);"));
+                  "  (title REGEXP :fltr OR %1 REGEXP :fltr);")
+                .arg(contentsColumn()));
   }
   else {
     q.prepare(QSL("UPDATE Messages SET is_deleted = :deleted "
@@ -2139,7 +2731,8 @@ void DatabaseQueries::cleanProbedMessages(const QSqlDatabase& db, bool clean_rea
                   "  is_deleted = 0 AND "
                   "  is_pdeleted = 0 AND "
                   "  account_id = :account_id AND "
-                  "  (title REGEXP :fltr OR contents REGEXP :fltr);"));
+                  "  (title REGEXP :fltr OR %1 REGEXP :fltr);")
+                .arg(contentsColumn()));
   }
 
   q.bindValue(QSL(":deleted"), 1);
@@ -2356,7 +2949,8 @@ void DatabaseQueries::markProbeReadUnread(const QSqlDatabase& db, Search* probe,
                 "    is_deleted = 0 AND "
                 "    is_pdeleted = 0 AND "
                 "    account_id = :account_id AND "
-                "    (title REGEXP :fltr OR contents REGEXP :fltr);"));
+                "    (title REGEXP :fltr OR %1 REGEXP :fltr);")
+              .arg(contentsColumn()));
   q.bindValue(QSL(":read"), read == RootItem::ReadStatus::Read ? 1 : 0);
   q.bindValue(QSL(":account_id"), probe->getParentServiceRoot()->accountId());
   q.bindValue(QSL(":fltr"), probe->filter());
@@ -2379,7 +2973,8 @@ QStringList DatabaseQueries::customIdsOfMessagesFromProbe(const QSqlDatabase& db
                 "    is_deleted = 0 AND "
                 "    is_pdeleted = 0 AND "
                 "    account_id = :account_id AND "
-                "    (title REGEXP :fltr OR contents REGEXP :fltr);"));
+                "    (title REGEXP :fltr OR %1 REGEXP :fltr);")
+              .arg(contentsColumn()));
   q.bindValue(QSL(":account_id"), probe->getParentServiceRoot()->accountId());
   q.bindValue(QSL(":read"), target_read == RootItem::ReadStatus::Read ? 0 : 1);
   q.bindValue(QSL(":fltr"), probe->filter());
@@ -2563,7 +3158,7 @@ void DatabaseQueries::createOverwriteCategory(const QSqlDatabase& db,
   q.bindValue(QSL(":title"), category->title());
   q.bindValue(QSL(":description"), category->description());
   q.bindValue(QSL(":date_created"), category->creationDate().toMSecsSinceEpoch());
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(category->icon()));
+  q.bindValue(QSL(":icon"), storeIcon(db, category));
   q.bindValue(QSL(":account_id"), account_id);
   q.bindValue(QSL(":custom_id"), category->customId());
   q.bindValue(QSL(":id"), category->id());
@@ -2574,6 +3169,147 @@ void DatabaseQueries::createOverwriteCategory(const QSqlDatabase& db,
   }
 }
 
+QHash<QString, QByteArray> DatabaseQueries::getAllIconData(const QSqlDatabase& db) {
+  QHash<QString, QByteArray> icons;
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+
+  if (!q.exec(QSL("SELECT hash, data FROM Icons;"))) {
+    qCriticalNN << LOGSEC_DB << "Failed to load icon store:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+    return icons;
+  }
+
+  while (q.next()) {
+    icons.insert(q.value(0).toString(), q.value(1).toByteArray());
+  }
+
+  return icons;
+}
+
+bool DatabaseQueries::storeIconData(const QSqlDatabase& db, const QString& key, const QByteArray& raw_data) {
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT COUNT(*) FROM Icons WHERE hash = :hash;"));
+  q.bindValue(QSL(":hash"), key);
+
+  if (q.exec() && q.next() && q.value(0).toInt() > 0) {
+    // Same icon is already used by some other item.
+    return true;
+  }
+
+  q.prepare(QSL("INSERT INTO Icons (hash, data) VALUES (:hash, :data);"));
+  q.bindValue(QSL(":hash"), key);
+  q.bindValue(QSL(":data"), raw_data);
+
+  if (!q.exec()) {
+    qCriticalNN << LOGSEC_DB << "Failed to store icon" << QUOTE_W_SPACE(key)
+                << "with error:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+    return false;
+  }
+
+  return true;
+}
+
+QString DatabaseQueries::storeIcon(const QSqlDatabase& db, RootItem* item) {
+  if (!item->iconKey().isEmpty()) {
+    // Icon was loaded from icon store and did not change since.
+    return item->iconKey();
+  }
+
+  QByteArray raw_data = IconFactory::toRawData(item->icon());
+
+  if (raw_data.isEmpty()) {
+    return {};
+  }
+
+  QString key = IconFactory::storeKey(raw_data);
+
+  if (!storeIconData(db, key, raw_data)) {
+    throw ApplicationException(QObject::tr("Cannot store icon."));
+  }
+
+  qApp->icons()->addStoredIcon(key, raw_data);
+
+  // Item does not need to keep decoded icon anymore.
+  item->setIconKey(key);
+  return key;
+}
+
+void DatabaseQueries::moveLegacyIconsToStore(const QSqlDatabase& db) {
+  const QStringList tables = {QSL("Feeds"), QSL("Categories")};
+
+  for (const QString& table : tables) {
+    QSqlQuery q(db);
+    QHash<int, QByteArray> legacy_icons;
+
+    q.setForwardOnly(true);
+
+    if (!q.exec(QSL("SELECT id, icon FROM %1 WHERE icon IS NOT NULL;").arg(table))) {
+      qCriticalNN << LOGSEC_DB << "Failed to look for icons in older format in table" << QUOTE_W_SPACE(table)
+                  << "with error:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+      continue;
+    }
+
+    while (q.next()) {
+      const QByteArray value = q.value(1).toByteArray();
+
+      if (!value.isEmpty() && !IconFactory::isStoreKey(value)) {
+        legacy_icons.insert(q.value(0).toInt(), QByteArray::fromBase64(value));
+      }
+    }
+
+    if (legacy_icons.isEmpty()) {
+      continue;
+    }
+
+    q.prepare(QSL("UPDATE %1 SET icon = :icon WHERE id = :id;").arg(table));
+
+    for (auto it = legacy_icons.cbegin(); it != legacy_icons.cend(); it++) {
+      QString key = IconFactory::storeKey(it.value());
+
+      if (!storeIconData(db, key, it.value())) {
+        continue;
+      }
+
+      q.bindValue(QSL(":icon"), key);
+      q.bindValue(QSL(":id"), it.key());
+
+      if (!q.exec()) {
+        qWarningNN << LOGSEC_DB << "Failed to move icon of item" << QUOTE_W_SPACE(it.key())
+                   << "to icon store:" << QUOTE_W_SPACE_DOT(q.lastError().text());
+      }
+    }
+
+    qDebugNN << LOGSEC_DB << "Moved" << NONQUOTE_W_SPACE(legacy_icons.size()) << "icons from table"
+             << QUOTE_W_SPACE(table) << "to icon store.";
+  }
+}
+
+QString DatabaseQueries::iconKeyFromDatabase(const QByteArray& value) {
+  if (IconFactory::isStoreKey(value)) {
+    return QString::fromLatin1(value);
+  }
+
+  if (!value.isEmpty()) {
+    // NOTE: Icons in older format are moved to icon store at startup,
+    // loaders of accounts only read the database.
+    qWarningNN << LOGSEC_DB << "Icon was not moved to icon store, it will not be displayed.";
+  }
+
+  return {};
+}
+
+bool DatabaseQueries::purgeUnusedIcons(const QSqlDatabase& db) {
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+  return q.exec(QSL("DELETE FROM Icons WHERE "
+                    "hash NOT IN (SELECT icon FROM Feeds WHERE icon IS NOT NULL) AND "
+                    "hash NOT IN (SELECT icon FROM Categories WHERE icon IS NOT NULL);"));
+}
+
 void DatabaseQueries::createOverwriteFeed(const QSqlDatabase& db, Feed* feed, int account_id, int new_parent_id) {
   QSqlQuery q(db);
   int next_sort_order;
@@ -2656,7 +3392,7 @@ void DatabaseQueries::createOverwriteFeed(const QSqlDatabase& db, Feed* feed, in
   q.bindValue(QSL(":title"), feed->title());
   q.bindValue(QSL(":description"), feed->description());
   q.bindValue(QSL(":date_created"), feed->creationDate().toMSecsSinceEpoch());
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(feed->icon()));
+  q.bindValue(QSL(":icon"), storeIcon(db, feed));
   q.bindValue(QSL(":category"), new_parent_id);
   q.bindValue(QSL(":source"), feed->source());
   q.bindValue(QSL(":update_type"), int(feed->autoUpdateType()));
@@ -2694,6 +3430,18 @@ void DatabaseQueries::createOverwriteFeed(const QSqlDatabase& db, Feed* feed, in
   }
 }
 
+void DatabaseQueries::storeFeedCustomData(const QSqlDatabase& db, Feed* feed) {
+  QSqlQuery q(db);
+
+  q.prepare(QSL("UPDATE Feeds SET custom_data = :custom_data WHERE id = :id;"));
+  q.bindValue(QSL(":custom_data"), serializeCustomData(feed->customDatabaseData()));
+  q.bindValue(QSL(":id"), feed->id());
+
+  if (!q.exec()) {
+    throw ApplicationException(q.lastError().text());
+  }
+}
+
 void DatabaseQueries::createOverwriteAccount(const QSqlDatabase& db, ServiceRoot* account) {
   QSqlQuery q(db);
 
@@ -3174,6 +3922,10 @@ bool DatabaseQueries::storeNewOauthTokens(const QSqlDatabase& db, const QString&
   }
 }
 
+QSqlQuery& DatabaseQueries::preparedQuery(const QSqlDatabase& db, const QString& statement) {
+  return qApp->database()->driver()->preparedQuery(db, statement);
+}
+
 QString DatabaseQueries::unnulifyString(const QString& str) {
   return str.isNull() ? QSL("") : str;
 }
@@ -20,9 +20,20 @@
 #include <QSqlError>
 #include <QSqlQuery>
 
+#include <functional>
+
 class RSSGUARD_DLLSPEC DatabaseQueries {
   public:
-    static QMap<int, QString> messageTableAttributes(bool only_msg_table, bool is_sqlite);
+    using PurgeReporter = std::function<bool(int)>;
+
+    static QMap<int, QString> messageTableAttributes(bool only_msg_table, bool with_bodies = true);
+
+    // Returns SQL expression which yields contents of articles, compressed contents are decompressed.
+    static QString contentsColumn();
+
+    // Returns SQL expression which yields extracted contents of linked pages of articles,
+    // falls back to contents of articles if linked pages were not downloaded.
+    static QString fullContentsColumn();
 
     // Custom data serializers.
     static QString serializeCustomData(const QVariantHash& data);
@@ -33,6 +44,10 @@ class RSSGUARD_DLLSPEC DatabaseQueries {
     static bool deassignLabelFromMessage(const QSqlDatabase& db, Label* label, const Message& msg);
     static bool assignLabelToMessage(const QSqlDatabase& db, Label* label, const Message& msg);
     static bool setLabelsForMessage(const QSqlDatabase& db, const QList<Label*>& labels, const Message& msg);
+
+    // Stores assigned labels of all given articles, articles with the same
+    // labels are updated together with a single statement.
+    static bool setLabelsForMessages(const QSqlDatabase& db, const QList<Message>& messages, int account_id);
     static QList<Label*> getLabelsForAccount(const QSqlDatabase& db, int account_id);
     static QList<Label*> getLabelsForMessage(const QSqlDatabase& db,
                                              const Message& msg,
@@ -71,16 +86,23 @@ class RSSGUARD_DLLSPEC DatabaseQueries {
     static bool restoreBin(const QSqlDatabase& db, int account_id);
 
     // Purge database.
-    static bool removeUnwantedArticlesFromFeed(const QSqlDatabase& db,
-                                               const Feed* feed,
-                                               const Feed::ArticleIgnoreLimit& feed_setup,
-                                               const Feed::ArticleIgnoreLimit& app_setup);
+    // Applies article limits of all feeds of given accounts at once and returns count of
+    // recycled/purged articles. Feeds without customized limits use application setup.
+    static int removeUnwantedArticles(const QSqlDatabase& db,
+                                      const QList<int>& account_ids,
+                                      const Feed::ArticleIgnoreLimit& app_setup);
 
     static bool purgeMessage(const QSqlDatabase& db, int message_id);
-    static bool purgeImportantMessages(const QSqlDatabase& db);
-    static bool purgeReadMessages(const QSqlDatabase& db);
-    static bool purgeOldMessages(const QSqlDatabase& db, int older_than_days);
-    static bool purgeRecycleBin(const QSqlDatabase& db);
+    static bool purgeMessages(const QSqlDatabase& db, const QStringList& ids);
+
+    // Functions below remove articles in chunks, so that database is not locked for long time.
+    // Reporter is called after each chunk with count of already removed articles
+    // and purging stops once it returns false.
+    static bool purgeImportantMessages(const QSqlDatabase& db, const PurgeReporter& reporter = {});
+    static bool purgeReadMessages(const QSqlDatabase& db, const PurgeReporter& reporter = {});
+    static bool purgeOldMessages(const QSqlDatabase& db, int older_than_days, const PurgeReporter& reporter = {});
+    static bool purgeRecycleBin(const QSqlDatabase& db, const PurgeReporter& reporter = {});
+
     static bool purgeMessagesFromBin(const QSqlDatabase& db, bool clear_only_read, int account_id);
     static bool purgeLeftoverMessages(const QSqlDatabase& db, int account_id);
 
@@ -137,6 +159,28 @@ class RSSGUARD_DLLSPEC DatabaseQueries {
                                            int row_offset,
                                            int row_limit);
 
+    // Loads contents and enclosures of given messages (which are recognized by their IDs).
+    static bool fillMessageBodies(const QSqlDatabase& db, QList<Message>& messages);
+
+    // Compresses contents of all articles which are stored uncompressed. Articles are
+    // compressed in chunks, reporter gets total count of compressed articles after each chunk.
+    static bool compressArticleContents(const QSqlDatabase& db, const PurgeReporter& reporter = {});
+
+    // Calculates hashes of stored articles without custom ID, which were stored before
+    // hashes were introduced. Called once when database schema is updated.
+    static bool fillContentHashes(const QSqlDatabase& db);
+
+    // Returns IDs and URLs of newest articles of given feed whose linked pages were not downloaded yet.
+    // Articles created before "dt_to_avoid" are skipped if it is valid.
+    static QList<QPair<int, QString>> getArticlesWithoutFullContents(const QSqlDatabase& db,
+                                                                     const Feed* feed,
+                                                                     const QDateTime& dt_to_avoid,
+                                                                     int limit);
+
+    // Stores extracted contents of linked pages of articles, which are recognized by their IDs.
+    // All contents are stored in single transaction, they are compressed if enabled in settings.
+    static bool storeFullContents(const QSqlDatabase& db, const QHash<int, QString>& contents);
+
     // Custom ID accumulators.
     static QStringList bagOfMessages(const QSqlDatabase& db, ServiceRoot::BagOfMessages bag, const Feed* feed);
     static QHash<QString, QStringList> bagsOfMessages(const QSqlDatabase& db, const QList<Label*>& labels);
@@ -170,8 +214,14 @@ class RSSGUARD_DLLSPEC DatabaseQueries {
     template <typename T>
     static QList<ServiceRoot*> getAccounts(const QSqlDatabase& db, const QString& code, bool* ok = nullptr);
 
+    // Switches connection to (or back from) mode in which database refuses any writes.
+    static void setConnectionReadOnly(const QSqlDatabase& db, bool read_only);
+
+    // Reads categories and feeds of the account. Can be called from
+    // worker thread, created items live in the calling thread.
+    // NOTE: This never writes to database.
     template <typename Categ, typename Fee>
-    static void loadRootFromDatabase(ServiceRoot* root);
+    static AccountStructure getAccountStructure(const QSqlDatabase& db, int account_id);
     static bool storeNewOauthTokens(const QSqlDatabase& db, const QString& refresh_token, int account_id);
     static void createOverwriteAccount(const QSqlDatabase& db, ServiceRoot* account);
 
@@ -194,6 +244,20 @@ class RSSGUARD_DLLSPEC DatabaseQueries {
     static bool cleanFeeds(const QSqlDatabase& db, const QStringList& ids, bool clean_read_only, int account_id);
     static void storeAccountTree(const QSqlDatabase& db, RootItem* tree_root, int account_id);
     static void createOverwriteFeed(const QSqlDatabase& db, Feed* feed, int account_id, int new_parent_id);
+
+    // Stores only custom data of existing feed, for data which change with each feed update.
+    static void storeFeedCustomData(const QSqlDatabase& db, Feed* feed);
+
+    // Icon store.
+    static QHash<QString, QByteArray> getAllIconData(const QSqlDatabase& db);
+    static bool storeIconData(const QSqlDatabase& db, const QString& key, const QByteArray& raw_data);
+    static QString storeIcon(const QSqlDatabase& db, RootItem* item);
+    static bool purgeUnusedIcons(const QSqlDatabase& db);
+
+    // Moves icons stored in rows of feeds/categories in older Base64 format
+    // to icon store. Called once at startup, before accounts are loaded.
+    static void moveLegacyIconsToStore(const QSqlDatabase& db);
+    static QString iconKeyFromDatabase(const QByteArray& value);
     static void createOverwriteCategory(const QSqlDatabase& db, Category* category, int account_id, int new_parent_id);
     static bool deleteFeed(const QSqlDatabase& db, Feed* feed, int account_id);
     static bool deleteCategory(const QSqlDatabase& db, Category* category);
@@ -233,8 +297,39 @@ class RSSGUARD_DLLSPEC DatabaseQueries {
     static QStringList getAllGmailRecipients(const QSqlDatabase& db, int account_id);
 
   private:
+    // Attributes of stored article, which are needed to decide whether article should be updated.
+    struct StoredArticle {
+        int m_id;
+        qint64 m_created;
+        bool m_isRead;
+        bool m_isImportant;
+        QString m_contents;
+        QString m_feedId;
+        QString m_title;
+        QString m_author;
+    };
+
+    static QHash<QString, StoredArticle> getArticlesByHashes(const QSqlDatabase& db,
+                                                             int account_id,
+                                                             const QString& feed_custom_id,
+                                                             const QStringList& hashes);
+
+    // Returns true if feed has articles without custom ID, which were stored before hashes were introduced.
+    static bool hasArticlesWithoutHashes(const QSqlDatabase& db, int account_id, const QString& feed_custom_id);
     static QString unnulifyString(const QString& str);
 
+    // Returns subquery with stamps of oldest kept articles of feeds with given retention policy.
+    static QString articleRetentionStamps(const QString& account_ids, bool recycle_dont_purge);
+
+    // Removes articles matching given SQL condition in chunks, each chunk in its own transaction.
+    static bool purgeMessagesInChunks(const QSqlDatabase& db,
+                                      const QString& condition,
+                                      const QVariantMap& bindings,
+                                      const PurgeReporter& reporter);
+
+    // Returns query prepared for given connection, which is cached by database driver.
+    static QSqlQuery& preparedQuery(const QSqlDatabase& db, const QString& statement);
+
     explicit DatabaseQueries() = default;
 };
 
@@ -323,7 +418,7 @@ Assignment DatabaseQueries::getCategories(const QSqlDatabase& db, int account_id
     cat->setTitle(query_categories.value(CAT_DB_TITLE_INDEX).toString());
     cat->setDescription(query_categories.value(CAT_DB_DESCRIPTION_INDEX).toString());
     cat->setCreationDate(TextFactory::parseDateTime(query_categories.value(CAT_DB_DCREATED_INDEX).value<qint64>()));
-    cat->setIcon(qApp->icons()->fromByteArray(query_categories.value(CAT_DB_ICON_INDEX).toByteArray()));
+    cat->setIconKey(iconKeyFromDatabase(query_categories.value(CAT_DB_ICON_INDEX).toByteArray()));
 
     categories << pair;
   }
@@ -379,7 +474,7 @@ Assignment DatabaseQueries::getFeeds(const QSqlDatabase& db,
 
     feed->setDescription(QString::fromUtf8(query.value(FDS_DB_DESCRIPTION_INDEX).toByteArray()));
     feed->setCreationDate(TextFactory::parseDateTime(query.value(FDS_DB_DCREATED_INDEX).value<qint64>()));
-    feed->setIcon(qApp->icons()->fromByteArray(query.value(FDS_DB_ICON_INDEX).toByteArray()));
+    feed->setIconKey(iconKeyFromDatabase(query.value(FDS_DB_ICON_INDEX).toByteArray()));
     feed->setAutoUpdateType(static_cast<Feed::AutoUpdateType>(query.value(FDS_DB_UPDATE_TYPE_INDEX).toInt()));
     feed->setAutoUpdateInterval(query.value(FDS_DB_UPDATE_INTERVAL_INDEX).toInt());
     feed->setIsSwitchedOff(query.value(FDS_DB_IS_OFF_INDEX).toBool());
@@ -432,14 +527,13 @@ Assignment DatabaseQueries::getFeeds(const QSqlDatabase& db,
 }
 
 template <typename Categ, typename Fee>
-void DatabaseQueries::loadRootFromDatabase(ServiceRoot* root) {
-  QSqlDatabase database = qApp->database()->driver()->connection(root->metaObject()->className());
-  Assignment categories = DatabaseQueries::getCategories<Categ>(database, root->accountId());
-  Assignment feeds = DatabaseQueries::getFeeds<Fee>(database, qApp->feedReader()->messageFilters(), root->accountId());
-  auto labels = DatabaseQueries::getLabelsForAccount(database, root->accountId());
-  auto probes = DatabaseQueries::getProbesForAccount(database, root->accountId());
-
-  root->performInitialAssembly(categories, feeds, labels, probes);
+AccountStructure DatabaseQueries::getAccountStructure(const QSqlDatabase& db, int account_id) {
+  AccountStructure structure;
+
+  structure.m_categories = DatabaseQueries::getCategories<Categ>(db, account_id);
+  structure.m_feeds = DatabaseQueries::getFeeds<Fee>(db, qApp->feedReader()->messageFilters(), account_id);
+
+  return structure;
 }
 
 #endif // DATABASEQUERIES_H
@@ -103,7 +103,7 @@ DatabaseDriver::DriverType MariaDbDriver::driverType() const {
 }
 
 bool MariaDbDriver::vacuumDatabase() {
-  QSqlDatabase database = connection(objectName());
+  QSqlDatabase database = threadSafeConnection(objectName());
   QSqlQuery query_vacuum(database);
 
   return query_vacuum.exec(QSL("OPTIMIZE TABLE Feeds;")) && query_vacuum.exec(QSL("OPTIMIZE TABLE Messages;"));
@@ -198,7 +198,7 @@ QSqlDatabase MariaDbDriver::initializeDatabase(const QString& connection_name) {
 
       if (installed_db_schema < QSL(APP_DB_SCHEMA_VERSION).toInt()) {
         try {
-          updateDatabaseSchema(query_db, installed_db_schema, database_name);
+          updateDatabaseSchema(database, query_db, installed_db_schema, database_name);
           qDebugNN << LOGSEC_DB << "Database schema was updated from" << QUOTE_W_SPACE(installed_db_schema) << "to"
                    << QUOTE_W_SPACE(APP_DB_SCHEMA_VERSION) << "successully.";
         }
@@ -236,7 +236,7 @@ QSqlDatabase MariaDbDriver::connection(const QString& connection_name,
 
       // This database connection was added previously, no need to
       // setup its properties.
-      database = QSqlDatabase::database(connection_name);
+      database = QSqlDatabase::database(connection_name, false);
     }
     else {
       // Database connection with this name does not exist
@@ -249,19 +249,25 @@ QSqlDatabase MariaDbDriver::connection(const QString& connection_name,
       database.setDatabaseName(qApp->settings()->value(GROUP(Database), SETTING(Database::MySQLDatabase)).toString());
     }
 
-    if (!database.isOpen() && !database.open()) {
-      // NOTE: In this case throw exception and fallback SQL backend will be used.
-      throw ApplicationException(database.lastError().text());
-    }
-    else {
+    if (!database.isOpen()) {
+      // Queries prepared with previous connection are not valid anymore.
+      clearPreparedQueries(connection_name);
+
+      if (!database.open()) {
+        // NOTE: In this case throw exception and fallback SQL backend will be used.
+        throw ApplicationException(database.lastError().text());
+      }
+
       qDebugNN << LOGSEC_DB << "MySQL database connection" << QUOTE_W_SPACE(connection_name) << "to file"
                << QUOTE_W_SPACE(QDir::toNativeSeparators(database.databaseName())) << "seems to be established.";
-    }
 
-    QSqlQuery query_db(database);
+      // NOTE: Session settings are kept by server for the whole lifetime of
+      // the connection, so set them only once instead of with each use.
+      QSqlQuery query_db(database);
 
-    query_db.setForwardOnly(true);
-    setPragmas(query_db);
+      query_db.setForwardOnly(true);
+      setPragmas(query_db);
+    }
 
     return database;
   }
@@ -274,3 +280,7 @@ QString MariaDbDriver::autoIncrementPrimaryKey() const {
 QString MariaDbDriver::blob() const {
   return QSL("MEDIUMBLOB");
 }
+
+QString MariaDbDriver::textKeyLength() const {
+  return QSL("(255)");
+}
@@ -2,6 +2,7 @@
 
 #include "database/sqlitedriver.h"
 
+#include "database/databasefactory.h"
 #include "exceptions/applicationexception.h"
 #include "miscellaneous/application.h"
 
@@ -9,11 +10,64 @@
 #include <QSqlDriver>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QtConcurrentRun>
+
+// SQL function COMPRESS(text), compatible with the MariaDB function of the same name.
+static void sqliteCompress(sqlite3_context* context, int argc, sqlite3_value** argv) {
+  Q_UNUSED(argc)
+
+  if (sqlite3_value_type(argv[0]) == SQLITE_NULL) {
+    sqlite3_result_null(context);
+    return;
+  }
+
+  const QByteArray data(reinterpret_cast<const char*>(sqlite3_value_text(argv[0])), sqlite3_value_bytes(argv[0]));
+  const QByteArray compressed = DatabaseFactory::compress(data);
+
+  sqlite3_result_blob(context, compressed.constData(), int(compressed.size()), SQLITE_TRANSIENT);
+}
+
+// SQL function UNCOMPRESS(blob), compatible with the MariaDB function of the same name.
+static void sqliteUncompress(sqlite3_context* context, int argc, sqlite3_value** argv) {
+  Q_UNUSED(argc)
+
+  if (sqlite3_value_type(argv[0]) == SQLITE_NULL) {
+    sqlite3_result_null(context);
+    return;
+  }
+
+  const QByteArray data(static_cast<const char*>(sqlite3_value_blob(argv[0])), sqlite3_value_bytes(argv[0]));
+  const QByteArray uncompressed = DatabaseFactory::uncompress(data);
+
+  sqlite3_result_text(context, uncompressed.constData(), int(uncompressed.size()), SQLITE_TRANSIENT);
+}
+
+// Commit hook, which remembers that database was changed.
+static int sqliteCommitHook(void* changed) {
+  static_cast<std::atomic_bool*>(changed)->store(true);
+
+  // NOTE: Zero means that commit proceeds normally.
+  return 0;
+}
 
 SqliteDriver::SqliteDriver(bool in_memory, QObject* parent)
   : DatabaseDriver(parent), m_inMemoryDatabase(in_memory),
     m_databaseFilePath(qApp->userDataFolder() + QDir::separator() + QSL(APP_DB_SQLITE_PATH)),
-    m_fileBasedDatabaseInitialized(false), m_inMemoryDatabaseInitialized(false) {}
+    m_fileBasedDatabaseInitialized(false), m_inMemoryDatabaseInitialized(false), m_changedSinceSave(false),
+    m_saveUrgently(false) {
+  // NOTE: Saving thread is kept alive, so that it always
+  // uses the same database connection.
+  m_savePool.setMaxThreadCount(1);
+  m_savePool.setExpiryTimeout(-1);
+
+  connect(&m_saveTimer, &QTimer::timeout, this, &SqliteDriver::maintainDatabaseInBackground);
+  m_saveTimer.start(APP_DB_SQLITE_SAVE_INTERVAL);
+}
+
+SqliteDriver::~SqliteDriver() {
+  m_saveUrgently = true;
+  m_savePool.waitForDone();
+}
 
 QString SqliteDriver::location() const {
   return QDir::toNativeSeparators(m_databaseFilePath);
@@ -24,14 +78,73 @@ DatabaseDriver::DriverType SqliteDriver::driverType() const {
 }
 
 bool SqliteDriver::vacuumDatabase() {
-  QSqlDatabase database;
+  // NOTE: In-memory database is vacuumed directly, its pages
+  // are then copied to file-based database when saving.
+  QSqlDatabase database = threadSafeConnection(objectName());
+  QSqlQuery query_vacuum(database);
 
-  saveDatabase();
-  database = connection(objectName(), DatabaseDriver::DesiredStorageType::StrictlyFileBased);
+  query_vacuum.setForwardOnly(true);
 
+  if (!query_vacuum.exec(QSL("PRAGMA auto_vacuum")) || !query_vacuum.next()) {
+    return false;
+  }
+
+  const bool incremental = query_vacuum.value(0).toInt() == 2;
+
+  query_vacuum.finish();
+
+  if (!incremental) {
+    // Databases created before incremental vacuuming was introduced
+    // need one full VACUUM to switch to it.
+    qDebugNN << LOGSEC_DB << "Switching SQLite database to incremental vacuuming.";
+
+    if (!query_vacuum.exec(QSL("PRAGMA auto_vacuum = INCREMENTAL")) || !query_vacuum.exec(QSL("VACUUM"))) {
+      return false;
+    }
+  }
+  else if (!releaseFreePages(database, -1)) {
+    return false;
+  }
+
+  return saveDatabase();
+}
+
+bool SqliteDriver::releaseFreePages(const QSqlDatabase& database, int max_steps) {
   QSqlQuery query_vacuum(database);
+  int last_free_pages = -1;
+
+  query_vacuum.setForwardOnly(true);
+
+  // Free pages are released in small steps, so that other
+  // connections are not blocked for long time.
+  for (int step = 0; max_steps < 0 || step < max_steps; step++) {
+    if (!query_vacuum.exec(QSL("PRAGMA freelist_count")) || !query_vacuum.next()) {
+      return false;
+    }
+
+    const int free_pages = query_vacuum.value(0).toInt();
+
+    query_vacuum.finish();
+
+    if (free_pages <= 0 || free_pages == last_free_pages) {
+      break;
+    }
+
+    last_free_pages = free_pages;
+
+    if (!query_vacuum.exec(QSL("PRAGMA incremental_vacuum(%1)").arg(APP_DB_SQLITE_VACUUM_PAGES))) {
+      return false;
+    }
+
+    // NOTE: Pragma releases one page per each returned row.
+    while (query_vacuum.next()) {
+    }
 
-  return query_vacuum.exec(QSL("VACUUM"));
+    query_vacuum.finish();
+    sqlite3_sleep(APP_DB_SQLITE_VACUUM_PAUSE);
+  }
+
+  return true;
 }
 
 QString SqliteDriver::ddlFilePrefix() const {
@@ -72,7 +185,34 @@ int SqliteDriver::loadOrSaveDbInMemoryDb(sqlite3* in_memory_db, const char* db_f
     */
     p_backup = sqlite3_backup_init(p_to, "main", p_from, "main");
     if (p_backup) {
-      (void)sqlite3_backup_step(p_backup, -1);
+      /* Data are copied in steps. Source database is locked only for the duration
+      ** of each step, when saving in background, we pause between steps so that
+      ** other connections can use the database.
+      **
+      ** Backup restarts whenever other connection writes to source database, so
+      ** after too many restarts, the rest is copied in one step. */
+      int restarts = 0;
+      int last_remaining = -1;
+
+      do {
+        const bool final_step = restarts > APP_DB_SQLITE_SAVE_RESTARTS;
+
+        rc = sqlite3_backup_step(p_backup, final_step ? -1 : APP_DB_SQLITE_SAVE_PAGES);
+
+        const int remaining = sqlite3_backup_remaining(p_backup);
+
+        if (last_remaining >= 0 && remaining > last_remaining) {
+          restarts++;
+        }
+
+        last_remaining = remaining;
+
+        if (save && !m_saveUrgently && !final_step &&
+            (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED)) {
+          sqlite3_sleep(APP_DB_SQLITE_SAVE_PAUSE);
+        }
+      } while (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
+
       (void)sqlite3_backup_finish(p_backup);
     }
     rc = sqlite3_errcode(p_to);
@@ -91,27 +231,95 @@ bool SqliteDriver::saveDatabase() {
     return true;
   }
   else {
-    qDebugNN << LOGSEC_DB << "Saving in-memory working database back to persistent file-based storage.";
+    // NOTE: Possibly running background save is finished without pauses
+    // and only the rest of changes is then saved.
+    m_saveUrgently = true;
 
-    QSqlDatabase database = connection(QSL("SaveFromMemory"), DatabaseDriver::DesiredStorageType::StrictlyInMemory);
-    const QDir db_path(m_databaseFilePath);
-    QFile db_file(db_path.absoluteFilePath(QSL(APP_DB_SQLITE_FILE)));
-    QVariant v = database.driver()->handle();
+    try {
+      const bool saved = saveInMemoryDatabase();
+
+      m_saveUrgently = false;
+      return saved;
+    }
+    catch (...) {
+      m_saveUrgently = false;
+      throw;
+    }
+  }
+}
 
-    if (v.isValid() && (qstrcmp(v.typeName(), "sqlite3*") == 0)) {
-      // v.data() returns a pointer to the handle
-      sqlite3* handle = *static_cast<sqlite3**>(v.data());
+void SqliteDriver::maintainDatabaseInBackground() {
+  if ((m_inMemoryDatabase && !m_inMemoryDatabaseInitialized) ||
+      (!m_inMemoryDatabase && !m_fileBasedDatabaseInitialized) || m_savePool.activeThreadCount() > 0) {
+    return;
+  }
 
-      if (handle != nullptr) {
-        loadOrSaveDbInMemoryDb(handle, QDir::toNativeSeparators(db_file.fileName()).toStdString().c_str(), 1);
+  QtConcurrent::run(&m_savePool, [this]() {
+    if (m_inMemoryDatabase) {
+      try {
+        saveInMemoryDatabase();
       }
-      else {
-        throw ApplicationException(tr("cannot get native 'sqlite3' DB handle"));
+      catch (const ApplicationException& ex) {
+        qCriticalNN << LOGSEC_DB << "Error when saving DB in background:" << QUOTE_W_SPACE_DOT(ex.message());
       }
     }
 
+    if (m_saveUrgently) {
+      return;
+    }
+
+    // NOTE: Free pages of in-memory database released here
+    // are written to file with next save.
+    QSqlDatabase database = threadSafeConnection(QSL("BackgroundVacuum"));
+    QSqlQuery query_vacuum(database);
+
+    query_vacuum.setForwardOnly(true);
+
+    if (query_vacuum.exec(QSL("PRAGMA auto_vacuum")) && query_vacuum.next() && query_vacuum.value(0).toInt() == 2) {
+      query_vacuum.finish();
+
+      if (!releaseFreePages(database, APP_DB_SQLITE_VACUUM_BACKGROUND_STEPS)) {
+        qWarningNN << LOGSEC_DB << "Free pages of DB were not released in background.";
+      }
+    }
+  });
+}
+
+bool SqliteDriver::saveInMemoryDatabase() {
+  QMutexLocker lck(&m_saveMutex);
+
+  if (!m_changedSinceSave.exchange(false)) {
+    qDebugNN << LOGSEC_DB << "In-memory working database was not changed since it was saved.";
     return true;
   }
+
+  qDebugNN << LOGSEC_DB << "Saving in-memory working database back to persistent file-based storage.";
+
+  QSqlDatabase database =
+    threadSafeConnection(QSL("SaveFromMemory"), DatabaseDriver::DesiredStorageType::StrictlyInMemory);
+  const QDir db_path(m_databaseFilePath);
+  QFile db_file(db_path.absoluteFilePath(QSL(APP_DB_SQLITE_FILE)));
+  QVariant v = database.driver()->handle();
+
+  if (v.isValid() && (qstrcmp(v.typeName(), "sqlite3*") == 0)) {
+    // v.data() returns a pointer to the handle
+    sqlite3* handle = *static_cast<sqlite3**>(v.data());
+
+    if (handle != nullptr) {
+      if (loadOrSaveDbInMemoryDb(handle, QDir::toNativeSeparators(db_file.fileName()).toStdString().c_str(), 1) !=
+          SQLITE_OK) {
+        // Try again next time.
+        m_changedSinceSave = true;
+        return false;
+      }
+    }
+    else {
+      m_changedSinceSave = true;
+      throw ApplicationException(tr("cannot get native 'sqlite3' DB handle"));
+    }
+  }
+
+  return true;
 }
 
 QSqlDatabase SqliteDriver::connection(const QString& connection_name, DesiredStorageType desired_type) {
@@ -130,7 +338,7 @@ QSqlDatabase SqliteDriver::connection(const QString& connection_name, DesiredSto
 
       // This database connection was added previously, no need to
       // setup its properties.
-      database = QSqlDatabase::database(connection_name);
+      database = QSqlDatabase::database(connection_name, false);
     }
     else {
       database = QSqlDatabase::addDatabase(QSL(APP_DB_SQLITE_DRIVER), connection_name);
@@ -148,7 +356,14 @@ QSqlDatabase SqliteDriver::connection(const QString& connection_name, DesiredSto
       }
     }
 
-    if (!database.isOpen() && !database.open()) {
+    const bool newly_opened = !database.isOpen();
+
+    if (newly_opened) {
+      // Queries prepared with previous connection are not valid anymore.
+      clearPreparedQueries(connection_name);
+    }
+
+    if (newly_opened && !database.open()) {
       qFatal("SQLite database was NOT opened. Delivered error message: '%s'.", qPrintable(database.lastError().text()));
     }
     else {
@@ -161,6 +376,12 @@ QSqlDatabase SqliteDriver::connection(const QString& connection_name, DesiredSto
     query_db.setForwardOnly(true);
     setPragmas(query_db);
 
+    if (newly_opened) {
+      // NOTE: Functions and commit hook live as long as native connection,
+      // so they are registered only when connection is opened.
+      registerFunctions(database);
+    }
+
     return database;
   }
 }
@@ -240,6 +461,7 @@ QSqlDatabase SqliteDriver::initializeDatabase(const QString& connection_name, bo
 
     query_db.setForwardOnly(true);
     setPragmas(query_db);
+    registerFunctions(database);
 
     // Sample query which checks for existence of tables.
     if (!query_db.exec(QSL("SELECT inf_value FROM Information WHERE inf_key = 'schema_version'"))) {
@@ -278,7 +500,7 @@ QSqlDatabase SqliteDriver::initializeDatabase(const QString& connection_name, bo
         }
 
         try {
-          updateDatabaseSchema(query_db, installed_db_schema);
+          updateDatabaseSchema(database, query_db, installed_db_schema);
           qDebugNN << LOGSEC_DB << "Database schema was updated from" << QUOTE_W_SPACE(installed_db_schema) << "to"
                    << QUOTE_W_SPACE(APP_DB_SCHEMA_VERSION) << "successully.";
         }
@@ -332,6 +554,8 @@ QSqlDatabase SqliteDriver::initializeDatabase(const QString& connection_name, bo
 
   // Everything is initialized now.
   if (in_memory) {
+    // NOTE: Data were just loaded from file, there is nothing to save yet.
+    m_changedSinceSave = false;
     m_inMemoryDatabaseInitialized = true;
   }
   else {
@@ -348,6 +572,7 @@ QString SqliteDriver::databaseFilePath() const {
 void SqliteDriver::setPragmas(QSqlQuery& query) {
   query.exec(QSL("PRAGMA encoding = \"UTF-8\""));
   query.exec(QSL("PRAGMA page_size = 32768"));
+  query.exec(QSL("PRAGMA auto_vacuum = INCREMENTAL"));
   query.exec(QSL("PRAGMA cache_size = 32768"));
   query.exec(QSL("PRAGMA mmap_size = 100000000"));
   query.exec(QSL("PRAGMA count_changes = OFF"));
@@ -356,6 +581,47 @@ void SqliteDriver::setPragmas(QSqlQuery& query) {
   query.exec(QSL("PRAGMA journal_mode = MEMORY"));
 }
 
+void SqliteDriver::registerFunctions(const QSqlDatabase& database) {
+  QVariant v = database.driver()->handle();
+
+  if (v.isValid() && (qstrcmp(v.typeName(), "sqlite3*") == 0)) {
+    sqlite3* handle = *static_cast<sqlite3**>(v.data());
+
+    if (handle != nullptr) {
+      const int res_compress = sqlite3_create_function(handle,
+                                                       "COMPRESS",
+                                                       1,
+                                                       SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+                                                       nullptr,
+                                                       &sqliteCompress,
+                                                       nullptr,
+                                                       nullptr);
+      const int res_uncompress = sqlite3_create_function(handle,
+                                                         "UNCOMPRESS",
+                                                         1,
+                                                         SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+                                                         nullptr,
+                                                         &sqliteUncompress,
+                                                         nullptr,
+                                                         nullptr);
+
+      if (res_compress != SQLITE_OK || res_uncompress != SQLITE_OK) {
+        qFatal("SQL functions for compressing of article contents were NOT registered. Delivered error message: '%s'.",
+               sqlite3_errmsg(handle));
+      }
+
+      // Track changes, so that in-memory database is saved only when needed.
+      sqlite3_commit_hook(handle, &sqliteCommitHook, &m_changedSinceSave);
+      return;
+    }
+  }
+
+  // NOTE: Article contents are stored compressed and all queries which read or write
+  // them use these functions, database is not usable without them.
+  qFatal("SQL functions for compressing of article contents were NOT registered, "
+         "native 'sqlite3' DB handle is not available.");
+}
+
 qint64 SqliteDriver::databaseDataSize() {
   QSqlDatabase database = connection(metaObject()->className(), DatabaseDriver::DesiredStorageType::FromSettings);
   qint64 result = 1;
@@ -406,3 +672,7 @@ QString SqliteDriver::autoIncrementPrimaryKey() const {
 QString SqliteDriver::blob() const {
   return QSL("BLOB");
 }
+
+QString SqliteDriver::textKeyLength() const {
+  return QString();
+}
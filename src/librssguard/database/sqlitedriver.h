@@ -5,6 +5,12 @@
 
 #include "database/databasedriver.h"
 
+#include <QMutex>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <atomic>
+
 #if defined(SYSTEM_SQLITE3)
 #include <sqlite3.h>
 #else
@@ -16,6 +22,7 @@ class SqliteDriver : public DatabaseDriver {
 
   public:
     explicit SqliteDriver(bool in_memory, QObject* parent = nullptr);
+    virtual ~SqliteDriver();
 
     virtual QString location() const;
     virtual DriverType driverType() const;
@@ -33,12 +40,30 @@ class SqliteDriver : public DatabaseDriver {
     virtual void backupDatabase(const QString& backup_folder, const QString& backup_name);
     virtual QString autoIncrementPrimaryKey() const;
     virtual QString blob() const;
+    virtual QString textKeyLength() const;
+
+  public slots:
+    // Starts periodic maintenance in background thread. In-memory database
+    // is saved, copied in steps, so that other connections can work with it meanwhile.
+    // Then few steps of incremental vacuum are done.
+    void maintainDatabaseInBackground();
 
   private:
     QSqlDatabase initializeDatabase(const QString& connection_name, bool in_memory);
     void setPragmas(QSqlQuery& query);
+
+    // Registers custom SQL functions on native connection. Application
+    // is terminated if they cannot be registered.
+    void registerFunctions(const QSqlDatabase& database);
     QString databaseFilePath() const;
 
+    // Releases free pages of incrementally vacuumed database, at most
+    // "max_steps" steps are done, negative value means no limit.
+    bool releaseFreePages(const QSqlDatabase& database, int max_steps);
+
+    // Saves in-memory database if it was changed since it was saved last time.
+    bool saveInMemoryDatabase();
+
     // Uses native "sqlite3" handle to save or load in-memory DB from/to file.
     int loadOrSaveDbInMemoryDb(sqlite3* in_memory_db, const char* db_filename, bool save);
 
@@ -47,6 +72,15 @@ class SqliteDriver : public DatabaseDriver {
     QString m_databaseFilePath;
     bool m_fileBasedDatabaseInitialized;
     bool m_inMemoryDatabaseInitialized;
+
+    // Set by commit hook of each connection.
+    std::atomic_bool m_changedSinceSave;
+
+    // When set, saving does not pause between its steps.
+    std::atomic_bool m_saveUrgently;
+    QMutex m_saveMutex;
+    QTimer m_saveTimer;
+    QThreadPool m_savePool;
 };
 
 #endif // SQLITEDRIVER_H
@@ -58,6 +58,21 @@
 #define IS_IN_ARRAY(offset, array)  ((offset >= 0) && (offset < array.count()))
 #define DEFAULT_SQL_MESSAGES_FILTER "0 > 1"
 #define MAX_MULTICOLUMN_SORT_STATES 3
+#define MSG_BODIES_CACHE_SIZE       64
+#define MSG_LAYOUT_CACHE_SIZE       4096
+#define ICON_STORE_CACHE_SIZE       256
+#define ICON_STORE_PIXMAP_SIZE      64
+#define ARTICLE_PREFETCH_THREADS    4
+#define ARTICLE_PREFETCH_PER_HOST   2
+#define ARTICLE_PREFETCH_BATCH      100
+#define ARTICLE_PREFETCH_WAIT_STEP  250
+
+// Images of articles displayed in text browser are downloaded in parallel and cached.
+#define RESOURCES_PARALLEL_DOWNLOADS 6
+#define RESOURCES_DISK_CACHE_SIZE    (100 * 1024 * 1024) // In bytes.
+#define RESOURCES_DISK_CACHE_FOLDER  "images"
+#define RESOURCES_DOWNLOAD_TIMEOUT   5000
+#define RESOURCES_MEMORY_CACHE_SIZE  (64 * 1024 * 1024) // In bytes, per each viewer.
 
 #define RELEASES_LIST      "https://api.github.com/repos/martinrotter/rssguard/releases"
 #define MSG_FILTERING_HELP APP_URL_DOCUMENTATION "#fltr"
@@ -101,6 +116,7 @@
 #define MAX_THREADPOOL_THREADS       32
 #define WEB_BROWSER_SCROLL_STEP      50.0
 #define MAX_NUMBER_OF_REDIRECTIONS   4
+#define TRACER_MAX_SPANS             100000
 
 #define NOTIFICATIONS_MARGIN       16
 #define NOTIFICATIONS_WIDTH        300
@@ -153,9 +169,14 @@
 #define CLI_IS_RUNNING    "a"
 
 #define CLI_THREADS "threads"
+#define CLI_TRACE   "trace"
 
 #define HTTP_CODE_NOT_MODIFIED 304
 
+#define HTTP_SERVER_MAX_CONNECTIONS 32
+#define HTTP_SERVER_MAX_HEADER_SIZE 16384   // In bytes.
+#define HTTP_SERVER_MAX_BODY_SIZE   1048576 // In bytes.
+
 #define HTTP_HEADERS_ACCEPT         "Accept"
 #define HTTP_HEADERS_CONTENT_TYPE   "Content-Type"
 #define HTTP_HEADERS_CONTENT_LENGTH "Content-Length"
@@ -227,14 +248,31 @@
 #define APP_DB_SQLITE_PATH   "database"
 #define APP_DB_SQLITE_FILE   "database.db"
 
+// In-memory SQLite database is periodically saved in background, copied in steps of given
+// count of pages with pauses (in milliseconds) between them. When copying restarts too many
+// times because of concurrent writes, the rest is copied in one step.
+#define APP_DB_SQLITE_SAVE_INTERVAL 600000
+#define APP_DB_SQLITE_SAVE_PAGES    64
+#define APP_DB_SQLITE_SAVE_PAUSE    5
+#define APP_DB_SQLITE_SAVE_RESTARTS 8
+
+// Database cleanup removes articles in chunks of given size, each chunk in its own transaction.
+// Free SQLite pages are then reclaimed in incremental steps with pauses (in milliseconds) between them,
+// periodic background maintenance does at most given count of these steps.
+#define APP_DB_PURGE_CHUNK_SIZE               1000
+#define APP_DB_SQLITE_VACUUM_PAGES            256
+#define APP_DB_SQLITE_VACUUM_PAUSE            10
+#define APP_DB_SQLITE_VACUUM_BACKGROUND_STEPS 16
+
 // Keep this in sync with schema versions declared in SQL initialization code.
-#define APP_DB_SCHEMA_VERSION                "8"
+#define APP_DB_SCHEMA_VERSION                "14"
 #define APP_DB_UPDATE_FILE_PATTERN           "db_update_%1_%2_%3.sql"
 #define APP_DB_COMMENT_SPLIT                 "-- !\n"
 #define APP_DB_INCLUDE_PLACEHOLDER           "!!"
 #define APP_DB_NAME_PLACEHOLDER              "##"
 #define APP_DB_AUTO_INC_PRIM_KEY_PLACEHOLDER "$$"
 #define APP_DB_BLOB_PLACEHOLDER              "^^"
+#define APP_DB_TEXT_KEY_LENGTH_PLACEHOLDER   "~~"
 
 #define APP_CFG_PATH "config"
 #define APP_CFG_FILE "config.ini"
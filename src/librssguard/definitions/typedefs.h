@@ -7,6 +7,7 @@
 #include "services/abstract/rootitem.h"
 
 #include <QList>
+#include <QMap>
 #include <QPair>
 
 // First item here represents ID (int, primary key) of the item.
@@ -19,6 +20,16 @@ struct ArticleCounts {
     int m_unread = -1;
 };
 
+// Categories and feeds of account as stored in database.
+struct AccountStructure {
+    Assignment m_categories;
+    Assignment m_feeds;
+
+    // Key is feed's custom ID.
+    QMap<QString, ArticleCounts> m_counts;
+    bool m_countsLoaded = false;
+};
+
 struct UpdatedArticles {
     QList<Message> m_unread;
     QList<Message> m_all;
@@ -14,8 +14,28 @@
 #include <QPushButton>
 
 FormDatabaseCleanup::FormDatabaseCleanup(QWidget* parent)
-  : QDialog(parent), m_ui(new Ui::FormDatabaseCleanup), m_cleaner(nullptr) {
+  : QDialog(parent), m_ui(new Ui::FormDatabaseCleanup), m_btnCancel(nullptr), m_cleaner(new DatabaseCleaner()),
+    m_cleanerThread(new QThread()) {
   m_ui->setupUi(this);
+  m_btnCancel = m_ui->m_btnBox->addButton(tr("Cancel cleanup"), QDialogButtonBox::ButtonRole::ActionRole);
+  m_btnCancel->setVisible(false);
+
+  // NOTE: Cleanup runs in its own thread so that GUI stays responsive
+  // and cleanup can be cancelled.
+  m_cleaner->moveToThread(m_cleanerThread);
+
+  // NOTE: Database connection of cleanup thread must be removed by the thread itself
+  // before it ends, later threads can get the same ID.
+  connect(
+    m_cleanerThread,
+    &QThread::finished,
+    m_cleanerThread,
+    []() {
+      qApp->database()->driver()->removeThreadSafeConnection();
+    },
+    Qt::ConnectionType::DirectConnection);
+
+  m_cleanerThread->start(QThread::Priority::LowPriority);
 
   setObjectName(QSL("form_db_cleanup"));
 
@@ -29,10 +49,14 @@ FormDatabaseCleanup::FormDatabaseCleanup(QWidget* parent)
           &QPushButton::clicked,
           this,
           &FormDatabaseCleanup::startPurging);
-  connect(this, &FormDatabaseCleanup::purgeRequested, &m_cleaner, &DatabaseCleaner::purgeDatabaseData);
-  connect(&m_cleaner, &DatabaseCleaner::purgeStarted, this, &FormDatabaseCleanup::onPurgeStarted);
-  connect(&m_cleaner, &DatabaseCleaner::purgeProgress, this, &FormDatabaseCleanup::onPurgeProgress);
-  connect(&m_cleaner, &DatabaseCleaner::purgeFinished, this, &FormDatabaseCleanup::onPurgeFinished);
+  connect(m_btnCancel, &QPushButton::clicked, this, [this]() {
+    m_btnCancel->setEnabled(false);
+    m_cleaner->cancelPurging();
+  });
+  connect(this, &FormDatabaseCleanup::purgeRequested, m_cleaner, &DatabaseCleaner::purgeDatabaseData);
+  connect(m_cleaner, &DatabaseCleaner::purgeStarted, this, &FormDatabaseCleanup::onPurgeStarted);
+  connect(m_cleaner, &DatabaseCleaner::purgeProgress, this, &FormDatabaseCleanup::onPurgeProgress);
+  connect(m_cleaner, &DatabaseCleaner::purgeFinished, this, &FormDatabaseCleanup::onPurgeFinished);
 
   m_ui->m_spinDays->setValue(DEFAULT_DAYS_TO_DELETE_MSG);
   m_ui->m_lblResult->setStatus(WidgetWithStatus::StatusType::Information, tr("I am ready."), tr("I am ready."));
@@ -42,8 +66,17 @@ FormDatabaseCleanup::FormDatabaseCleanup(QWidget* parent)
   GuiUtilities::restoreState(this, qApp->settings()->value(GROUP(GUI), objectName(), QByteArray()).toByteArray());
 }
 
+FormDatabaseCleanup::~FormDatabaseCleanup() {
+  m_cleaner->cancelPurging();
+  m_cleanerThread->quit();
+  m_cleanerThread->wait();
+
+  delete m_cleaner;
+  delete m_cleanerThread;
+}
+
 void FormDatabaseCleanup::closeEvent(QCloseEvent* event) {
-  if (!m_ui->m_btnBox->isEnabled()) {
+  if (isPurging()) {
     event->ignore();
   }
   else {
@@ -52,7 +85,7 @@ void FormDatabaseCleanup::closeEvent(QCloseEvent* event) {
 }
 
 void FormDatabaseCleanup::keyPressEvent(QKeyEvent* event) {
-  if (!m_ui->m_btnBox->isEnabled()) {
+  if (isPurging()) {
     event->ignore();
   }
   else {
@@ -79,7 +112,10 @@ void FormDatabaseCleanup::startPurging() {
 
 void FormDatabaseCleanup::onPurgeStarted() {
   m_ui->m_progressBar->setValue(0);
-  m_ui->m_btnBox->setEnabled(false);
+  m_ui->m_btnBox->button(QDialogButtonBox::StandardButton::Ok)->setEnabled(false);
+  m_ui->m_btnBox->button(QDialogButtonBox::StandardButton::Close)->setEnabled(false);
+  m_btnCancel->setEnabled(true);
+  m_btnCancel->setVisible(true);
   m_ui->m_lblResult->setStatus(WidgetWithStatus::StatusType::Information,
                                tr("Database cleanup is running."),
                                tr("Database cleanup is running."));
@@ -92,9 +128,16 @@ void FormDatabaseCleanup::onPurgeProgress(int progress, const QString& descripti
 
 void FormDatabaseCleanup::onPurgeFinished(bool finished) {
   m_ui->m_progressBar->setValue(100);
-  m_ui->m_btnBox->setEnabled(true);
-
-  if (finished) {
+  m_ui->m_btnBox->button(QDialogButtonBox::StandardButton::Ok)->setEnabled(true);
+  m_ui->m_btnBox->button(QDialogButtonBox::StandardButton::Close)->setEnabled(true);
+  m_btnCancel->setVisible(false);
+
+  if (finished && m_cleaner->isPurgingCancelled()) {
+    m_ui->m_lblResult->setStatus(WidgetWithStatus::StatusType::Warning,
+                                 tr("Database cleanup was cancelled."),
+                                 tr("Database cleanup was cancelled."));
+  }
+  else if (finished) {
     m_ui->m_lblResult->setStatus(WidgetWithStatus::StatusType::Ok,
                                  tr("Database cleanup is completed."),
                                  tr("Database cleanup is completed."));
@@ -116,6 +159,10 @@ void FormDatabaseCleanup::loadDatabaseInfo() {
   m_ui->m_txtDatabaseType->setText(qApp->database()->driver()->humanDriverType());
 }
 
+bool FormDatabaseCleanup::isPurging() const {
+  return !m_btnCancel->isHidden();
+}
+
 void FormDatabaseCleanup::hideEvent(QHideEvent* event) {
   QByteArray state = GuiUtilities::saveState(this);
 
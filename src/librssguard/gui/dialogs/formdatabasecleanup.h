@@ -8,13 +8,14 @@
 #include "ui_formdatabasecleanup.h"
 
 #include <QDialog>
+#include <QThread>
 
 class FormDatabaseCleanup : public QDialog {
     Q_OBJECT
 
   public:
     explicit FormDatabaseCleanup(QWidget* parent = nullptr);
-    virtual ~FormDatabaseCleanup() = default;
+    virtual ~FormDatabaseCleanup();
 
   protected:
     virtual void closeEvent(QCloseEvent* event);
@@ -33,10 +34,13 @@ class FormDatabaseCleanup : public QDialog {
 
   private:
     void loadDatabaseInfo();
+    bool isPurging() const;
 
   private:
     QScopedPointer<Ui::FormDatabaseCleanup> m_ui;
-    DatabaseCleaner m_cleaner;
+    QPushButton* m_btnCancel;
+    DatabaseCleaner* m_cleaner;
+    QThread* m_cleanerThread;
 };
 
 #endif // FORMDATABASECLEANUP_H
@@ -438,10 +438,15 @@ void FormMain::updateTabsButtonsAvailability(int index) {
 }
 
 void FormMain::onFeedUpdatesFinished(const FeedDownloadResults& results) {
-  Q_UNUSED(results)
-
   statusBar()->clearProgressFeeds();
-  tabWidget()->feedMessageViewer()->messagesView()->reloadSelections();
+
+  MessagesView* msgs_view = tabWidget()->feedMessageViewer()->messagesView();
+
+  // Fetched articles are merged into article list when possible, so that
+  // scroll position and selection are kept, otherwise whole list is reloaded.
+  if (results.anyArticlesRemoved() || !msgs_view->sourceModel()->mergeArticles(results.updatedArticleIds())) {
+    msgs_view->reloadSelections();
+  }
 }
 
 void FormMain::onFeedUpdatesStarted() {
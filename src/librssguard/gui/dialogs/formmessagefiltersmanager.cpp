@@ -6,6 +6,7 @@
 #include "core/messagefilter.h"
 #include "core/messagesforfiltersmodel.h"
 #include "database/databasequeries.h"
+#include "exceptions/applicationexception.h"
 #include "exceptions/filteringexception.h"
 #include "gui/guiutilities.h"
 #include "gui/messagebox.h"
@@ -13,19 +14,25 @@
 #include "miscellaneous/application.h"
 #include "miscellaneous/feedreader.h"
 #include "miscellaneous/iconfactory.h"
+#include "miscellaneous/thread.h"
 #include "network-web/webfactory.h"
 #include "services/abstract/accountcheckmodel.h"
 #include "services/abstract/feed.h"
+#include "services/abstract/labelsnode.h"
 
 #include <QDateTime>
 #include <QJSEngine>
 #include <QProcess>
+#include <QSqlError>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
 
 FormMessageFiltersManager::FormMessageFiltersManager(FeedReader* reader,
                                                      const QList<ServiceRoot*>& accounts,
                                                      QWidget* parent)
   : QDialog(parent), m_feedsModel(new AccountCheckSortedModel(this)), m_rootItem(new RootItem()), m_accounts(accounts),
-    m_reader(reader), m_loadingFilter(false), m_msgModel(new MessagesForFiltersModel(this)) {
+    m_reader(reader), m_loadingFilter(false), m_msgModel(new MessagesForFiltersModel(this)),
+    m_filteredAccount(nullptr), m_filteringCancelled(0) {
   m_ui.setupUi(this);
 
   m_highlighter = new JsSyntaxHighlighter(m_ui.m_txtScript->document());
@@ -97,6 +104,16 @@ FormMessageFiltersManager::FormMessageFiltersManager(FeedReader* reader,
           this,
           &FormMessageFiltersManager::displayMessagesOfFeed);
   connect(m_ui.m_btnRunOnMessages, &QPushButton::clicked, this, &FormMessageFiltersManager::processCheckedFeeds);
+  connect(&m_watcherFiltering, &QFutureWatcher<FilteredFeed>::progressValueChanged, this, [this](int progress) {
+    m_ui.m_btnRunOnMessages->setText(tr("Stop (%1 of %2 feeds)")
+                                       .arg(QString::number(progress),
+                                            QString::number(m_watcherFiltering.progressMaximum())));
+  });
+  connect(&m_watcherFiltering,
+          &QFutureWatcher<FilteredFeed>::finished,
+          this,
+          &FormMessageFiltersManager::onFeedsFiltered);
+  connect(&m_watcherStoring, &QFutureWatcher<bool>::finished, this, &FormMessageFiltersManager::onFilteredFeedsStored);
   connect(m_ui.m_treeExistingMessages,
           &QTreeView::customContextMenuRequested,
           this,
@@ -121,6 +138,11 @@ FormMessageFiltersManager::FormMessageFiltersManager(FeedReader* reader,
 }
 
 FormMessageFiltersManager::~FormMessageFiltersManager() {
+  m_filteringCancelled.storeRelease(1);
+  m_watcherFiltering.cancel();
+  m_watcherFiltering.waitForFinished();
+  m_watcherStoring.waitForFinished();
+
   delete m_rootItem;
 }
 
@@ -356,135 +378,327 @@ void FormMessageFiltersManager::displayMessagesOfFeed() {
 }
 
 void FormMessageFiltersManager::processCheckedFeeds() {
-  QList<RootItem*> checked = m_feedsModel->sourceModel()->checkedItems();
+  if (m_watcherFiltering.isRunning()) {
+    // Button acts as "stop" while filtering is running, filtered
+    // articles are not stored at all.
+    m_filteringCancelled.storeRelease(1);
+    m_watcherFiltering.cancel();
+    m_ui.m_btnRunOnMessages->setEnabled(false);
+    return;
+  }
+
   auto* fltr = selectedFilter();
-  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+  auto* account = selectedAccount();
+
+  if (fltr == nullptr || account == nullptr || m_watcherStoring.isRunning()) {
+    return;
+  }
+
+  QList<Feed*> feeds;
+  QList<RootItem*> checked = m_feedsModel->sourceModel()->checkedItems();
 
-  for (RootItem* it : checked) {
+  for (RootItem* it : std::as_const(checked)) {
     if (it->kind() == RootItem::Kind::Feed) {
-      QJSEngine filter_engine;
-      MessageObject msg_obj(&database, it->toFeed(), selectedAccount(), false);
+      feeds.append(it->toFeed());
+    }
+  }
+
+  if (feeds.isEmpty()) {
+    return;
+  }
+
+  // Labels are resolved from IDs stored directly with articles.
+  QHash<QString, Label*> labels;
+
+  if (account->labelsNode() != nullptr) {
+    auto lbls = account->labelsNode()->labels();
+
+    for (Label* lbl : std::as_const(lbls)) {
+      labels.insert(lbl->customId(), lbl);
+    }
+  }
+
+  const QString script = fltr->script();
+
+  m_filteredAccount = account;
+  m_filteringCancelled.storeRelease(0);
+  setFilteringRunning(true);
+
+  qDebugNN << LOGSEC_CORE << "Running article filter over" << NONQUOTE_W_SPACE(feeds.size()) << "feeds.";
 
-      MessageFilter::initializeFilteringEngine(filter_engine, &msg_obj);
+  std::function<FilteredFeed(Feed*)> func = [=](Feed* feed) -> FilteredFeed {
+    return filterFeed(feed, account, script, labels);
+  };
 
-      // We process messages of the feed.
-      QList<Message> msgs = it->undeletedMessages();
-      QList<Message> read_msgs, important_msgs;
+  m_watcherFiltering.setFuture(QtConcurrent::mapped(
+#if QT_VERSION_MAJOR > 5
+    qApp->workHorsePool(),
+#endif
+    feeds,
+    func));
+}
 
-      for (int i = 0; i < msgs.size(); i++) {
-        auto labels_in_message = DatabaseQueries::getLabelsForMessage(database, msgs[i], msg_obj.availableLabels());
+void FormMessageFiltersManager::onFeedsFiltered() {
+  if (m_filteringCancelled.loadAcquire() == 1) {
+    qWarningNN << LOGSEC_CORE << "Running of article filter was cancelled, no articles were changed.";
 
-        // Create backup of message.
-        Message* msg = &msgs[i];
+    m_filteredAccount = nullptr;
+    setFilteringRunning(false);
+    return;
+  }
 
-        msg->m_assignedLabels = labels_in_message;
-        msg->m_rawContents = Message::generateRawAtomContents(*msg);
+  m_ui.m_btnRunOnMessages->setText(tr("Saving articles..."));
+  m_ui.m_btnRunOnMessages->setEnabled(false);
 
-        Message msg_backup(*msg);
+  QList<FilteredFeed> results = m_watcherFiltering.future().results();
+  const int account_id = m_filteredAccount->accountId();
 
-        msg_obj.setMessage(msg);
+  // Services are notified from GUI thread, only database is then written in background.
+  notifyServices(m_filteredAccount, results);
 
-        bool remove_from_list = false;
+  m_watcherStoring.setFuture(QtConcurrent::run(qApp->workHorsePool(), [account_id, results]() {
+    return storeFilteredFeeds(account_id, results);
+  }));
+}
+
+void FormMessageFiltersManager::onFilteredFeedsStored() {
+  if (!m_watcherStoring.result()) {
+    MsgBox::show(this,
+                 QMessageBox::Icon::Critical,
+                 tr("Error"),
+                 tr("Articles changed by article filter were not saved, see log for details."));
+  }
+
+  if (m_filteredAccount != nullptr) {
+    // Purged articles and changed labels affect counts across whole account.
+    m_filteredAccount->updateCounts(true);
+    m_filteredAccount->updateCountsOfDirtyNodes();
+
+    if (m_filteredAccount->labelsNode() != nullptr) {
+      m_filteredAccount->labelsNode()->updateCounts(true);
+    }
 
-        try {
-          MessageObject::FilteringAction result = fltr->filterMessage(&filter_engine);
+    m_filteredAccount->itemChanged(m_filteredAccount->getSubTree());
+    m_filteredAccount = nullptr;
+  }
 
-          if (result == MessageObject::FilteringAction::Purge) {
-            remove_from_list = true;
+  setFilteringRunning(false);
+  displayMessagesOfFeed();
+}
 
-            // Purge the message completely and remove leftovers.
-            DatabaseQueries::purgeMessage(database, msg->m_id);
-          }
-          else if (result == MessageObject::FilteringAction::Ignore) {
-            remove_from_list = true;
-          }
-        }
-        catch (const FilteringException& ex) {
-          qCriticalNN << LOGSEC_CORE << "Error when running script when processing existing messages:"
-                      << QUOTE_W_SPACE_DOT(ex.message());
+void FormMessageFiltersManager::setFilteringRunning(bool running) {
+  m_ui.m_cmbAccounts->setEnabled(!running);
+  m_ui.m_treeFeeds->setEnabled(!running);
+  m_ui.m_listFilters->setEnabled(!running);
+  m_ui.m_btnAddNew->setEnabled(!running);
+  m_ui.m_btnRemoveSelected->setEnabled(!running);
+  m_ui.m_btnRunOnMessages->setEnabled(true);
+  m_ui.m_btnRunOnMessages->setText(running ? tr("Stop") : tr("Process checked feeds"));
+  m_ui.m_btnRunOnMessages->setIcon(qApp->icons()->fromTheme(running ? QSL("media-playback-stop")
+                                                                     : QSL("media-playback-start")));
+}
 
-          continue;
-        }
+FormMessageFiltersManager::FilteredFeed
+FormMessageFiltersManager::filterFeed(Feed* feed,
+                                      ServiceRoot* account,
+                                      const QString& script,
+                                      const QHash<QString, Label*>& labels) const {
+#if defined(Q_OS_LINUX)
+  setThreadPriority(Priority::Lowest);
+#endif
 
-        if (!msg_backup.m_isRead && msg->m_isRead) {
-          qDebugNN << LOGSEC_FEEDDOWNLOADER << "Message with custom ID: '" << msg_backup.m_customId
-                   << "' was marked as read by message scripts.";
+  FilteredFeed result;
 
-          read_msgs << *msg;
-        }
+  result.m_feed = feed;
 
-        if (!msg_backup.m_isImportant && msg->m_isImportant) {
-          qDebugNN << LOGSEC_FEEDDOWNLOADER << "Message with custom ID: '" << msg_backup.m_customId
-                   << "' was marked as important by message scripts.";
+  if (m_filteringCancelled.loadAcquire() == 1) {
+    return result;
+  }
 
-          important_msgs << *msg;
-        }
+  QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(metaObject()->className());
+  QJSEngine filter_engine;
+  MessageObject msg_obj(&database, feed, account, false);
+  MessageFilter fltr;
 
-        // Process changed labels.
-        for (Label* lbl : std::as_const(msg_backup.m_assignedLabels)) {
-          if (!msg->m_assignedLabels.contains(lbl)) {
-            // Label is not there anymore, it was deassigned.
-            lbl->deassignFromMessage(*msg);
+  fltr.setScript(script);
+  MessageFilter::initializeFilteringEngine(filter_engine, &msg_obj);
 
-            qDebugNN << LOGSEC_FEEDDOWNLOADER << "It was detected that label" << QUOTE_W_SPACE(lbl->customId())
-                     << "was DEASSIGNED from message" << QUOTE_W_SPACE(msg->m_customId) << "by message filter(s).";
-          }
-        }
+  QList<Message> msgs = DatabaseQueries::getUndeletedMessagesForFeed(database, feed->customId(), account->accountId());
 
-        for (Label* lbl : std::as_const(msg->m_assignedLabels)) {
-          if (!msg_backup.m_assignedLabels.contains(lbl)) {
-            // Label is in new message, but is not in old message, it
-            // was newly assigned.
-            lbl->assignToMessage(*msg);
+  for (Message& msg : msgs) {
+    if (m_filteringCancelled.loadAcquire() == 1) {
+      return result;
+    }
 
-            qDebugNN << LOGSEC_FEEDDOWNLOADER << "It was detected that label" << QUOTE_W_SPACE(lbl->customId())
-                     << "was ASSIGNED to message" << QUOTE_W_SPACE(msg->m_customId) << "by message filter(s).";
-          }
-        }
+    for (const QString& lbl_id : std::as_const(msg.m_assignedLabelsIds)) {
+      Label* lbl = labels.value(lbl_id);
 
-        if (remove_from_list) {
-          // Do not update message.
-          msgs.removeAt(i--);
-        }
+      if (lbl != nullptr) {
+        msg.m_assignedLabels.append(lbl);
       }
+    }
+
+    msg.m_rawContents = Message::generateRawAtomContents(msg);
+
+    // Create backup of message.
+    Message msg_backup(msg);
+
+    msg_obj.setMessage(&msg);
+
+    try {
+      MessageObject::FilteringAction decision = fltr.filterMessage(&filter_engine);
 
-      if (!read_msgs.isEmpty()) {
-        // Now we push new read states to the service.
-        if (it->getParentServiceRoot()->onBeforeSetMessagesRead(it, read_msgs, RootItem::ReadStatus::Read)) {
-          qDebugNN << LOGSEC_FEEDDOWNLOADER << "Notified services about messages marked as read by message filters.";
-        }
-        else {
-          qCriticalNN << LOGSEC_FEEDDOWNLOADER
-                      << "Notification of services about messages marked as read by message filters FAILED.";
-        }
+      if (decision == MessageObject::FilteringAction::Purge) {
+        // Purge the message completely and remove leftovers.
+        result.m_purgedMessageIds.append(QString::number(msg.m_id));
+        continue;
       }
+      else if (decision == MessageObject::FilteringAction::Ignore) {
+        continue;
+      }
+    }
+    catch (const FilteringException& ex) {
+      qCriticalNN << LOGSEC_CORE << "Error when running script when processing existing messages:"
+                  << QUOTE_W_SPACE_DOT(ex.message());
+
+      continue;
+    }
+
+    if (!msg_backup.m_isRead && msg.m_isRead) {
+      qDebugNN << LOGSEC_CORE << "Message with custom ID:" << QUOTE_W_SPACE(msg_backup.m_customId)
+               << "was marked as read by message scripts.";
+
+      result.m_readMessages << msg;
+    }
+
+    if (!msg_backup.m_isImportant && msg.m_isImportant) {
+      qDebugNN << LOGSEC_CORE << "Message with custom ID:" << QUOTE_W_SPACE(msg_backup.m_customId)
+               << "was marked as important by message scripts.";
+
+      result.m_importantMessages << msg;
+    }
+
+    // Label changes are stored together with the article.
+    for (Label* lbl : std::as_const(msg_backup.m_assignedLabels)) {
+      if (!msg.m_assignedLabels.contains(lbl)) {
+        msg.m_deassignedLabelsByFilter << lbl;
+      }
+    }
 
-      if (!important_msgs.isEmpty()) {
-        // Now we push new read states to the service.
-        auto list = boolinq::from(important_msgs)
-                      .select([](const Message& msg) {
-                        return ImportanceChange(msg, RootItem::Importance::Important);
-                      })
-                      .toStdList();
-        QList<ImportanceChange> chngs = FROM_STD_LIST(QList<ImportanceChange>, list);
-
-        if (it->getParentServiceRoot()->onBeforeSwitchMessageImportance(it, chngs)) {
-          qDebugNN << LOGSEC_FEEDDOWNLOADER
-                   << "Notified services about messages marked as important by message filters.";
-        }
-        else {
-          qCriticalNN << LOGSEC_FEEDDOWNLOADER
-                      << "Notification of services about messages marked as important by message filters FAILED.";
-        }
+    for (Label* lbl : std::as_const(msg.m_assignedLabels)) {
+      if (!msg_backup.m_assignedLabels.contains(lbl)) {
+        msg.m_assignedLabelsByFilter << lbl;
       }
+    }
+
+    // Only articles which were actually tweaked by the filter are written back.
+    if (msg.m_isRead != msg_backup.m_isRead || msg.m_isImportant != msg_backup.m_isImportant ||
+        msg.m_isDeleted != msg_backup.m_isDeleted || msg.m_title != msg_backup.m_title ||
+        msg.m_url != msg_backup.m_url || msg.m_author != msg_backup.m_author ||
+        msg.m_contents != msg_backup.m_contents || msg.m_created != msg_backup.m_created ||
+        !qFuzzyCompare(msg.m_score + 1.0, msg_backup.m_score + 1.0) || !msg.m_assignedLabelsByFilter.isEmpty() ||
+        !msg.m_deassignedLabelsByFilter.isEmpty()) {
+      result.m_changedMessages << msg;
+    }
+  }
+
+  return result;
+}
+
+void FormMessageFiltersManager::notifyServices(ServiceRoot* account, const QList<FilteredFeed>& results) {
+  for (const FilteredFeed& res : results) {
+    Feed* feed = res.m_feed;
 
-      // Update messages in DB and reload selection.
-      it->getParentServiceRoot()->updateMessages(msgs, it->toFeed(), true, nullptr);
-      displayMessagesOfFeed();
+    if (!res.m_readMessages.isEmpty()) {
+      // Now we push new read states to the service.
+      if (account->onBeforeSetMessagesRead(feed, res.m_readMessages, RootItem::ReadStatus::Read)) {
+        qDebugNN << LOGSEC_CORE << "Notified services about messages marked as read by message filters.";
+      }
+      else {
+        qCriticalNN << LOGSEC_CORE
+                    << "Notification of services about messages marked as read by message filters FAILED.";
+      }
+    }
+
+    if (!res.m_importantMessages.isEmpty()) {
+      // Now we push new read states to the service.
+      auto list = boolinq::from(res.m_importantMessages)
+                    .select([](const Message& msg) {
+                      return ImportanceChange(msg, RootItem::Importance::Important);
+                    })
+                    .toStdList();
+      QList<ImportanceChange> chngs = FROM_STD_LIST(QList<ImportanceChange>, list);
+
+      if (account->onBeforeSwitchMessageImportance(feed, chngs)) {
+        qDebugNN << LOGSEC_CORE << "Notified services about messages marked as important by message filters.";
+      }
+      else {
+        qCriticalNN << LOGSEC_CORE
+                    << "Notification of services about messages marked as important by message filters FAILED.";
+      }
     }
   }
 }
 
+bool FormMessageFiltersManager::storeFilteredFeeds(int account_id, const QList<FilteredFeed>& results) {
+  QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(QSL("FormMessageFiltersManager"));
+  QStringList purged_ids;
+
+  for (const FilteredFeed& res : results) {
+    purged_ids.append(res.m_purgedMessageIds);
+  }
+
+  // Either all changes made by the filter are stored or none of them.
+  if (!database.transaction()) {
+    qCriticalNN << LOGSEC_CORE << "Failed to start transaction for articles changed by article filter:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    return false;
+  }
+
+  try {
+    if (!purged_ids.isEmpty() && !DatabaseQueries::purgeMessages(database, purged_ids)) {
+      throw ApplicationException(QSL("articles removed by filter were not purged"));
+    }
+
+    for (const FilteredFeed& res : results) {
+      if (res.m_changedMessages.isEmpty()) {
+        continue;
+      }
+
+      QList<Message> msgs = res.m_changedMessages;
+      bool ok = false;
+
+      DatabaseQueries::updateMessages(database, msgs, res.m_feed, true, nullptr, &ok);
+
+      if (!ok) {
+        throw ApplicationException(QSL("articles of feed '%1' were not stored").arg(res.m_feed->customId()));
+      }
+    }
+
+    // Changed articles are subject to article limits of their feeds, same as fetched articles.
+    int removed =
+      DatabaseQueries::removeUnwantedArticles(database, {account_id}, Feed::ArticleIgnoreLimit::fromSettings());
+
+    qDebugNN << LOGSEC_CORE << "Article limits recycled/purged" << NONQUOTE_W_SPACE(removed)
+             << "articles after filtering.";
+
+    if (!database.commit()) {
+      throw ApplicationException(database.lastError().text());
+    }
+  }
+  catch (const ApplicationException& ex) {
+    database.rollback();
+
+    qCriticalNN << LOGSEC_CORE << "Failed to store articles changed by article filter, no articles were changed:"
+                << QUOTE_W_SPACE_DOT(ex.message());
+    return false;
+  }
+
+  qDebugNN << LOGSEC_CORE << "Article filter purged" << NONQUOTE_W_SPACE(purged_ids.size())
+           << "articles in total.";
+  return true;
+}
+
 void FormMessageFiltersManager::loadAccount(ServiceRoot* account) {
   m_feedsModel->setRootItem(account, false, true);
 
@@ -8,6 +8,7 @@
 #include "ui_formmessagefiltersmanager.h"
 
 #include <QDialog>
+#include <QFutureWatcher>
 
 class AccountCheckSortedModel;
 class MessageFilter;
@@ -18,6 +19,16 @@ class JsSyntaxHighlighter;
 class FormMessageFiltersManager : public QDialog {
     Q_OBJECT
 
+    // Outcome of running filter over stored articles of single feed.
+    // Nothing is written to DB until all feeds are filtered.
+    struct FilteredFeed {
+        Feed* m_feed = nullptr;
+        QList<Message> m_changedMessages;
+        QList<Message> m_readMessages;
+        QList<Message> m_importantMessages;
+        QStringList m_purgedMessageIds;
+    };
+
   public:
     explicit FormMessageFiltersManager(FeedReader* reader,
                                        const QList<ServiceRoot*>& accounts,
@@ -41,6 +52,8 @@ class FormMessageFiltersManager : public QDialog {
     void testFilter();
     void displayMessagesOfFeed();
     void processCheckedFeeds();
+    void onFeedsFiltered();
+    void onFilteredFeedsStored();
 
     // Load feeds/categories tree.
     void loadAccount(ServiceRoot* account);
@@ -62,6 +75,22 @@ class FormMessageFiltersManager : public QDialog {
     void initializePremadeFilters();
     void initializeTestingMessage();
 
+    void setFilteringRunning(bool running);
+
+    // Runs given filter script over all undeleted articles of the feed.
+    // Called from work-horse pool threads.
+    FilteredFeed filterFeed(Feed* feed,
+                            ServiceRoot* account,
+                            const QString& script,
+                            const QHash<QString, Label*>& labels) const;
+
+    // Pushes changed read/important states to the service. Called from GUI thread.
+    static void notifyServices(ServiceRoot* account, const QList<FilteredFeed>& results);
+
+    // Writes results of all filtered feeds in single transaction and applies
+    // article limits of feeds. Called from work-horse pool thread.
+    static bool storeFilteredFeeds(int account_id, const QList<FilteredFeed>& results);
+
     RootItem* selectedCategoryFeed() const;
     Message testingMessage() const;
 
@@ -74,6 +103,10 @@ class FormMessageFiltersManager : public QDialog {
     bool m_loadingFilter;
     MessagesForFiltersModel* m_msgModel;
     JsSyntaxHighlighter* m_highlighter;
+    ServiceRoot* m_filteredAccount;
+    QAtomicInt m_filteringCancelled;
+    QFutureWatcher<FilteredFeed> m_watcherFiltering;
+    QFutureWatcher<bool> m_watcherStoring;
 };
 
 #endif // FORMMESSAGEFILTERSMANAGER_H
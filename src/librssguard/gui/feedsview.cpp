@@ -755,27 +755,13 @@ void FeedsView::filterItems(SearchLineEdit::SearchMode mode,
 
   qDebugNN << LOGSEC_GUI << "Running search of feeds with pattern" << QUOTE_W_SPACE_DOT(phrase);
 
-  switch (mode) {
-    case SearchLineEdit::SearchMode::Wildcard:
-      m_proxyModel->setFilterWildcard(phrase);
-      break;
-
-    case SearchLineEdit::SearchMode::RegularExpression:
-      m_proxyModel->setFilterRegularExpression(phrase);
-      break;
-
-    case SearchLineEdit::SearchMode::FixedString:
-    default:
-      m_proxyModel->setFilterFixedString(phrase);
-      break;
-  }
-
-  m_proxyModel->setFilterCaseSensitivity(sensitivity);
-
   FeedsToolBar::SearchFields where_search = FeedsToolBar::SearchFields(custom_criteria);
 
-  m_proxyModel->setFilterKeyColumn(where_search == FeedsToolBar::SearchFields::SearchTitleOnly ? FDS_MODEL_TITLE_INDEX
-                                                                                               : -1);
+  // NOTE: Set all criteria at once, so that items are filtered only once.
+  m_proxyModel->setFilter(mode,
+                          sensitivity,
+                          where_search == FeedsToolBar::SearchFields::SearchTitleOnly,
+                          phrase);
 
   if (phrase.isEmpty()) {
     loadAllExpandStates();
@@ -182,7 +182,6 @@ void MessagesView::sort(int column,
   }
 
   m_sourceModel->addSortState(column, order, ignore_multicolumn_sorting);
-  m_proxyModel->setAdditionalArticleId(additional_article_id);
 
   if (repopulate_data) {
     m_sourceModel->repopulate(additional_article_id);
@@ -233,25 +232,16 @@ void MessagesView::reloadSelections() {
       current_index = QModelIndex();
     }
     else {
-      for (int i = 0; i < m_proxyModel->rowCount(); i++) {
-        QModelIndex msg_idx = m_proxyModel->index(i, MSG_DB_TITLE_INDEX);
-        QModelIndex msg_source_idx = m_proxyModel->mapToSource(msg_idx);
-        int msg_id = m_sourceModel->data(msg_source_idx.row(), MSG_DB_ID_INDEX, Qt::ItemDataRole::EditRole).toInt();
+      const int msg_source_row = m_sourceModel->rowOfMessage(selected_message_id);
 
-        if (msg_id == selected_message_id) {
-          current_index = msg_idx;
+      current_index =
+        msg_source_row < 0
+          ? QModelIndex()
+          : m_proxyModel->mapFromSource(m_sourceModel->index(msg_source_row, MSG_DB_TITLE_INDEX));
 
-          if (!m_sourceModel->data(msg_source_idx.row(), MSG_DB_READ_INDEX, Qt::ItemDataRole::EditRole)
-                 .toBool() /* && selected_message.m_isRead */) {
-            do_not_mark_read_on_select = true;
-          }
-
-          break;
-        }
-
-        if (i == m_proxyModel->rowCount() - 1) {
-          current_index = QModelIndex();
-        }
+      if (current_index.isValid() &&
+          !m_sourceModel->data(msg_source_row, MSG_DB_READ_INDEX, Qt::ItemDataRole::EditRole).toBool()) {
+        do_not_mark_read_on_select = true;
       }
     }
   }
@@ -38,6 +38,14 @@ SettingsDatabase::SettingsDatabase(Settings* settings, QWidget* parent)
                      "Authors of this application are NOT responsible for lost data."),
                   true);
 
+  m_ui->m_lblCompressArticleContents
+    ->setHelpText(tr("Contents of new and updated articles are stored compressed, which makes database "
+                     "considerably smaller. Articles are decompressed only when they are displayed or searched.\n"
+                     "\n"
+                     "Contents of already stored articles are compressed when database is shrinked "
+                     "via \"Cleanup database\" dialog."),
+                  false);
+
   m_ui->m_txtMysqlPassword->lineEdit()->setPasswordMode(true);
 
   connect(m_ui->m_cmbDatabaseDriver,
@@ -45,6 +53,7 @@ SettingsDatabase::SettingsDatabase(Settings* settings, QWidget* parent)
           this,
           &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_checkSqliteUseInMemoryDatabase, &QCheckBox::toggled, this, &SettingsDatabase::dirtifySettings);
+  connect(m_ui->m_checkCompressArticleContents, &QCheckBox::toggled, this, &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_txtMysqlDatabase->lineEdit(), &QLineEdit::textChanged, this, &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_txtMysqlHostname->lineEdit(), &QLineEdit::textChanged, this, &SettingsDatabase::dirtifySettings);
   connect(m_ui->m_txtMysqlPassword->lineEdit(), &QLineEdit::textChanged, this, &SettingsDatabase::dirtifySettings);
@@ -179,6 +188,9 @@ void SettingsDatabase::loadSettings() {
   m_ui->m_checkSqliteUseInMemoryDatabase
     ->setChecked(settings()->value(GROUP(Database), SETTING(Database::UseInMemory)).toBool());
 
+  m_ui->m_checkCompressArticleContents
+    ->setChecked(settings()->value(GROUP(Database), SETTING(Database::CompressArticleContents)).toBool());
+
   auto* mysq_driver = qApp->database()->driverForType(DatabaseDriver::DriverType::MySQL);
 
   if (mysq_driver != nullptr) {
@@ -240,6 +252,9 @@ void SettingsDatabase::saveSettings() {
     settings()->setValue(GROUP(Database), Database::MySQLPort, m_ui->m_spinMysqlPort->value());
   }
 
+  settings()->setValue(GROUP(Database),
+                       Database::CompressArticleContents,
+                       m_ui->m_checkCompressArticleContents->isChecked());
   settings()->setValue(GROUP(Database), Database::ActiveDriver, selected_db_driver);
 
   if (original_db_driver != selected_db_driver || original_inmemory != new_inmemory) {
@@ -0,0 +1,191 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "gui/webviewers/qtextbrowser/textbrowserresourceloader.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/application.h"
+#include "network-web/silentnetworkaccessmanager.h"
+#include "network-web/webfactory.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QThread>
+
+TextBrowserResourceLoader* TextBrowserResourceLoader::s_instance = nullptr;
+QThread* TextBrowserResourceLoader::s_thread = nullptr;
+int TextBrowserResourceLoader::s_users = 0;
+
+TextBrowserResourceLoader* TextBrowserResourceLoader::acquire() {
+  if (s_instance == nullptr) {
+    s_instance = new TextBrowserResourceLoader();
+    s_thread = new QThread();
+
+    s_instance->moveToThread(s_thread);
+    connect(s_thread, &QThread::finished, s_instance, &QObject::deleteLater);
+
+    s_thread->start(QThread::Priority::LowPriority);
+  }
+
+  s_users++;
+  return s_instance;
+}
+
+void TextBrowserResourceLoader::release() {
+  if (--s_users > 0) {
+    return;
+  }
+
+  s_thread->quit();
+  s_thread->wait();
+
+  delete s_thread;
+
+  s_thread = nullptr;
+  s_instance = nullptr;
+}
+
+TextBrowserResourceLoader::TextBrowserResourceLoader(QObject* parent)
+  : QObject(parent), m_network(new SilentNetworkAccessManager(this)) {
+  auto* cache = new QNetworkDiskCache(m_network);
+
+  // NOTE: Cached images are revalidated by network manager
+  // according to their HTTP caching headers.
+  cache->setCacheDirectory(qApp->cacheFolder() + QDir::separator() + QSL(RESOURCES_DISK_CACHE_FOLDER));
+  cache->setMaximumCacheSize(RESOURCES_DISK_CACHE_SIZE);
+
+  m_network->setCache(cache);
+}
+
+void TextBrowserResourceLoader::loadResources(int requester, const QList<QUrl>& urls, int desired_width) {
+  // Abort downloads for article previously displayed by this requester.
+  for (auto it = m_running.begin(); it != m_running.end();) {
+    if (it.value().m_requester == requester) {
+      QNetworkReply* reply = it.key();
+
+      it = m_running.erase(it);
+      reply->abort();
+    }
+    else {
+      it++;
+    }
+  }
+
+  for (int i = 0; i < m_pending.size(); i++) {
+    if (m_pending.at(i).m_requester == requester) {
+      m_pending.removeAt(i--);
+    }
+  }
+
+  for (const QUrl& url : urls) {
+    m_pending.append({requester, url, 0});
+  }
+
+  if (urls.isEmpty()) {
+    m_desiredWidths.remove(requester);
+  }
+  else {
+    m_desiredWidths.insert(requester, desired_width);
+  }
+
+  startNextDownloads();
+
+  if (!hasDownloads(requester)) {
+    emit allResourcesLoaded(requester);
+  }
+}
+
+void TextBrowserResourceLoader::startNextDownloads() {
+  while (!m_pending.isEmpty() && m_running.size() < RESOURCES_PARALLEL_DOWNLOADS) {
+    const Download download = m_pending.takeFirst();
+
+    startDownload(download, QUrl(WebFactory::unescapeHtml(download.m_url.toString())));
+  }
+}
+
+bool TextBrowserResourceLoader::hasDownloads(int requester) const {
+  for (const Download& download : m_pending) {
+    if (download.m_requester == requester) {
+      return true;
+    }
+  }
+
+  for (const Download& download : m_running) {
+    if (download.m_requester == requester) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void TextBrowserResourceLoader::startDownload(const Download& download, const QUrl& target_url) {
+  QNetworkRequest request(target_url);
+
+  request.setAttribute(QNetworkRequest::Attribute::CacheLoadControlAttribute,
+                       QNetworkRequest::CacheLoadControl::PreferNetwork);
+
+#if QT_VERSION >= 0x050F00 // Qt >= 5.15.0
+  request.setTransferTimeout(RESOURCES_DOWNLOAD_TIMEOUT);
+#endif
+
+  QNetworkReply* reply = m_network->get(request);
+
+  m_running.insert(reply, download);
+  connect(reply, &QNetworkReply::finished, this, &TextBrowserResourceLoader::replyFinished);
+}
+
+void TextBrowserResourceLoader::replyFinished() {
+  auto* reply = qobject_cast<QNetworkReply*>(sender());
+
+  reply->deleteLater();
+
+  if (!m_running.contains(reply)) {
+    // This download was aborted.
+    return;
+  }
+
+  Download download = m_running.take(reply);
+  const QUrl redirect = reply->attribute(QNetworkRequest::Attribute::RedirectionTargetAttribute).toUrl();
+
+  if (reply->error() == QNetworkReply::NetworkError::NoError && redirect.isValid() &&
+      download.m_redirects < MAX_NUMBER_OF_REDIRECTIONS) {
+    download.m_redirects++;
+    startDownload(download, reply->url().resolved(redirect));
+    return;
+  }
+
+  const int desired_width = m_desiredWidths.value(download.m_requester);
+  QImage image;
+  QImage scaled_image;
+
+  if (reply->error() == QNetworkReply::NetworkError::NoError) {
+    QElapsedTimer tmr;
+
+    tmr.start();
+    image = QImage::fromData(reply->readAll());
+
+    if (desired_width > 0 && image.width() > desired_width) {
+      scaled_image = image.scaledToWidth(desired_width, Qt::TransformationMode::SmoothTransformation);
+    }
+
+    qDebugNN << LOGSEC_GUI << "Picture" << QUOTE_W_SPACE(download.m_url) << "decoded in"
+             << NONQUOTE_W_SPACE(tmr.elapsed()) << "miliseconds, loaded from cache:"
+             << QUOTE_W_SPACE_DOT(reply->attribute(QNetworkRequest::Attribute::SourceIsFromCacheAttribute).toBool());
+  }
+  else {
+    qWarningNN << LOGSEC_GUI << "Failed to download picture" << QUOTE_W_SPACE(download.m_url)
+               << "with error:" << QUOTE_W_SPACE_DOT(reply->errorString());
+  }
+
+  emit resourceLoaded(download.m_requester, download.m_url, image, desired_width, scaled_image);
+
+  startNextDownloads();
+
+  if (!hasDownloads(download.m_requester)) {
+    m_desiredWidths.remove(download.m_requester);
+    emit allResourcesLoaded(download.m_requester);
+  }
+}
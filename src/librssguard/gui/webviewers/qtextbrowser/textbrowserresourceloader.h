@@ -0,0 +1,72 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef TEXTBROWSERRESOURCELOADER_H
+#define TEXTBROWSERRESOURCELOADER_H
+
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QObject>
+#include <QUrl>
+
+class SilentNetworkAccessManager;
+class QNetworkReply;
+class QThread;
+
+// Downloads images of articles displayed in TextBrowserViewer.
+// This object lives in its own thread, images are downloaded in parallel,
+// cached on disk and decoded and down-scaled before they are handed over to GUI.
+//
+// NOTE: Single loader (and thus single disk cache) is shared by all viewers,
+// each viewer identifies its downloads with its own requester ID.
+class RSSGUARD_DLLSPEC TextBrowserResourceLoader : public QObject {
+    Q_OBJECT
+
+  public:
+    // Returns shared loader and registers new user of it. Loader is destroyed
+    // when its last user releases it. Must be called from GUI thread.
+    static TextBrowserResourceLoader* acquire();
+    static void release();
+
+  public slots:
+    // Cancels running downloads of given requester and starts downloading new resources.
+    // Images wider than "desired_width" are also provided in down-scaled variant.
+    void loadResources(int requester, const QList<QUrl>& urls, int desired_width);
+
+  signals:
+    // Image is null if it failed to download or decode.
+    void resourceLoaded(int requester,
+                        const QUrl& url,
+                        const QImage& image,
+                        int scaled_width,
+                        const QImage& scaled_image);
+    void allResourcesLoaded(int requester);
+
+  private slots:
+    void replyFinished();
+
+  private:
+    explicit TextBrowserResourceLoader(QObject* parent = nullptr);
+
+    struct Download {
+        int m_requester = 0;
+        QUrl m_url;
+        int m_redirects = 0;
+    };
+
+    void startDownload(const Download& download, const QUrl& target_url);
+    void startNextDownloads();
+    bool hasDownloads(int requester) const;
+
+  private:
+    SilentNetworkAccessManager* m_network;
+    QList<Download> m_pending;
+    QHash<QNetworkReply*, Download> m_running;
+    QHash<int, int> m_desiredWidths;
+
+    static TextBrowserResourceLoader* s_instance;
+    static QThread* s_thread;
+    static int s_users;
+};
+
+#endif // TEXTBROWSERRESOURCELOADER_H
@@ -3,9 +3,11 @@
 #include "gui/webviewers/qtextbrowser/textbrowserviewer.h"
 
 #include "3rd-party/boolinq/boolinq.h"
+#include "definitions/definitions.h"
 #include "definitions/globals.h"
 #include "gui/dialogs/formmain.h"
 #include "gui/webbrowser.h"
+#include "gui/webviewers/qtextbrowser/textbrowserresourceloader.h"
 #include "miscellaneous/application.h"
 #include "miscellaneous/externaltool.h"
 #include "miscellaneous/iconfactory.h"
@@ -24,8 +26,8 @@
 #include <QtConcurrent>
 
 TextBrowserViewer::TextBrowserViewer(QWidget* parent)
-  : QTextBrowser(parent), m_resourcesEnabled(false), m_resourceDownloader(new Downloader()),
-    m_resourceDownloaderThread(new QThread(this)), m_loadedResources({}),
+  : QTextBrowser(parent), m_resourcesEnabled(false), m_resourceLoader(TextBrowserResourceLoader::acquire()),
+    m_resourceRequester(0), m_loadedResources(RESOURCES_MEMORY_CACHE_SIZE),
     m_placeholderImage(qApp->icons()->miscPixmap(QSL("image-placeholder"))),
     m_placeholderImageError(qApp->icons()->miscPixmap(QSL("image-placeholder-error"))),
     m_downloader(new Downloader(this)), m_document(new TextBrowserDocument(this)) {
@@ -41,8 +43,9 @@ TextBrowserViewer::TextBrowserViewer(QWidget* parent)
   setResourcesEnabled(qApp->settings()->value(GROUP(Messages), SETTING(Messages::ShowResourcesInArticles)).toBool());
   setDocument(m_document.data());
 
-  m_resourceDownloader->moveToThread(m_resourceDownloaderThread);
-  m_resourceDownloaderThread->start(QThread::Priority::LowPriority);
+  static int requester_counter = 0;
+
+  m_resourceRequester = ++requester_counter;
 
   connect(this, &TextBrowserViewer::reloadDocument, this, [this]() {
     const auto scr = verticalScrollBarPosition();
@@ -50,17 +53,30 @@ TextBrowserViewer::TextBrowserViewer(QWidget* parent)
     setVerticalScrollBarPosition(scr);
   });
 
-  connect(m_resourceDownloader, &Downloader::completed, this, &TextBrowserViewer::resourceDownloaded);
+  connect(m_resourceLoader, &TextBrowserResourceLoader::resourceLoaded, this, &TextBrowserViewer::resourceLoaded);
+  connect(m_resourceLoader, &TextBrowserResourceLoader::allResourcesLoaded, this, [this](int requester) {
+    if (requester == m_resourceRequester) {
+      emit reloadDocument();
+    }
+  });
   connect(this, &QTextBrowser::anchorClicked, this, &TextBrowserViewer::onAnchorClicked);
   connect(this, QOverload<const QUrl&>::of(&QTextBrowser::highlighted), this, &TextBrowserViewer::linkMouseHighlighted);
 }
 
 TextBrowserViewer::~TextBrowserViewer() {
-  if (m_resourceDownloaderThread->isRunning()) {
-    m_resourceDownloaderThread->quit();
-  }
+  TextBrowserResourceLoader* loader = m_resourceLoader;
+  const int requester = m_resourceRequester;
 
-  m_resourceDownloader->deleteLater();
+  // Cancel downloads of this viewer, shared loader keeps running for other viewers.
+  disconnect(m_resourceLoader, nullptr, this, nullptr);
+  QMetaObject::invokeMethod(
+    m_resourceLoader,
+    [loader, requester]() {
+      loader->loadResources(requester, {}, 0);
+    },
+    Qt::ConnectionType::QueuedConnection);
+
+  TextBrowserResourceLoader::release();
 }
 
 QSize TextBrowserViewer::sizeHint() const {
@@ -77,40 +93,33 @@ QVariant TextBrowserViewer::loadOneResource(int type, const QUrl& name) {
 
   auto resolved_name = (m_currentUrl.isValid() && name.isRelative()) ? m_currentUrl.resolved(name) : name;
 
-  if (!m_resourcesEnabled || !m_loadedResources.contains(resolved_name)) {
-    // Resources are not enabled.
+  LoadedResource* resource = m_resourcesEnabled ? m_loadedResources.object(resolved_name) : nullptr;
+
+  if (resource == nullptr) {
+    // Resources are not enabled or resource is not loaded yet.
     return m_placeholderImage;
   }
 
   // Resources are enabled and we already have the resource.
   int acceptable_width = int(width() * ACCEPTABLE_IMAGE_PERCENTUAL_WIDTH);
 
-  QMap<int, QByteArray>& resource_data_all_sizes = m_loadedResources[resolved_name];
-  QImage img;
+  const QMap<int, QImage>& resource_all_sizes = resource->m_sizes;
 
   qDebugNN << LOGSEC_GUI << "Picture" << QUOTE_W_SPACE(name)
-           << "has these sizes cached:" << NONQUOTE_W_SPACE_DOT(resource_data_all_sizes.keys());
+           << "has these sizes cached:" << NONQUOTE_W_SPACE_DOT(resource_all_sizes.keys());
 
-  if (resource_data_all_sizes.isEmpty()) {
-    img = m_placeholderImageError.toImage();
+  if (resource_all_sizes.value(0).isNull()) {
+    return m_placeholderImageError;
   }
-  else {
-    // Now, we either select specifically sized picture, or default one.
-    QByteArray resource_data;
 
-    if (resource_data_all_sizes.contains(acceptable_width)) {
-      // We have picture with this exact size. The picture was likely downsized
-      // to this size before.
-      resource_data = resource_data_all_sizes.value(acceptable_width);
-    }
-    else {
-      // We only have default size or not desired size. Return initial picture.
-      resource_data = resource_data_all_sizes.value(0);
-    }
-
-    img = QImage::fromData(resource_data);
+  if (resource_all_sizes.contains(acceptable_width)) {
+    // We have picture with this exact size. The picture was likely downsized
+    // to this size before.
+    return resource_all_sizes.value(acceptable_width);
   }
 
+  // We only have default size or not desired size. Use initial picture.
+  QImage img = resource_all_sizes.value(0);
   int img_width = img.width();
 
   if (img_width > acceptable_width) {
@@ -123,25 +132,11 @@ QVariant TextBrowserViewer::loadOneResource(int type, const QUrl& name) {
                << "is too wide, down-scaling to prevent horizontal scrollbars. Scaling took"
                << NONQUOTE_W_SPACE(tmr.elapsed()) << "miliseconds.";
 
-    QByteArray save_arr;
-    QBuffer save_buf(&save_arr, this);
+    // NOTE: Entry is re-inserted, so that its cost is updated.
+    auto* scaled_resource = new LoadedResource(*resource);
 
-    if (img.save(&save_buf, "JPG", 100)) {
-      save_buf.close();
-
-      /*
-      IOFactory::writeFile(QSL("%1%2.jpg")
-                             .arg(name.toString(QUrl::ComponentFormattingOption::FullyEncoded),
-                                  QString::number(acceptable_width))
-                             .remove(QRegularExpression(":|\\/")),
-                           save_arr);
-*/
-
-      resource_data_all_sizes.insert(acceptable_width, save_arr);
-    }
-    else {
-      qWarningNN << LOGSEC_GUI << "Failed to save modified image" << QUOTE_W_SPACE(name) << "to cache.";
-    }
+    scaled_resource->m_sizes.insert(acceptable_width, img);
+    cacheResource(resolved_name, scaled_resource);
   }
 
   return img;
@@ -536,56 +531,60 @@ QVariant TextBrowserDocument::loadResource(int type, const QUrl& name) {
 
 void TextBrowserViewer::reloadHtmlDelayed() {
   if (!m_neededResources.isEmpty()) {
-    downloadNextNeededResource();
+    const QList<QUrl> urls = m_neededResources;
+    const int acceptable_width = int(width() * ACCEPTABLE_IMAGE_PERCENTUAL_WIDTH);
+    const int requester = m_resourceRequester;
+    TextBrowserResourceLoader* loader = m_resourceLoader;
+
+    m_neededResources.clear();
+
+    QMetaObject::invokeMethod(
+      m_resourceLoader,
+      [loader, requester, urls, acceptable_width]() {
+        loader->loadResources(requester, urls, acceptable_width);
+      },
+      Qt::ConnectionType::QueuedConnection);
   }
 }
 
-void TextBrowserViewer::downloadNextNeededResource() {
-  if (m_neededResources.isEmpty()) {
-    // Everything is downloaded.
-    emit reloadDocument();
+void TextBrowserViewer::resourceLoaded(int requester,
+                                       const QUrl& url,
+                                       const QImage& image,
+                                       int scaled_width,
+                                       const QImage& scaled_image) {
+  if (requester != m_resourceRequester) {
+    return;
   }
-  else {
-    QUrl res = m_neededResources.takeFirst();
 
-    QMetaObject::invokeMethod(m_resourceDownloader,
-                              "manipulateData",
-                              Qt::ConnectionType::QueuedConnection,
-                              Q_ARG(QString, WebFactory::unescapeHtml(res.toString())),
-                              Q_ARG(QNetworkAccessManager::Operation, QNetworkAccessManager::Operation::GetOperation),
-                              Q_ARG(QByteArray, {}),
-                              Q_ARG(int, 5000));
+  auto* resource = new LoadedResource();
 
-    /*
-m_resourceDownloader.data()->manipulateData(qApp->web()->unescapeHtml(res.toString()),
-                                            QNetworkAccessManager::Operation::GetOperation,
-                                            {},
-                                            5000);
-                                                */
-  }
-}
+  resource->m_sizes.insert(0, image);
 
-void TextBrowserViewer::resourceDownloaded(const QUrl& url,
-                                           QNetworkReply::NetworkError status,
-                                           int http_code,
-                                           const QByteArray& contents) {
-  Q_UNUSED(http_code)
-  if (!m_loadedResources.contains(url)) {
-    m_loadedResources.insert(url, QMap<int, QByteArray>());
+  if (!scaled_image.isNull()) {
+    resource->m_sizes.insert(scaled_width, scaled_image);
   }
 
-  QMap<int, QByteArray>& resource_data_all_sizes = m_loadedResources[url];
+  cacheResource(url, resource);
+}
 
-  resource_data_all_sizes.clear();
+void TextBrowserViewer::cacheResource(const QUrl& url, LoadedResource* resource) {
+  const int cost = resource->cost();
 
-  if (status == QNetworkReply::NetworkError::NoError) {
-    resource_data_all_sizes.insert(0, contents);
+  if (!m_loadedResources.insert(url, resource, cost)) {
+    qWarningNN << LOGSEC_GUI << "Picture" << QUOTE_W_SPACE(url) << "with size" << QUOTE_W_SPACE(cost)
+               << "bytes does not fit into memory cache.";
   }
-  else {
-    resource_data_all_sizes.insert(0, {});
+}
+
+int TextBrowserViewer::LoadedResource::cost() const {
+  qint64 bytes = 0;
+
+  for (const QImage& img : m_sizes) {
+    bytes += img.sizeInBytes();
   }
 
-  downloadNextNeededResource();
+  // NOTE: Even failed resources occupy some memory.
+  return qMax(1, int(bytes));
 }
 
 PreparedHtml TextBrowserViewer::prepareLegacyHtmlForMessage(const QList<Message>& messages,
@@ -618,8 +617,7 @@ PreparedHtml TextBrowserViewer::prepareLegacyHtmlForMessage(const QList<Message>
     // Display enclosures which are pictures if user has it enabled.
     auto first_enc_break_added = false;
 
-    if (acc_displays_enclosures &&
-        qApp->settings()->value(GROUP(Messages), SETTING(Messages::DisplayEnclosuresInMessage)).toBool()) {
+    if (acc_displays_enclosures && qApp->settings()->snapshot()->m_displayEnclosuresInMessage) {
       for (const Enclosure& enc : message.m_enclosures) {
         if (enc.m_mimeType.startsWith(QSL("image/"))) {
           if (!first_enc_break_added) {
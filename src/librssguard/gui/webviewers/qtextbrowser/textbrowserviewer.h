@@ -6,6 +6,7 @@
 #include "gui/webviewers/webviewer.h"
 #include "network-web/adblock/adblockmanager.h"
 
+#include <QCache>
 #include <QNetworkReply>
 #include <QPixmap>
 #include <QPointer>
@@ -16,6 +17,7 @@ class QContextMenuEvent;
 class QResizeEvent;
 class WebBrowser;
 class Downloader;
+class TextBrowserResourceLoader;
 
 class TextBrowserViewer;
 
@@ -74,11 +76,11 @@ class RSSGUARD_DLLSPEC TextBrowserViewer : public QTextBrowser, public WebViewer
     void downloadLink();
     void onAnchorClicked(const QUrl& url);
     void reloadHtmlDelayed();
-    void downloadNextNeededResource();
-    void resourceDownloaded(const QUrl& url,
-                            QNetworkReply::NetworkError status,
-                            int http_code,
-                            const QByteArray& contents = QByteArray());
+    void resourceLoaded(int requester,
+                        const QUrl& url,
+                        const QImage& image,
+                        int scaled_width,
+                        const QImage& scaled_image);
 
   signals:
     void reloadDocument();
@@ -100,15 +102,25 @@ class RSSGUARD_DLLSPEC TextBrowserViewer : public QTextBrowser, public WebViewer
 
     QString decodeHtmlData(const QByteArray& data, const QString& content_type) const;
 
+    // Contains list of precisely sized decoded images of single url,
+    // image with size "0" is the original one.
+    struct LoadedResource {
+        QMap<int, QImage> m_sizes;
+
+        int cost() const;
+    };
+
+    void cacheResource(const QUrl& url, LoadedResource* resource);
+
   private:
     QScopedPointer<Downloader> m_downloader;
     bool m_resourcesEnabled;
     QList<QUrl> m_neededResources; // All URLs here must be resolved.
-    Downloader* m_resourceDownloader;
-    QThread* m_resourceDownloaderThread;
+    TextBrowserResourceLoader* m_resourceLoader;
+    int m_resourceRequester;
 
-    // Contains list of precisely sized images per each url.
-    QMap<QUrl, QMap<int, QByteArray>> m_loadedResources; // All URLs here must be resolved.
+    // Decoded images, cost of each entry is size of all its images in bytes.
+    QCache<QUrl, LoadedResource> m_loadedResources; // All URLs here must be resolved.
     QPixmap m_placeholderImage;
     QPixmap m_placeholderImageError;
     QUrl m_currentUrl;
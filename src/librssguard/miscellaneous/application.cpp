@@ -28,6 +28,7 @@
 #include "miscellaneous/mutex.h"
 #include "miscellaneous/notificationfactory.h"
 #include "miscellaneous/settings.h"
+#include "miscellaneous/tracer.h"
 #include "network-web/adblock/adblockicon.h"
 #include "network-web/adblock/adblockmanager.h"
 #include "network-web/webfactory.h"
@@ -1285,6 +1286,10 @@ void Application::parseCmdArgumentsFromMyInstance(const QStringList& raw_cli_arg
     QLoggingCategory::setFilterRules(QSL("*.debug=false"));
   }
 
+  if (m_cmdParser.isSet(QSL(CLI_TRACE))) {
+    Tracer::setEnabled(true);
+  }
+
   if (!m_cmdParser.value(QSL(CLI_DAT_SHORT)).isEmpty()) {
     auto data_folder = QDir::toNativeSeparators(m_cmdParser.value(QSL(CLI_DAT_SHORT)));
 
@@ -1390,12 +1395,16 @@ void Application::fillCmdArgumentsParser(QCommandLineParser& parser) {
                                       .arg(MAX_THREADPOOL_THREADS),
                                     QSL("count"));
 
+  QCommandLineOption trace(QSL(CLI_TRACE),
+                           QSL("Collect timings of feed fetching and database operations. Collected data are "
+                               "available via API server."));
+
   parser.addOptions({
     help, version, log_file, custom_data_folder, disable_singleinstance, disable_only_debug, disable_debug,
 #if defined(NO_LITE)
       force_lite,
 #endif
-      forced_style, adblock_port, custom_ua, custom_threads
+      forced_style, adblock_port, custom_ua, custom_threads, trace
   });
   parser.addPositionalArgument(QSL("urls"),
                                QSL("List of URL addresses pointing to individual online feeds which should be added."),
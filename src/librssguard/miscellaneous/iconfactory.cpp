@@ -2,13 +2,18 @@
 
 #include "miscellaneous/iconfactory.h"
 
+#include "database/databasequeries.h"
 #include "miscellaneous/application.h"
 #include "miscellaneous/settings.h"
 
 #include <QBuffer>
+#include <QCryptographicHash>
 #include <QPainter>
+#include <QThread>
 
-IconFactory::IconFactory(QObject* parent) : QObject(parent) {}
+IconFactory::IconFactory(QObject* parent) : QObject(parent) {
+  m_storeCache.setMaxCost(ICON_STORE_CACHE_SIZE);
+}
 
 IconFactory::~IconFactory() {
   qDebugNN << LOGSEC_GUI << "Destroying IconFactory instance.";
@@ -29,11 +34,18 @@ QIcon IconFactory::generateIcon(const QColor& color) {
 }
 
 QIcon IconFactory::fromByteArray(QByteArray array) {
+  return fromRawData(QByteArray::fromBase64(array));
+}
+
+QByteArray IconFactory::toByteArray(const QIcon& icon) {
+  return toRawData(icon).toBase64();
+}
+
+QIcon IconFactory::fromRawData(QByteArray array) {
   if (array.isEmpty()) {
     return {};
   }
 
-  array = QByteArray::fromBase64(array);
   QIcon icon;
   QBuffer buffer(&array);
 
@@ -46,7 +58,7 @@ QIcon IconFactory::fromByteArray(QByteArray array) {
   return icon;
 }
 
-QByteArray IconFactory::toByteArray(const QIcon& icon) {
+QByteArray IconFactory::toRawData(const QIcon& icon) {
   if (icon.isNull()) {
     return {};
   }
@@ -60,7 +72,78 @@ QByteArray IconFactory::toByteArray(const QIcon& icon) {
   out.setVersion(QDataStream::Version::Qt_4_7);
   out << icon;
   buffer.close();
-  return array.toBase64();
+  return array;
+}
+
+QString IconFactory::storeKey(const QByteArray& raw_data) {
+  return QString::fromLatin1(QCryptographicHash::hash(raw_data, QCryptographicHash::Algorithm::Sha256).toHex());
+}
+
+bool IconFactory::isStoreKey(const QByteArray& value) {
+  if (value.size() != 64) {
+    return false;
+  }
+
+  for (char chr : value) {
+    if (!((chr >= '0' && chr <= '9') || (chr >= 'a' && chr <= 'f'))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void IconFactory::loadIconStore(const QSqlDatabase& db) {
+  QHash<QString, QByteArray> icons = DatabaseQueries::getAllIconData(db);
+
+  qDebugNN << LOGSEC_GUI << "Loaded" << NONQUOTE_W_SPACE(icons.size()) << "icons from icon store.";
+
+  QMutexLocker lck(&m_storeMutex);
+  m_storeData = icons;
+}
+
+void IconFactory::addStoredIcon(const QString& key, const QByteArray& raw_data) {
+  QMutexLocker lck(&m_storeMutex);
+  m_storeData.insert(key, raw_data);
+}
+
+QIcon IconFactory::storedIcon(const QString& key) {
+  // NOTE: Pixmaps can only be scaled and kept in main thread,
+  // other threads just decode the icon.
+  const bool main_thread = QThread::currentThread() == qApp->thread();
+
+  if (main_thread) {
+    if (QIcon* cached = m_storeCache.object(key)) {
+      return *cached;
+    }
+  }
+
+  QByteArray raw_data;
+
+  {
+    QMutexLocker lck(&m_storeMutex);
+    raw_data = m_storeData.value(key);
+  }
+
+  QIcon icon = fromRawData(raw_data);
+
+  if (icon.isNull() || !main_thread) {
+    return icon;
+  }
+
+  // Favicons are sometimes huge, we only need small pixmap for painting.
+  const QSize max_size(ICON_STORE_PIXMAP_SIZE, ICON_STORE_PIXMAP_SIZE);
+  const QList<QSize> sizes = icon.availableSizes();
+  const bool too_big = std::any_of(sizes.cbegin(), sizes.cend(), [&](const QSize& size) {
+    return size.width() > max_size.width() || size.height() > max_size.height();
+  });
+
+  if (too_big) {
+    icon = QIcon(icon.pixmap(max_size));
+  }
+
+  m_storeCache.insert(key, new QIcon(icon));
+  return icon;
 }
 
 QIcon IconFactory::fromTheme(const QString& name, const QString& fallback) {
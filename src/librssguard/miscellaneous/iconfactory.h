@@ -6,10 +6,13 @@
 #include "definitions/definitions.h"
 #include "miscellaneous/application.h"
 
+#include <QCache>
 #include <QDir>
 #include <QHash>
 #include <QIcon>
+#include <QMutex>
 #include <QObject>
+#include <QSqlDatabase>
 #include <QString>
 
 class RSSGUARD_DLLSPEC IconFactory : public QObject {
@@ -27,6 +30,21 @@ class RSSGUARD_DLLSPEC IconFactory : public QObject {
     static QIcon fromByteArray(QByteArray array);
     static QByteArray toByteArray(const QIcon& icon);
 
+    // Raw (not Base64-encoded) serialized icon data.
+    static QIcon fromRawData(QByteArray array);
+    static QByteArray toRawData(const QIcon& icon);
+
+    // Content-addressed store of feed/category icons. Items hold only
+    // key (hash) of their icon. Raw data of all icons are loaded at once
+    // at startup, icon itself is decoded on first use and kept, scaled
+    // down, in LRU cache.
+    static QString storeKey(const QByteArray& raw_data);
+    static bool isStoreKey(const QByteArray& value);
+
+    void loadIconStore(const QSqlDatabase& db);
+    void addStoredIcon(const QString& key, const QByteArray& raw_data);
+    QIcon storedIcon(const QString& key);
+
     // Returns icon from active theme or invalid icon if
     // "no icon theme" is set.
     QIcon fromTheme(const QString& name, const QString& fallback = {});
@@ -50,6 +68,13 @@ class RSSGUARD_DLLSPEC IconFactory : public QObject {
 
     // Sets icon theme with given name as the active one and loads it.
     void setCurrentIconTheme(const QString& theme_name);
+
+  private:
+    QMutex m_storeMutex;
+    QHash<QString, QByteArray> m_storeData;
+
+    // Only accessed from main thread.
+    QCache<QString, QIcon> m_storeCache;
 };
 
 #endif // ICONFACTORY_H
@@ -467,6 +467,9 @@ DKEY Database::ID = "database";
 DKEY Database::UseInMemory = "use_in_memory_db";
 DVALUE(bool) Database::UseInMemoryDef = false;
 
+DKEY Database::CompressArticleContents = "compress_article_contents";
+DVALUE(bool) Database::CompressArticleContentsDef = false;
+
 DKEY Database::MySQLHostname = "mysql_hostname";
 DVALUE(QString) Database::MySQLHostnameDef = QString();
 
@@ -536,10 +539,55 @@ Settings::Settings(const QString& file_name, Format format, SettingsProperties::
   : QSettings(file_name, format, parent), m_lock(QReadWriteLock(QReadWriteLock::RecursionMode::Recursive)),
     m_initializationStatus(type) {
   Messages::PreviewerFontStandardDef = QFont(QApplication::font().family(), 12).toString();
+
+  QWriteLocker lck(&m_lock);
+  publishSnapshot();
 }
 
 Settings::~Settings() = default;
 
+bool SettingsSnapshot::operator==(const SettingsSnapshot& other) const {
+  return m_ignoreContentsChanges == other.m_ignoreContentsChanges &&
+         m_displayEnclosuresInMessage == other.m_displayEnclosuresInMessage &&
+         m_fixupFutureArticleDateTimes == other.m_fixupFutureArticleDateTimes &&
+         m_updateFeedListDuringFetching == other.m_updateFeedListDuringFetching &&
+         m_avoidOldArticles == other.m_avoidOldArticles && m_dateTimeToAvoidArticle == other.m_dateTimeToAvoidArticle &&
+         m_hoursToAvoidArticle == other.m_hoursToAvoidArticle &&
+         m_limitDoNotRemoveStarred == other.m_limitDoNotRemoveStarred &&
+         m_limitDoNotRemoveUnread == other.m_limitDoNotRemoveUnread &&
+         m_limitCountOfArticles == other.m_limitCountOfArticles &&
+         m_limitRecycleInsteadOfPurging == other.m_limitRecycleInsteadOfPurging &&
+         m_compressArticleContents == other.m_compressArticleContents;
+}
+
+void Settings::publishSnapshot() {
+  QSharedPointer<SettingsSnapshot> snapshot(new SettingsSnapshot());
+
+  snapshot->m_ignoreContentsChanges = value(GROUP(Messages), SETTING(Messages::IgnoreContentsChanges)).toBool();
+  snapshot->m_displayEnclosuresInMessage =
+    value(GROUP(Messages), SETTING(Messages::DisplayEnclosuresInMessage)).toBool();
+  snapshot->m_fixupFutureArticleDateTimes =
+    value(GROUP(Messages), SETTING(Messages::FixupFutureArticleDateTimes)).toBool();
+  snapshot->m_updateFeedListDuringFetching =
+    value(GROUP(Feeds), SETTING(Feeds::UpdateFeedListDuringFetching)).toBool();
+  snapshot->m_avoidOldArticles = value(GROUP(Messages), SETTING(Messages::AvoidOldArticles)).toBool();
+  snapshot->m_dateTimeToAvoidArticle =
+    value(GROUP(Messages), SETTING(Messages::DateTimeToAvoidArticle)).toDateTime();
+  snapshot->m_hoursToAvoidArticle = value(GROUP(Messages), SETTING(Messages::HoursToAvoidArticle)).toInt();
+  snapshot->m_limitDoNotRemoveStarred = value(GROUP(Messages), SETTING(Messages::LimitDoNotRemoveStarred)).toBool();
+  snapshot->m_limitDoNotRemoveUnread = value(GROUP(Messages), SETTING(Messages::LimitDoNotRemoveUnread)).toBool();
+  snapshot->m_limitCountOfArticles = value(GROUP(Messages), SETTING(Messages::LimitCountOfArticles)).toInt();
+  snapshot->m_limitRecycleInsteadOfPurging =
+    value(GROUP(Messages), SETTING(Messages::LimitRecycleInsteadOfPurging)).toBool();
+  snapshot->m_compressArticleContents = value(GROUP(Database), SETTING(Database::CompressArticleContents)).toBool();
+
+  QMutexLocker lck(&m_snapshotMutex);
+
+  if (m_snapshot.isNull() || !(*m_snapshot == *snapshot)) {
+    m_snapshot = snapshot;
+  }
+}
+
 QStringList Settings::allKeys(const QString& section) {
   if (!section.isEmpty()) {
     beginGroup(section);
@@ -12,9 +12,11 @@
 #include <QByteArray>
 #include <QColor>
 #include <QDateTime>
+#include <QMutex>
 #include <QNetworkProxy>
 #include <QReadWriteLock>
 #include <QSettings>
+#include <QSharedPointer>
 #include <QStringList>
 #include <QWriteLocker>
 
@@ -500,6 +502,10 @@ namespace Database {
 
   VALUE(bool) UseInMemoryDef;
 
+  KEY CompressArticleContents;
+
+  VALUE(bool) CompressArticleContentsDef;
+
   KEY MySQLHostname;
 
   VALUE(QString) MySQLHostnameDef;
@@ -575,7 +581,28 @@ namespace CategoriesExpandStates {
   KEY ID;
 }
 
-class Settings : public QSettings {
+// Typed copy of settings which are read from per-feed or per-article
+// loops, possibly from many threads at once. Instances are immutable
+// and new one is published whenever any of the values changes, older
+// one is released once its last reader drops it.
+struct SettingsSnapshot {
+    bool m_ignoreContentsChanges;
+    bool m_displayEnclosuresInMessage;
+    bool m_fixupFutureArticleDateTimes;
+    bool m_updateFeedListDuringFetching;
+    bool m_avoidOldArticles;
+    QDateTime m_dateTimeToAvoidArticle;
+    int m_hoursToAvoidArticle;
+    bool m_limitDoNotRemoveStarred;
+    bool m_limitDoNotRemoveUnread;
+    int m_limitCountOfArticles;
+    bool m_limitRecycleInsteadOfPurging;
+    bool m_compressArticleContents;
+
+    bool operator==(const SettingsSnapshot& other) const;
+};
+
+class RSSGUARD_DLLSPEC Settings : public QSettings {
     Q_OBJECT
 
   public:
@@ -591,6 +618,10 @@ class Settings : public QSettings {
 
     QStringList allKeys(const QString& section);
 
+    // Returns current snapshot of hot-path settings. Keep the returned
+    // pointer for the duration of the loop instead of calling this repeatedly.
+    QSharedPointer<const SettingsSnapshot> snapshot() const;
+
     QVariant value(const QString& section, const QString& key, const QVariant& default_value = QVariant()) const;
     void setValue(const QString& section, const QString& key, const QVariant& value);
     void setValue(const QString& key, const QVariant& value);
@@ -619,15 +650,26 @@ class Settings : public QSettings {
                       SettingsProperties::SettingsType type,
                       QObject* parent = nullptr);
 
+    // Re-reads snapshotted settings and publishes new snapshot if
+    // anything changed. Must be called with write lock held.
+    void publishSnapshot();
+
   private:
     mutable QReadWriteLock m_lock;
     SettingsProperties::SettingsType m_initializationStatus;
+    mutable QMutex m_snapshotMutex;
+    QSharedPointer<const SettingsSnapshot> m_snapshot;
 };
 
 inline SettingsProperties::SettingsType Settings::type() const {
   return m_initializationStatus;
 }
 
+inline QSharedPointer<const SettingsSnapshot> Settings::snapshot() const {
+  QMutexLocker lck(&m_snapshotMutex);
+  return m_snapshot;
+}
+
 // Getters/setters for settings values.
 inline QVariant Settings::password(const QString& section, const QString& key, const QVariant& default_value) const {
   return TextFactory::decrypt(value(section, key, default_value).toString());
@@ -644,11 +686,17 @@ inline QVariant Settings::value(const QString& section, const QString& key, cons
 inline void Settings::setValue(const QString& section, const QString& key, const QVariant& value) {
   QWriteLocker lck(&m_lock);
   QSettings::setValue(QString(QSL("%1/%2")).arg(section, key), value);
+
+  // NOTE: Keep in sync with sections read in publishSnapshot().
+  if (section == GROUP(Messages) || section == GROUP(Feeds) || section == GROUP(Database)) {
+    publishSnapshot();
+  }
 }
 
 inline void Settings::setValue(const QString& key, const QVariant& value) {
   QWriteLocker lck(&m_lock);
   QSettings::setValue(key, value);
+  publishSnapshot();
 }
 
 inline bool Settings::contains(const QString& section, const QString& key) const {
@@ -666,6 +714,8 @@ inline void Settings::remove(const QString& section, const QString& key) {
   else {
     QSettings::remove(QString(QSL("%1/%2")).arg(section, key));
   }
+
+  publishSnapshot();
 }
 
 #endif // SETTINGS_H
@@ -246,6 +246,7 @@ PreparedHtml SkinFactory::generateHtmlOfArticles(const QList<Message>& messages,
                      })
                      ->toFeed()
                  : nullptr;
+  const bool display_enclosures = qApp->settings()->snapshot()->m_displayEnclosuresInMessage;
 
   for (const Message& message : messages) {
     QString enclosures;
@@ -258,16 +259,13 @@ PreparedHtml SkinFactory::generateHtmlOfArticles(const QList<Message>& messages,
 
         enclosures += skin.m_enclosureMarkup.arg(enc_url, enclosure.m_mimeType);
 
-        if (qApp->settings()->value(GROUP(Messages), SETTING(Messages::DisplayEnclosuresInMessage)).toBool()) {
-          if (enclosure.m_mimeType.startsWith(QSL("image/")) &&
-              qApp->settings()->value(GROUP(Messages), SETTING(Messages::DisplayEnclosuresInMessage)).toBool()) {
-            // Add thumbnail image.
-            enclosure_images +=
-              skin.m_enclosureImageMarkup.arg(enclosure.m_url,
-                                              enclosure.m_mimeType,
-                                              forced_img_height <= 0 ? QString::number(-1)
-                                                                     : QString::number(forced_img_height));
-          }
+        if (display_enclosures && enclosure.m_mimeType.startsWith(QSL("image/"))) {
+          // Add thumbnail image.
+          enclosure_images +=
+            skin.m_enclosureImageMarkup.arg(enclosure.m_url,
+                                            enclosure.m_mimeType,
+                                            forced_img_height <= 0 ? QString::number(-1)
+                                                                   : QString::number(forced_img_height));
         }
       }
     }
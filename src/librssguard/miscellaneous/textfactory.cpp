@@ -219,6 +219,49 @@ QString TextFactory::capitalizeFirstLetter(const QString& sts) {
   }
 }
 
+QString TextFactory::simplifyTitle(const QString& title) {
+  QString output;
+  int whites = 0;
+  QChar last_white;
+
+  output.reserve(title.size());
+
+  auto flush_whites = [&]() {
+    if (!output.isEmpty()) {
+      if (whites > 1) {
+        output.append(QL1C(' '));
+      }
+      else if (whites == 1 && last_white != QL1C('\n') && last_white != QL1C('\r')) {
+        // Non-breaking narrow spaces are replaced with normal ones.
+        output.append(last_white == QChar(0x202F) ? QChar(QL1C(' ')) : last_white);
+      }
+    }
+
+    whites = 0;
+  };
+
+  for (const QChar chr : title) {
+    if (chr == QChar(0xFEFF)) {
+      // Remove non-breaking zero-width spaces.
+      continue;
+    }
+    else if (chr.isSpace()) {
+      whites++;
+      last_white = chr;
+    }
+    else {
+      if (whites > 0) {
+        flush_whites();
+      }
+
+      output.append(chr);
+    }
+  }
+
+  flush_whites();
+  return output;
+}
+
 enum class TokenState {
   // We are not inside argument, we are between arguments.
   Normal,
@@ -36,6 +36,10 @@ class RSSGUARD_DLLSPEC TextFactory {
     static QString decrypt(const QString& text, quint64 key = 0);
     static QString newline();
     static QString capitalizeFirstLetter(const QString& sts);
+
+    // Shrinks consecutive whitespaces into single space, removes single newlines,
+    // leading whitespace and zero-width non-breaking spaces. Single pass.
+    static QString simplifyTitle(const QString& title);
     static QStringList tokenizeProcessArguments(const QString& command);
 
     // Shortens input string according to given length limit.
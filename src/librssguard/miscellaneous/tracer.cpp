@@ -0,0 +1,135 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "miscellaneous/tracer.h"
+
+#include "definitions/definitions.h"
+#include "miscellaneous/thread.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+
+std::atomic_bool Tracer::s_enabled(false);
+QElapsedTimer Tracer::s_clock;
+QMutex Tracer::s_mutex;
+QList<Tracer::Span> Tracer::s_spans;
+QHash<QByteArray, Tracer::Metric> Tracer::s_spanMetrics;
+QHash<QByteArray, Tracer::Metric> Tracer::s_counters;
+
+void Tracer::setEnabled(bool enabled) {
+  QMutexLocker lck(&s_mutex);
+
+  if (enabled && !s_clock.isValid()) {
+    s_clock.start();
+  }
+
+  s_enabled.store(enabled, std::memory_order_relaxed);
+
+  qDebugNN << LOGSEC_CORE << "Tracing of hot paths is" << NONQUOTE_W_SPACE_DOT(enabled ? "enabled" : "disabled");
+}
+
+qint64 Tracer::timestampUs() {
+  return s_clock.isValid() ? s_clock.nsecsElapsed() / 1000 : 0;
+}
+
+void Tracer::recordSpan(const char* name, const char* category, qint64 start_us, qint64 duration_us) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  Span span = {name, category, start_us, duration_us, getThreadID()};
+  QMutexLocker lck(&s_mutex);
+
+  if (s_spans.size() >= TRACER_MAX_SPANS) {
+    // Keep only newer spans.
+    s_spans.erase(s_spans.begin(), s_spans.begin() + TRACER_MAX_SPANS / 2);
+  }
+
+  s_spans.append(span);
+  addToMetric(s_spanMetrics[QByteArray(name)], duration_us);
+}
+
+void Tracer::addToCounter(const char* name, qint64 value) {
+  QMutexLocker lck(&s_mutex);
+
+  addToMetric(s_counters[QByteArray(name)], value);
+}
+
+void Tracer::clear() {
+  QMutexLocker lck(&s_mutex);
+
+  s_spans.clear();
+  s_spanMetrics.clear();
+  s_counters.clear();
+}
+
+QJsonDocument Tracer::chromeTrace() {
+  QMutexLocker lck(&s_mutex);
+  QJsonArray events;
+  const qint64 pid = QCoreApplication::applicationPid();
+
+  for (const Span& span : std::as_const(s_spans)) {
+    events.append(QJsonObject{{QSL("name"), QString::fromLatin1(span.m_name)},
+                              {QSL("cat"), QString::fromLatin1(span.m_category)},
+                              {QSL("ph"), QSL("X")},
+                              {QSL("ts"), span.m_startUs},
+                              {QSL("dur"), span.m_durationUs},
+                              {QSL("pid"), pid},
+                              {QSL("tid"), span.m_threadId}});
+  }
+
+  return QJsonDocument(QJsonObject{{QSL("traceEvents"), events}, {QSL("displayTimeUnit"), QSL("ms")}});
+}
+
+QJsonObject Tracer::metrics() {
+  QMutexLocker lck(&s_mutex);
+  QJsonObject spans, counters;
+
+  for (auto i = s_spanMetrics.constBegin(); i != s_spanMetrics.constEnd(); i++) {
+    spans.insert(QString::fromLatin1(i.key()), metricToJson(i.value()));
+  }
+
+  for (auto i = s_counters.constBegin(); i != s_counters.constEnd(); i++) {
+    counters.insert(QString::fromLatin1(i.key()), metricToJson(i.value()));
+  }
+
+  return QJsonObject{{QSL("enabled"), isEnabled()}, {QSL("spans"), spans}, {QSL("counters"), counters}};
+}
+
+void Tracer::addToMetric(Metric& metric, qint64 value) {
+  if (metric.m_count == 0) {
+    metric.m_min = metric.m_max = value;
+  }
+  else {
+    metric.m_min = qMin(metric.m_min, value);
+    metric.m_max = qMax(metric.m_max, value);
+  }
+
+  metric.m_count++;
+  metric.m_sum += value;
+
+  int bucket = 0;
+
+  for (qint64 val = value; val > 0; val >>= 1) {
+    bucket++;
+  }
+
+  if (metric.m_histogram.size() <= bucket) {
+    metric.m_histogram.resize(bucket + 1);
+  }
+
+  metric.m_histogram[bucket]++;
+}
+
+QJsonObject Tracer::metricToJson(const Metric& metric) {
+  QJsonArray histogram;
+
+  for (qint64 bucket : metric.m_histogram) {
+    histogram.append(bucket);
+  }
+
+  return QJsonObject{{QSL("count"), metric.m_count},
+                     {QSL("sum"), metric.m_sum},
+                     {QSL("min"), metric.m_min},
+                     {QSL("max"), metric.m_max},
+                     {QSL("histogram"), histogram}};
+}
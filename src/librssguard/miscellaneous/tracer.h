@@ -0,0 +1,108 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QVector>
+
+#include <atomic>
+
+// Collects timing spans and counters of hot code paths.
+// Everything is disabled by default and then the only cost
+// of each span or counter is single atomic load.
+class RSSGUARD_DLLSPEC Tracer {
+  private:
+    Tracer();
+
+  public:
+    struct Span {
+        const char* m_name;
+        const char* m_category;
+        qint64 m_startUs;
+        qint64 m_durationUs;
+        qlonglong m_threadId;
+    };
+
+    // Aggregated values of one span or counter. Histogram has
+    // power-of-two buckets, bucket "i" holds values in range <2^(i-1), 2^i).
+    struct Metric {
+        qint64 m_count = 0;
+        qint64 m_sum = 0;
+        qint64 m_min = 0;
+        qint64 m_max = 0;
+        QVector<qint64> m_histogram;
+    };
+
+    static bool isEnabled() {
+      return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enabled);
+
+    // Microseconds elapsed since tracer was enabled.
+    static qint64 timestampUs();
+
+    static void recordSpan(const char* name, const char* category, qint64 start_us, qint64 duration_us);
+    static void addToCounter(const char* name, qint64 value);
+    static void clear();
+
+    // Returns all recorded spans in Chrome/Perfetto "Trace Event" JSON format.
+    static QJsonDocument chromeTrace();
+
+    // Returns aggregated metrics of spans (in microseconds) and counters.
+    static QJsonObject metrics();
+
+  private:
+    static void addToMetric(Metric& metric, qint64 value);
+    static QJsonObject metricToJson(const Metric& metric);
+
+    static std::atomic_bool s_enabled;
+    static QElapsedTimer s_clock;
+    static QMutex s_mutex;
+    static QList<Span> s_spans;
+    static QHash<QByteArray, Metric> s_spanMetrics;
+    static QHash<QByteArray, Metric> s_counters;
+};
+
+// Measures lifetime of the object as a span.
+class RSSGUARD_DLLSPEC TraceSpan {
+  public:
+    explicit TraceSpan(const char* name, const char* category = "core")
+      : m_name(name), m_category(category), m_startUs(Tracer::isEnabled() ? Tracer::timestampUs() : -1) {}
+
+    ~TraceSpan() {
+      finish();
+    }
+
+    // Ends the span prematurely.
+    void finish() {
+      if (m_startUs >= 0) {
+        Tracer::recordSpan(m_name, m_category, m_startUs, Tracer::timestampUs() - m_startUs);
+        m_startUs = -1;
+      }
+    }
+
+  private:
+    const char* m_name;
+    const char* m_category;
+    qint64 m_startUs;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b)      TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name, category) \
+  TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(name, category)
+#define TRACE_COUNTER(name, value)       \
+  do {                                   \
+    if (Tracer::isEnabled()) {           \
+      Tracer::addToCounter(name, value); \
+    }                                    \
+  } while (false)
+
+#endif // TRACER_H
@@ -3,7 +3,6 @@
 
 #include "network-web/apiserver.h"
 
-#include "3rd-party/boolinq/boolinq.h"
 #include "core/feedsmodel.h"
 #include "database/databasefactory.h"
 #include "database/databasequeries.h"
@@ -12,69 +11,111 @@
 #include "gui/feedmessageviewer.h"
 #include "gui/messagesview.h"
 #include "miscellaneous/application.h"
+#include "miscellaneous/tracer.h"
 
+#include <QFutureWatcher>
 #include <QJsonArray>
 #include <QMetaEnum>
+#include <QPointer>
+#include <QtConcurrentRun>
 
 ApiServer::ApiServer(QObject* parent) : HttpServer(parent) {}
 
 void ApiServer::answerClient(QTcpSocket* socket, const HttpRequest& request) {
-  QByteArray incoming_data = socket->readAll();
-  QByteArray reply_message;
-
   if (request.m_method == HttpRequest::Method::Options) {
-    reply_message = processCorsPreflight();
+    writeAnswer(socket, processCorsPreflight());
+    return;
   }
-  else if (request.m_url.path().contains("rssguard")) {
-    reply_message = processHtmlPage();
+
+  if (request.m_url.path().contains("rssguard")) {
+    writeAnswer(socket, processHtmlPage());
+    return;
   }
-  else {
-    QJsonParseError json_err;
-    QByteArray json_data;
-    QJsonDocument incoming_doc = QJsonDocument::fromJson(incoming_data, &json_err);
-
-    if (json_err.error != QJsonParseError::ParseError::NoError) {
-      json_data =
-        ApiResponse(ApiResponse::Result::Error, ApiRequest::Method::Unknown, QJsonValue(json_err.errorString()))
-          .toJson()
-          .toJson();
-    }
-    else {
-      ApiRequest req(incoming_doc);
 
-      try {
-        ApiResponse resp(processRequest(req));
+  QJsonParseError json_err;
+  QJsonDocument incoming_doc = QJsonDocument::fromJson(request.m_body, &json_err);
 
-        json_data = resp.toJson().toJson();
-      }
-      catch (const ApplicationException& ex) {
-        ApiResponse err_resp(ApiResponse::Result::Error, req.m_method, ex.message());
+  if (json_err.error != QJsonParseError::ParseError::NoError) {
+    QByteArray json_data =
+      ApiResponse(ApiResponse::Result::Error, ApiRequest::Method::Unknown, QJsonValue(json_err.errorString()))
+        .toJson()
+        .toJson();
 
-        json_data = err_resp.toJson().toJson();
-      }
-    }
+    writeAnswer(socket, processJsonAnswer(json_data));
+    return;
+  }
 
-    reply_message = generateHttpAnswer(200,
-                                       {{QSL("Access-Control-Allow-"
-                                             "Origin"),
-                                         QSL("*")},
-                                        {QSL("Access-Control-Allow-"
-                                             "Headers"),
-                                         QSL("*")},
-                                        {QSL("Content-Type"),
-                                         QSL("application/json; "
-                                             "charset=\"utf-8\"")}},
-                                       json_data);
+  // NOTE: Request itself is processed in worker thread with its own
+  // DB connection, so that slow queries block neither GUI nor other clients.
+  // Accounts are owned by GUI thread, so only their IDs are
+  // passed to the worker.
+  ApiRequest req(incoming_doc);
+  QPointer<QTcpSocket> client(socket);
+  QList<int> account_ids;
+
+  for (const ServiceRoot* acc : qApp->feedReader()->feedsModel()->serviceRoots()) {
+    account_ids.append(acc->accountId());
+  }
+
+  auto* watcher = new QFutureWatcher<QByteArray>(this);
+
+  connect(watcher, &QFutureWatcher<QByteArray>::finished, this, [this, watcher, client, req]() {
+    QByteArray json_data = watcher->result();
+
+    watcher->deleteLater();
+
+    if (req.m_method == ApiRequest::Method::MarkArticles) {
+      // All updates are done, recalculate.
+      qApp->feedReader()->feedsModel()->reloadCountsOfWholeModel();
+      qApp->mainForm()->tabWidget()->feedMessageViewer()->messagesView()->reloadSelections();
+    }
 
 #if !defined(NDEBUG)
     IOFactory::writeFile("a.out", json_data);
 #endif
-  }
 
-  socket->write(reply_message);
+    if (!client.isNull()) {
+      writeAnswer(client.data(), processJsonAnswer(json_data));
+    }
+  });
+
+  watcher->setFuture(QtConcurrent::run(qApp->workHorsePool(), [req, account_ids]() {
+    return processRequestJson(req, account_ids);
+  }));
+}
+
+void ApiServer::writeAnswer(QTcpSocket* socket, const QByteArray& answer) const {
+  socket->write(answer);
   socket->disconnectFromHost();
 }
 
+QByteArray ApiServer::processJsonAnswer(const QByteArray& json_data) const {
+  return generateHttpAnswer(200,
+                            {{QSL("Access-Control-Allow-"
+                                  "Origin"),
+                              QSL("*")},
+                             {QSL("Access-Control-Allow-"
+                                  "Headers"),
+                              QSL("*")},
+                             {QSL("Content-Type"),
+                              QSL("application/json; "
+                                  "charset=\"utf-8\"")}},
+                            json_data);
+}
+
+QByteArray ApiServer::processRequestJson(const ApiRequest& req, const QList<int>& account_ids) {
+  try {
+    ApiResponse resp(processRequest(req, account_ids));
+
+    return resp.toJson().toJson();
+  }
+  catch (const ApplicationException& ex) {
+    ApiResponse err_resp(ApiResponse::Result::Error, req.m_method, ex.message());
+
+    return err_resp.toJson().toJson();
+  }
+}
+
 QByteArray ApiServer::processCorsPreflight() const {
   return generateHttpAnswer(204,
                             {{QSL("Access-Control-Allow-"
@@ -119,7 +160,7 @@ QByteArray ApiServer::processHtmlPage() const {
   return data;
 }
 
-ApiResponse ApiServer::processRequest(const ApiRequest& req) const {
+ApiResponse ApiServer::processRequest(const ApiRequest& req, const QList<int>& account_ids) {
   switch (req.m_method) {
     case ApiRequest::Method::AppVersion:
       return processAppVersion();
@@ -128,7 +169,13 @@ ApiResponse ApiServer::processRequest(const ApiRequest& req) const {
       return processArticlesFromFeed(req.m_parameters);
 
     case ApiRequest::Method::MarkArticles:
-      return processMarkArticles(req.m_parameters);
+      return processMarkArticles(req.m_parameters, account_ids);
+
+    case ApiRequest::Method::Metrics:
+      return processMetrics();
+
+    case ApiRequest::Method::Trace:
+      return processTrace();
 
     case ApiRequest::Method::Unknown:
     default:
@@ -136,11 +183,11 @@ ApiResponse ApiServer::processRequest(const ApiRequest& req) const {
   }
 }
 
-ApiResponse ApiServer::processAppVersion() const {
+ApiResponse ApiServer::processAppVersion() {
   return ApiResponse(ApiResponse::Result::Success, ApiRequest::Method::AppVersion, QSL(APP_VERSION));
 }
 
-ApiResponse ApiServer::processMarkArticles(const QJsonValue& req) const {
+ApiResponse ApiServer::processMarkArticles(const QJsonValue& req, const QList<int>& account_ids) {
   QJsonObject data = req.toObject();
 
   bool mark_read = data.value(QSL("mark_read")).toBool();
@@ -158,7 +205,7 @@ ApiResponse ApiServer::processMarkArticles(const QJsonValue& req) const {
   }
 
   QMapIterator<int, QStringList> articles_per_accounts_iter(articles_per_accounts);
-  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+  QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(QSL("ApiServer"));
 
   RootItem::ReadStatus target_read = mark_read ? RootItem::ReadStatus::Read : RootItem::ReadStatus::Unread;
 
@@ -173,33 +220,22 @@ ApiResponse ApiServer::processMarkArticles(const QJsonValue& req) const {
     target_important = RootItem::Importance::Unknown;
   }
 
-  QList<ServiceRoot*> accts = qApp->feedReader()->feedsModel()->serviceRoots();
-  auto linq_accts = boolinq::from(accts);
-
   while (articles_per_accounts_iter.hasNext()) {
     auto nxt = articles_per_accounts_iter.next();
     int account_id = nxt.key();
     QStringList custom_ids = nxt.value();
-    ServiceRoot* acc = linq_accts.firstOrDefault([=](ServiceRoot* acc) {
-      return acc->accountId() == account_id;
-    });
-
-    if (acc == nullptr) {
+    if (!account_ids.contains(account_id)) {
       throw ApplicationException(tr("account with ID %1 not found").arg(account_id));
     }
 
     DatabaseQueries::markMessagesReadUnreadImportant(database, account_id, custom_ids, target_read, target_important);
   }
 
-  // All updates are done, recalculate.
-  qApp->feedReader()->feedsModel()->reloadCountsOfWholeModel();
-  qApp->mainForm()->tabWidget()->feedMessageViewer()->messagesView()->reloadSelections();
-
   ApiResponse resp(ApiResponse::Result::Success, ApiRequest::Method::MarkArticles);
   return resp;
 }
 
-ApiResponse ApiServer::processArticlesFromFeed(const QJsonValue& req) const {
+ApiResponse ApiServer::processArticlesFromFeed(const QJsonValue& req) {
   QJsonObject data = req.toObject();
 
   QString feed_id = data.value(QSL("feed")).toString();
@@ -216,7 +252,7 @@ ApiResponse ApiServer::processArticlesFromFeed(const QJsonValue& req) const {
     feed_id = QString();
   }
 
-  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+  QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(QSL("ApiServer"));
   QList<Message> msgs = DatabaseQueries::getArticlesSlice(database,
                                                           feed_id,
                                                           account_id,
@@ -237,7 +273,15 @@ ApiResponse ApiServer::processArticlesFromFeed(const QJsonValue& req) const {
   return resp;
 }
 
-ApiResponse ApiServer::processUnknown() const {
+ApiResponse ApiServer::processMetrics() {
+  return ApiResponse(ApiResponse::Result::Success, ApiRequest::Method::Metrics, Tracer::metrics());
+}
+
+ApiResponse ApiServer::processTrace() {
+  return ApiResponse(ApiResponse::Result::Success, ApiRequest::Method::Trace, Tracer::chromeTrace().object());
+}
+
+ApiResponse ApiServer::processUnknown() {
   return ApiResponse(ApiResponse::Result::Error,
                      ApiRequest::Method::Unknown,
                      QSL("unknown "
@@ -16,7 +16,9 @@ struct ApiRequest {
       Unknown = 0,
       AppVersion = 1,
       ArticlesFromFeed = 2,
-      MarkArticles = 3
+      MarkArticles = 3,
+      Metrics = 4,
+      Trace = 5
     };
 
     Q_ENUM(Method)
@@ -47,7 +49,7 @@ struct ApiResponse {
     QJsonDocument toJson() const;
 };
 
-class ApiServer : public HttpServer {
+class RSSGUARD_DLLSPEC ApiServer : public HttpServer {
   public:
     explicit ApiServer(QObject* parent = nullptr);
 
@@ -55,14 +57,22 @@ class ApiServer : public HttpServer {
     virtual void answerClient(QTcpSocket* socket, const HttpRequest& request);
 
   private:
+    void writeAnswer(QTcpSocket* socket, const QByteArray& answer) const;
+
     QByteArray processCorsPreflight() const;
     QByteArray processHtmlPage() const;
-
-    ApiResponse processRequest(const ApiRequest& req) const;
-    ApiResponse processAppVersion() const;
-    ApiResponse processArticlesFromFeed(const QJsonValue& req) const;
-    ApiResponse processUnknown() const;
-    ApiResponse processMarkArticles(const QJsonValue& req) const;
+    QByteArray processJsonAnswer(const QByteArray& json_data) const;
+
+    // NOTE: These methods run in worker threads and
+    // thus must not touch any GUI or model components.
+    static QByteArray processRequestJson(const ApiRequest& req, const QList<int>& account_ids);
+    static ApiResponse processRequest(const ApiRequest& req, const QList<int>& account_ids);
+    static ApiResponse processAppVersion();
+    static ApiResponse processArticlesFromFeed(const QJsonValue& req);
+    static ApiResponse processUnknown();
+    static ApiResponse processMarkArticles(const QJsonValue& req, const QList<int>& account_ids);
+    static ApiResponse processMetrics();
+    static ApiResponse processTrace();
 };
 
 #endif // APISERVER_H
@@ -0,0 +1,865 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "network-web/articleextractor.h"
+
+#include "definitions/definitions.h"
+#include "network-web/webfactory.h"
+
+#include <QRegularExpression>
+#include <QSet>
+#include <QTextCodec>
+
+#include <algorithm>
+
+#define EXTRACTOR_MIN_PARAGRAPH_LENGTH 25
+#define EXTRACTOR_MIN_SIBLING_SCORE    10.0
+#define EXTRACTOR_CLASS_WEIGHT         25
+#define EXTRACTOR_MAX_DEPTH            256
+
+struct ArticleExtractor::Node {
+    // Lowercase tag name, text nodes have empty tag.
+    QString m_tag;
+
+    // Raw (still escaped) text of text nodes.
+    QString m_text;
+
+    QList<QPair<QString, QString>> m_attributes;
+    QList<Node*> m_children;
+    Node* m_parent = nullptr;
+    int m_depth = 0;
+
+    // Statistics of decoded text of the whole subtree.
+    int m_textLength = 0;
+    int m_linkLength = 0;
+    int m_commas = 0;
+
+    double m_score = 0.0;
+    bool m_isCandidate = false;
+
+    bool isText() const {
+      return m_tag.isEmpty();
+    }
+
+    QString attribute(const QString& name) const {
+      for (const QPair<QString, QString>& attr : m_attributes) {
+        if (attr.first == name) {
+          return attr.second;
+        }
+      }
+
+      return {};
+    }
+
+    bool hasAttribute(const QString& name) const {
+      for (const QPair<QString, QString>& attr : m_attributes) {
+        if (attr.first == name) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void remove() {
+      if (m_parent != nullptr) {
+        m_parent->m_children.removeOne(this);
+        m_parent = nullptr;
+      }
+    }
+};
+
+// Owns all nodes of parsed page.
+class ArticleExtractor::Document {
+  public:
+    explicit Document(const QString& html) : m_root(createNode(QSL("#document"), nullptr)) {
+      parse(html);
+    }
+
+    ~Document() {
+      qDeleteAll(m_nodes);
+    }
+
+    Node* root() const {
+      return m_root;
+    }
+
+  private:
+    Node* createNode(const QString& tag, Node* parent) {
+      Node* node = new Node();
+
+      node->m_tag = tag;
+      node->m_parent = parent;
+
+      if (parent != nullptr) {
+        node->m_depth = parent->m_depth + 1;
+        parent->m_children.append(node);
+      }
+
+      m_nodes.append(node);
+      return node;
+    }
+
+    void appendText(Node* parent, const QString& text) {
+      if (!text.isEmpty()) {
+        createNode({}, parent)->m_text = text;
+      }
+    }
+
+    // Finds nearest open element with one of given tags, search stops
+    // at any of boundary tags.
+    static Node* findOpen(Node* current, const QSet<QString>& tags, const QSet<QString>& boundaries) {
+      for (Node* nd = current; nd != nullptr && nd->m_parent != nullptr; nd = nd->m_parent) {
+        if (tags.contains(nd->m_tag)) {
+          return nd;
+        }
+        else if (boundaries.contains(nd->m_tag)) {
+          return nullptr;
+        }
+      }
+
+      return nullptr;
+    }
+
+    // Closes elements which are implicitly ended by start of new element.
+    static Node* closeImplicitly(Node* current, const QString& tag) {
+      static const QSet<QString> closing_p = {QSL("address"), QSL("article"), QSL("aside"),   QSL("blockquote"),
+                                              QSL("div"),     QSL("dl"),      QSL("fieldset"), QSL("figure"),
+                                              QSL("footer"),  QSL("form"),    QSL("h1"),       QSL("h2"),
+                                              QSL("h3"),      QSL("h4"),      QSL("h5"),       QSL("h6"),
+                                              QSL("header"),  QSL("hr"),      QSL("main"),     QSL("nav"),
+                                              QSL("ol"),      QSL("p"),       QSL("pre"),      QSL("section"),
+                                              QSL("table"),   QSL("ul")};
+      Node* open = nullptr;
+
+      if (closing_p.contains(tag) && current->m_tag == QSL("p")) {
+        return current->m_parent;
+      }
+      else if (tag == QSL("li")) {
+        open = findOpen(current, {QSL("li")}, {QSL("ul"), QSL("ol")});
+      }
+      else if (tag == QSL("dt") || tag == QSL("dd")) {
+        open = findOpen(current, {QSL("dt"), QSL("dd")}, {QSL("dl")});
+      }
+      else if (tag == QSL("tr")) {
+        open = findOpen(current, {QSL("tr")}, {QSL("table")});
+      }
+      else if (tag == QSL("td") || tag == QSL("th")) {
+        open = findOpen(current, {QSL("td"), QSL("th")}, {QSL("tr"), QSL("table")});
+      }
+      else if (tag == QSL("option")) {
+        open = findOpen(current, {QSL("option")}, {QSL("select")});
+      }
+
+      return open != nullptr ? open->m_parent : current;
+    }
+
+    static bool isNameChar(QChar chr) {
+      return chr.isLetterOrNumber() || chr == QL1C('-') || chr == QL1C(':') || chr == QL1C('_');
+    }
+
+    void parse(const QString& html) {
+      static const QSet<QString> void_tags = {QSL("area"),
+                                              QSL("base"),
+                                              QSL("br"),
+                                              QSL("col"),
+                                              QSL("embed"),
+                                              QSL("hr"),
+                                              QSL("img"),
+                                              QSL("input"),
+                                              QSL("link"),
+                                              QSL("meta"),
+                                              QSL("param"),
+                                              QSL("source"),
+                                              QSL("track"),
+                                              QSL("wbr")};
+      static const QSet<QString> raw_text_tags = {QSL("script"),
+                                                  QSL("style"),
+                                                  QSL("textarea"),
+                                                  QSL("title"),
+                                                  QSL("noscript"),
+                                                  QSL("iframe"),
+                                                  QSL("xmp"),
+                                                  QSL("noembed"),
+                                                  QSL("noframes")};
+
+      const int length = html.size();
+      Node* current = m_root;
+      int pos = 0;
+
+      while (pos < length) {
+        const int lt = html.indexOf(QL1C('<'), pos);
+
+        if (lt < 0 || lt + 1 >= length) {
+          appendText(current, html.mid(pos));
+          break;
+        }
+
+        appendText(current, html.mid(pos, lt - pos));
+
+        const QChar next = html.at(lt + 1);
+
+        if (html.mid(lt + 1, 3) == QSL("!--")) {
+          // Comment.
+          const int end = html.indexOf(QSL("-->"), lt + 4);
+
+          pos = end < 0 ? length : end + 3;
+        }
+        else if (next == QL1C('!') || next == QL1C('?')) {
+          // Doctype or processing instruction.
+          const int end = html.indexOf(QL1C('>'), lt);
+
+          pos = end < 0 ? length : end + 1;
+        }
+        else if (next == QL1C('/')) {
+          // End tag.
+          int i = lt + 2;
+
+          while (i < length && isNameChar(html.at(i))) {
+            i++;
+          }
+
+          const QString tag = html.mid(lt + 2, i - lt - 2).toLower();
+          const int end = html.indexOf(QL1C('>'), i);
+
+          pos = end < 0 ? length : end + 1;
+
+          for (Node* nd = current; nd != nullptr && nd->m_parent != nullptr; nd = nd->m_parent) {
+            if (nd->m_tag == tag) {
+              current = nd->m_parent;
+              break;
+            }
+          }
+        }
+        else if (next.isLetter()) {
+          // Start tag with attributes.
+          int i = lt + 1;
+
+          while (i < length && isNameChar(html.at(i))) {
+            i++;
+          }
+
+          const QString tag = html.mid(lt + 1, i - lt - 1).toLower();
+          QList<QPair<QString, QString>> attributes;
+          bool self_closing = false;
+
+          while (i < length) {
+            while (i < length && html.at(i).isSpace()) {
+              i++;
+            }
+
+            if (i >= length) {
+              break;
+            }
+            else if (html.at(i) == QL1C('>')) {
+              i++;
+              break;
+            }
+            else if (html.at(i) == QL1C('/')) {
+              self_closing = true;
+              i++;
+              continue;
+            }
+
+            const int name_start = i;
+
+            while (i < length && !html.at(i).isSpace() && html.at(i) != QL1C('>') && html.at(i) != QL1C('=') &&
+                   html.at(i) != QL1C('/')) {
+              i++;
+            }
+
+            if (i == name_start) {
+              // Stray character.
+              i++;
+              continue;
+            }
+
+            const QString name = html.mid(name_start, i - name_start).toLower();
+            QString value;
+
+            self_closing = false;
+
+            while (i < length && html.at(i).isSpace()) {
+              i++;
+            }
+
+            if (i < length && html.at(i) == QL1C('=')) {
+              i++;
+
+              while (i < length && html.at(i).isSpace()) {
+                i++;
+              }
+
+              if (i < length && (html.at(i) == QL1C('"') || html.at(i) == QL1C('\''))) {
+                int end = html.indexOf(html.at(i), i + 1);
+
+                if (end < 0) {
+                  end = length;
+                }
+
+                value = html.mid(i + 1, end - i - 1);
+                i = end + 1;
+              }
+              else {
+                const int value_start = i;
+
+                while (i < length && !html.at(i).isSpace() && html.at(i) != QL1C('>')) {
+                  i++;
+                }
+
+                value = html.mid(value_start, i - value_start);
+              }
+            }
+
+            attributes.append({name, WebFactory::unescapeHtml(value)});
+          }
+
+          pos = i;
+          current = closeImplicitly(current, tag);
+
+          Node* element = createNode(tag, current);
+
+          element->m_attributes = attributes;
+
+          if (raw_text_tags.contains(tag)) {
+            // Contents of these elements are not parsed.
+            const int end = html.indexOf(QSL("</") + tag, pos, Qt::CaseSensitivity::CaseInsensitive);
+            const int content_end = end < 0 ? length : end;
+
+            appendText(element, html.mid(pos, content_end - pos));
+
+            const int gt = end < 0 ? -1 : html.indexOf(QL1C('>'), end);
+
+            pos = gt < 0 ? length : gt + 1;
+          }
+          else if (!self_closing && !void_tags.contains(tag) && element->m_depth < EXTRACTOR_MAX_DEPTH) {
+            // NOTE: Tree is walked recursively, so contents of too deeply
+            // nested elements are flattened into their parent.
+            current = element;
+          }
+        }
+        else {
+          // Lonely "<" character.
+          appendText(current, QSL("&lt;"));
+          pos = lt + 1;
+        }
+      }
+    }
+
+  private:
+    QList<Node*> m_nodes;
+    Node* m_root;
+};
+
+QJsonObject ArticleExtractor::Article::toJson(const QString& url) const {
+  QJsonObject obj;
+
+  obj.insert(QSL("title"), m_title);
+  obj.insert(QSL("author"), m_author);
+  obj.insert(QSL("published"), m_published);
+  obj.insert(QSL("image"), m_image);
+  obj.insert(QSL("url"), url);
+  obj.insert(QSL("content"), m_content);
+
+  return obj;
+}
+
+ArticleExtractor::Article ArticleExtractor::extract(const QString& html, const QUrl& base_url) {
+  Document doc(html);
+  Article article;
+
+  readMetadata(doc.root(), base_url, article);
+  removeBoilerplate(doc.root());
+  computeStatistics(doc.root());
+
+  Node* top = findTopCandidate(doc.root());
+
+  if (top == nullptr || top->m_textLength == 0) {
+    return article;
+  }
+
+  QList<Node*> content = collectContent(top);
+
+  article.m_content = QSL("<div>");
+
+  for (Node* nd : content) {
+    cleanConditionally(nd);
+    serialize(nd, base_url, article.m_content);
+  }
+
+  article.m_content += QSL("</div>");
+
+  return article;
+}
+
+QString ArticleExtractor::decodeHtml(const QByteArray& data, const QString& content_type) {
+  static const QRegularExpression exp_charset(QSL("charset=[\"']?([0-9a-zA-Z\\-_]+)"),
+                                              QRegularExpression::PatternOption::CaseInsensitiveOption);
+  const QString charset = exp_charset.match(content_type).captured(1);
+  QTextCodec* codec = charset.isEmpty() ? nullptr : QTextCodec::codecForName(charset.toLocal8Bit());
+
+  if (codec == nullptr) {
+    codec = QTextCodec::codecForHtml(data, QTextCodec::codecForName("UTF-8"));
+  }
+
+  return codec->toUnicode(data);
+}
+
+void ArticleExtractor::readMetadata(Node* node, const QUrl& base_url, Article& article) {
+  static const QSet<QString> title_keys = {QSL("og:title"), QSL("twitter:title"), QSL("dc.title")};
+  static const QSet<QString> author_keys = {
+    QSL("author"), QSL("article:author"), QSL("dc.creator"), QSL("parsely-author"), QSL("byl")};
+  static const QSet<QString> published_keys = {QSL("article:published_time"),
+                                               QSL("datepublished"),
+                                               QSL("date"),
+                                               QSL("dc.date"),
+                                               QSL("pubdate"),
+                                               QSL("parsely-pub-date")};
+  static const QSet<QString> image_keys = {QSL("og:image"), QSL("twitter:image"), QSL("twitter:image:src")};
+
+  for (Node* child : std::as_const(node->m_children)) {
+    if (child->isText()) {
+      continue;
+    }
+
+    if (child->m_tag == QSL("title")) {
+      if (article.m_title.isEmpty()) {
+        article.m_title = innerText(child);
+      }
+    }
+    else if (child->m_tag == QSL("meta")) {
+      QString key = child->attribute(QSL("property"));
+
+      if (key.isEmpty()) {
+        key = child->attribute(QSL("name"));
+      }
+
+      if (key.isEmpty()) {
+        key = child->attribute(QSL("itemprop"));
+      }
+
+      key = key.toLower();
+
+      const QString value = child->attribute(QSL("content")).simplified();
+
+      if (value.isEmpty()) {
+        continue;
+      }
+
+      // NOTE: Titles from meta tags usually do not contain name of the site,
+      // so they are preferred over "<title>".
+      if (title_keys.contains(key)) {
+        article.m_title = value;
+      }
+      else if (author_keys.contains(key) && article.m_author.isEmpty()) {
+        article.m_author = value;
+      }
+      else if (published_keys.contains(key) && article.m_published.isEmpty()) {
+        article.m_published = value;
+      }
+      else if (image_keys.contains(key) && article.m_image.isEmpty()) {
+        article.m_image = base_url.isValid() ? base_url.resolved(QUrl(value)).toString() : value;
+      }
+    }
+    else if (child->m_tag == QSL("time") && article.m_published.isEmpty() &&
+             child->hasAttribute(QSL("datetime"))) {
+      article.m_published = child->attribute(QSL("datetime"));
+    }
+
+    readMetadata(child, base_url, article);
+  }
+}
+
+void ArticleExtractor::removeBoilerplate(Node* node) {
+  static const QSet<QString> removed_tags = {QSL("head"),     QSL("title"),  QSL("script"), QSL("style"),
+                                             QSL("noscript"), QSL("iframe"), QSL("button"), QSL("input"),
+                                             QSL("select"),   QSL("textarea"), QSL("nav"),  QSL("aside"),
+                                             QSL("footer"),   QSL("svg"),    QSL("canvas"), QSL("object"),
+                                             QSL("embed"),    QSL("link"),   QSL("meta"),   QSL("template"),
+                                             QSL("dialog")};
+  static const QSet<QString> never_unlikely = {
+    QSL("body"), QSL("a"), QSL("article"), QSL("table"), QSL("tbody"), QSL("tr"), QSL("td"), QSL("th")};
+  static const QRegularExpression exp_unlikely(
+    QSL("-ad-|ai2html|banner|breadcrumbs|combx|comment|community|cover-wrap|disqus|extra|footer|gdpr|header|legends|"
+        "menu|related|remark|replies|rss|shoutbox|sidebar|skyscraper|social|sponsor|supplemental|ad-break|agegate|"
+        "pagination|pager|popup|yom-remote"),
+    QRegularExpression::PatternOption::CaseInsensitiveOption);
+  static const QRegularExpression exp_maybe(QSL("and|article|body|column|content|main|shadow"),
+                                            QRegularExpression::PatternOption::CaseInsensitiveOption);
+  static const QRegularExpression exp_hidden(QSL("display\\s*:\\s*none|visibility\\s*:\\s*hidden"),
+                                             QRegularExpression::PatternOption::CaseInsensitiveOption);
+
+  const QList<Node*> children = node->m_children;
+
+  for (Node* child : children) {
+    if (child->isText()) {
+      continue;
+    }
+
+    const QString class_and_id = child->attribute(QSL("class")) + QL1C(' ') + child->attribute(QSL("id"));
+    const bool is_unlikely = !never_unlikely.contains(child->m_tag) && exp_unlikely.match(class_and_id).hasMatch() &&
+                             !exp_maybe.match(class_and_id).hasMatch();
+    const bool is_hidden = child->hasAttribute(QSL("hidden")) ||
+                           exp_hidden.match(child->attribute(QSL("style"))).hasMatch() ||
+                           child->attribute(QSL("aria-hidden")) == QSL("true");
+
+    if (removed_tags.contains(child->m_tag) || is_unlikely || is_hidden) {
+      child->remove();
+    }
+    else {
+      removeBoilerplate(child);
+    }
+  }
+}
+
+void ArticleExtractor::computeStatistics(Node* node) {
+  if (node->isText()) {
+    const QString text = WebFactory::unescapeHtml(node->m_text).simplified();
+
+    node->m_textLength = text.size();
+    node->m_linkLength = 0;
+    node->m_commas = text.count(QL1C(','));
+    return;
+  }
+
+  node->m_textLength = node->m_linkLength = node->m_commas = 0;
+
+  for (Node* child : std::as_const(node->m_children)) {
+    computeStatistics(child);
+
+    node->m_textLength += child->m_textLength;
+    node->m_linkLength += child->m_linkLength;
+    node->m_commas += child->m_commas;
+  }
+
+  if (node->m_tag == QSL("a")) {
+    node->m_linkLength = node->m_textLength;
+  }
+}
+
+ArticleExtractor::Node* ArticleExtractor::findTopCandidate(Node* root) {
+  static const QSet<QString> scored_tags = {
+    QSL("p"), QSL("pre"), QSL("td"), QSL("section"), QSL("h2"), QSL("h3"), QSL("h4"), QSL("h5"), QSL("h6")};
+  static const QSet<QString> block_tags = {QSL("blockquote"),
+                                           QSL("dl"),
+                                           QSL("div"),
+                                           QSL("img"),
+                                           QSL("ol"),
+                                           QSL("p"),
+                                           QSL("pre"),
+                                           QSL("table"),
+                                           QSL("ul"),
+                                           QSL("section"),
+                                           QSL("article"),
+                                           QSL("figure")};
+
+  QList<Node*> candidates;
+  QList<Node*> stack = {root};
+
+  while (!stack.isEmpty()) {
+    Node* node = stack.takeLast();
+
+    for (Node* child : std::as_const(node->m_children)) {
+      if (!child->isText()) {
+        stack.append(child);
+      }
+    }
+
+    // DIVs without block-level children are scored as paragraphs.
+    bool is_paragraph = scored_tags.contains(node->m_tag);
+
+    if (!is_paragraph && node->m_tag == QSL("div")) {
+      is_paragraph = std::none_of(node->m_children.cbegin(), node->m_children.cend(), [](const Node* child) {
+        return block_tags.contains(child->m_tag);
+      });
+    }
+
+    if (!is_paragraph || node->m_textLength < EXTRACTOR_MIN_PARAGRAPH_LENGTH) {
+      continue;
+    }
+
+    const double score = 1.0 + node->m_commas + std::min(node->m_textLength / 100, 3);
+    Node* ancestor = node->m_parent;
+
+    for (int level = 0; level < 3 && ancestor != nullptr && ancestor != root; level++) {
+      if (!ancestor->m_isCandidate) {
+        initializeCandidate(ancestor);
+        candidates.append(ancestor);
+      }
+
+      const double divider = level == 0 ? 1.0 : (level == 1 ? 2.0 : level * 3.0);
+
+      ancestor->m_score += score / divider;
+      ancestor = ancestor->m_parent;
+    }
+  }
+
+  Node* top = nullptr;
+
+  for (Node* candidate : std::as_const(candidates)) {
+    // Blocks full of links are most likely menus or lists of related articles.
+    candidate->m_score *= 1.0 - linkDensity(candidate);
+
+    if (top == nullptr || candidate->m_score > top->m_score) {
+      top = candidate;
+    }
+  }
+
+  if (top == nullptr) {
+    top = findElement(root, QSL("body"));
+  }
+
+  return top;
+}
+
+QList<ArticleExtractor::Node*> ArticleExtractor::collectContent(Node* top) {
+  static const QRegularExpression exp_sentence(QSL("\\.( |$)"));
+
+  if (top->m_parent == nullptr || top->m_tag == QSL("body")) {
+    return {top};
+  }
+
+  const double threshold = std::max(EXTRACTOR_MIN_SIBLING_SCORE, top->m_score * 0.2);
+  const QString top_class = top->attribute(QSL("class"));
+  QList<Node*> content;
+
+  for (Node* sibling : std::as_const(top->m_parent->m_children)) {
+    if (sibling == top) {
+      content.append(sibling);
+      continue;
+    }
+    else if (sibling->isText()) {
+      continue;
+    }
+
+    const double bonus =
+      !top_class.isEmpty() && sibling->attribute(QSL("class")) == top_class ? top->m_score * 0.2 : 0.0;
+
+    if (sibling->m_isCandidate && sibling->m_score + bonus >= threshold) {
+      content.append(sibling);
+    }
+    else if (sibling->m_tag == QSL("p")) {
+      const double density = linkDensity(sibling);
+
+      if ((sibling->m_textLength > 80 && density < 0.25) ||
+          (sibling->m_textLength > 0 && density == 0.0 && exp_sentence.match(innerText(sibling)).hasMatch())) {
+        content.append(sibling);
+      }
+    }
+  }
+
+  return content;
+}
+
+void ArticleExtractor::cleanConditionally(Node* node) {
+  static const QSet<QString> cleaned_tags = {
+    QSL("div"), QSL("section"), QSL("table"), QSL("ul"), QSL("ol"), QSL("form"), QSL("header")};
+
+  const QList<Node*> children = node->m_children;
+
+  for (Node* child : children) {
+    if (child->isText()) {
+      continue;
+    }
+
+    if (cleaned_tags.contains(child->m_tag)) {
+      const int weight = classWeight(child);
+      bool remove = weight < 0;
+
+      if (!remove && child->m_commas < 10) {
+        const bool is_list = child->m_tag == QSL("ul") || child->m_tag == QSL("ol");
+        const int paragraphs = countElements(child, QSL("p"));
+        const int images = countElements(child, QSL("img"));
+        const int items = countElements(child, QSL("li")) - 100;
+        const double density = linkDensity(child);
+
+        remove = (images > 1 && double(paragraphs) / images < 0.5) || (!is_list && items > paragraphs) ||
+                 (child->m_textLength < EXTRACTOR_MIN_PARAGRAPH_LENGTH && (images == 0 || images > 2)) ||
+                 (weight < EXTRACTOR_CLASS_WEIGHT && density > 0.2) ||
+                 (weight >= EXTRACTOR_CLASS_WEIGHT && density > 0.5);
+      }
+
+      if (remove) {
+        child->remove();
+        continue;
+      }
+    }
+
+    cleanConditionally(child);
+  }
+}
+
+void ArticleExtractor::serialize(const Node* node, const QUrl& base_url, QString& output) {
+  static const QSet<QString> void_tags = {QSL("br"), QSL("hr"), QSL("img"), QSL("source"), QSL("wbr"), QSL("col")};
+  static const QSet<QString> unwrapped_tags = {
+    QSL("span"), QSL("font"), QSL("center"), QSL("form"), QSL("html"), QSL("body"), QSL("#document")};
+  static const QSet<QString> kept_attributes = {
+    QSL("href"), QSL("src"), QSL("alt"), QSL("title"), QSL("colspan"), QSL("rowspan"), QSL("datetime"), QSL("dir")};
+
+  if (node->isText()) {
+    output += node->m_text;
+    return;
+  }
+
+  const bool unwrap = unwrapped_tags.contains(node->m_tag);
+
+  if (!unwrap) {
+    QList<QPair<QString, QString>> attributes = node->m_attributes;
+
+    if (node->m_tag == QSL("img")) {
+      // Lazy-loaded images keep real URL in custom attributes.
+      const QString src = node->attribute(QSL("src"));
+
+      if (src.isEmpty() || src.startsWith(QSL("data:"))) {
+        for (const QString& lazy_attr : {QSL("data-src"), QSL("data-original"), QSL("data-lazy-src")}) {
+          const QString lazy_src = node->attribute(lazy_attr);
+
+          if (!lazy_src.isEmpty()) {
+            attributes.append({QSL("src"), lazy_src});
+            break;
+          }
+        }
+      }
+    }
+
+    output += QL1C('<') + node->m_tag;
+
+    QSet<QString> written_attributes;
+
+    // NOTE: Last occurrence wins, so that lazy image URLs override placeholders.
+    for (auto it = attributes.crbegin(); it != attributes.crend(); it++) {
+      if (!kept_attributes.contains(it->first) || written_attributes.contains(it->first)) {
+        continue;
+      }
+
+      QString value = it->second;
+
+      if ((it->first == QSL("href") || it->first == QSL("src")) && base_url.isValid()) {
+        value = base_url.resolved(QUrl(value)).toString();
+      }
+
+      written_attributes.insert(it->first);
+      output += QL1C(' ') + it->first + QSL("=\"") + value.toHtmlEscaped() + QL1C('"');
+    }
+
+    output += QL1C('>');
+
+    if (void_tags.contains(node->m_tag)) {
+      return;
+    }
+  }
+
+  for (const Node* child : node->m_children) {
+    serialize(child, base_url, output);
+  }
+
+  if (!unwrap) {
+    output += QSL("</") + node->m_tag + QL1C('>');
+  }
+}
+
+void ArticleExtractor::initializeCandidate(Node* node) {
+  static const QSet<QString> plus_five = {QSL("div"), QSL("article")};
+  static const QSet<QString> plus_three = {QSL("pre"), QSL("td"), QSL("blockquote")};
+  static const QSet<QString> minus_three = {
+    QSL("address"), QSL("ol"), QSL("ul"), QSL("dl"), QSL("dd"), QSL("dt"), QSL("li"), QSL("form")};
+  static const QSet<QString> minus_five = {
+    QSL("h1"), QSL("h2"), QSL("h3"), QSL("h4"), QSL("h5"), QSL("h6"), QSL("th")};
+
+  double score = classWeight(node);
+
+  if (plus_five.contains(node->m_tag)) {
+    score += 5;
+  }
+  else if (plus_three.contains(node->m_tag)) {
+    score += 3;
+  }
+  else if (minus_three.contains(node->m_tag)) {
+    score -= 3;
+  }
+  else if (minus_five.contains(node->m_tag)) {
+    score -= 5;
+  }
+
+  node->m_score = score;
+  node->m_isCandidate = true;
+}
+
+int ArticleExtractor::classWeight(const Node* node) {
+  static const QRegularExpression exp_negative(
+    QSL("-ad-|hidden|^hid$| hid$| hid |^hid |banner|combx|comment|com-|contact|foot|footer|footnote|gdpr|masthead|"
+        "media|meta|outbrain|promo|related|scroll|share|shoutbox|sidebar|skyscraper|sponsor|shopping|tags|tool|widget"),
+    QRegularExpression::PatternOption::CaseInsensitiveOption);
+  static const QRegularExpression exp_positive(
+    QSL("article|body|content|entry|hentry|h-entry|main|page|pagination|post|text|blog|story"),
+    QRegularExpression::PatternOption::CaseInsensitiveOption);
+
+  int weight = 0;
+
+  for (const QString& attr : {QSL("class"), QSL("id")}) {
+    const QString value = node->attribute(attr);
+
+    if (value.isEmpty()) {
+      continue;
+    }
+
+    if (exp_negative.match(value).hasMatch()) {
+      weight -= EXTRACTOR_CLASS_WEIGHT;
+    }
+
+    if (exp_positive.match(value).hasMatch()) {
+      weight += EXTRACTOR_CLASS_WEIGHT;
+    }
+  }
+
+  return weight;
+}
+
+double ArticleExtractor::linkDensity(const Node* node) {
+  return node->m_textLength <= 0 ? 0.0 : double(node->m_linkLength) / node->m_textLength;
+}
+
+QString ArticleExtractor::innerText(const Node* node) {
+  if (node->isText()) {
+    return WebFactory::unescapeHtml(node->m_text).simplified();
+  }
+
+  QStringList texts;
+
+  for (const Node* child : node->m_children) {
+    const QString text = innerText(child);
+
+    if (!text.isEmpty()) {
+      texts.append(text);
+    }
+  }
+
+  return texts.join(QL1C(' '));
+}
+
+ArticleExtractor::Node* ArticleExtractor::findElement(Node* node, const QString& tag) {
+  if (node->m_tag == tag) {
+    return node;
+  }
+
+  for (Node* child : std::as_const(node->m_children)) {
+    Node* found = findElement(child, tag);
+
+    if (found != nullptr) {
+      return found;
+    }
+  }
+
+  return nullptr;
+}
+
+int ArticleExtractor::countElements(const Node* node, const QString& tag) {
+  int count = 0;
+
+  for (const Node* child : node->m_children) {
+    if (!child->isText()) {
+      count += (child->m_tag == tag ? 1 : 0) + countElements(child, tag);
+    }
+  }
+
+  return count;
+}
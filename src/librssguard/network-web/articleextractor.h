@@ -0,0 +1,61 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef ARTICLEEXTRACTOR_H
+#define ARTICLEEXTRACTOR_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QUrl>
+
+// Extracts main content of HTML pages, similarly to Mozilla's Readability.
+//
+// Page is parsed with tolerant HTML tokenizer into simple tree. Boilerplate nodes
+// (navigation, scripts, comments, sidebars, ...) are removed, paragraphs are scored
+// and their scores are propagated to ancestors. Best scoring block is then merged
+// with related siblings, cleaned and serialized back to HTML.
+//
+// NOTE: Extraction is reentrant and can run in worker threads.
+class RSSGUARD_DLLSPEC ArticleExtractor {
+  public:
+    struct Article {
+        QString m_title;
+        QString m_author;
+        QString m_published;
+        QString m_image;
+        QString m_content;
+
+        // Converts article to JSON object with "title", "author", "published",
+        // "image", "url" and "content" keys.
+        QJsonObject toJson(const QString& url) const;
+    };
+
+    // Extracts article from HTML page. Relative links are resolved against
+    // given base URL. Content is empty if no main content block was found.
+    static Article extract(const QString& html, const QUrl& base_url);
+
+    // Decodes raw HTML data. Charset is taken from content type if
+    // available, otherwise it is detected from the data itself.
+    static QString decodeHtml(const QByteArray& data, const QString& content_type);
+
+  private:
+    struct Node;
+    class Document;
+
+    static void readMetadata(Node* node, const QUrl& base_url, Article& article);
+    static void removeBoilerplate(Node* node);
+    static void computeStatistics(Node* node);
+    static Node* findTopCandidate(Node* root);
+    static QList<Node*> collectContent(Node* top);
+    static void cleanConditionally(Node* node);
+    static void serialize(const Node* node, const QUrl& base_url, QString& output);
+
+    static void initializeCandidate(Node* node);
+    static int classWeight(const Node* node);
+    static double linkDensity(const Node* node);
+    static QString innerText(const Node* node);
+    static Node* findElement(Node* node, const QString& tag);
+    static int countElements(const Node* node, const QString& tag);
+};
+
+#endif // ARTICLEEXTRACTOR_H
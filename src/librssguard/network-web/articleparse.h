@@ -3,10 +3,8 @@
 #ifndef ARTICLEPARSE_H
 #define ARTICLEPARSE_H
 
-#include "miscellaneous/nodejs.h"
-
 #include <QObject>
-#include <QProcess>
+#include <QPair>
 
 class ArticleParse : public QObject {
     Q_OBJECT
@@ -14,21 +12,18 @@ class ArticleParse : public QObject {
   public:
     explicit ArticleParse(QObject* parent = nullptr);
 
+    // Downloads the page and extracts its article in worker thread, the result
+    // is then reported via signals.
     void parseArticle(QObject* sndr, const QString& url);
 
-  private slots:
-    void onParsingFinished(const QObject* sndr, const QString& url, int exit_code, QProcess::ExitStatus exit_status);
-    void onPackageReady(const QObject* sndr, const QList<NodeJs::PackageMetadata>& pkgs, bool already_up_to_date);
-    void onPackageError(const QObject* sndr, const QList<NodeJs::PackageMetadata>& pkgs, const QString& error);
-
   signals:
     void articleParsed(const QObject* sndr, const QString& url, const QString& better_html);
     void errorOnArticleParsing(const QObject* sndr, const QString& error);
 
   private:
-    bool m_modulesInstalling;
-    bool m_modulesInstalled;
-    QString m_scriptFilename;
+    // Returns JSON description of the article or error message if
+    // the page cannot be downloaded or no article was found.
+    static QPair<bool, QString> downloadAndParse(const QString& url);
 };
 
 #endif // ARTICLEPARSE_H
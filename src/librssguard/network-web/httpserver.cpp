@@ -4,9 +4,13 @@
 
 #include "definitions/definitions.h"
 
+#include <cctype>
+
 #include <QDateTime>
 
-HttpServer::HttpServer(QObject* parent) : QObject(parent), m_listenAddress(QHostAddress()), m_listenPort(0) {
+HttpServer::HttpServer(QObject* parent)
+  : QObject(parent), m_listenAddress(QHostAddress()), m_listenPort(0), m_maxConnections(HTTP_SERVER_MAX_CONNECTIONS),
+    m_maxBodySize(HTTP_SERVER_MAX_BODY_SIZE) {
   connect(&m_httpServer, &QTcpServer::newConnection, this, &HttpServer::clientConnected);
 
   // NOTE: We do not want to start handler immediately, sometimes
@@ -96,57 +100,89 @@ QByteArray HttpServer::generateHttpAnswer(int http_code,
 }
 
 void HttpServer::clientConnected() {
-  QTcpSocket* socket = m_httpServer.nextPendingConnection();
+  while (m_httpServer.hasPendingConnections()) {
+    QTcpSocket* socket = m_httpServer.nextPendingConnection();
+
+    QObject::connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+      m_connectedClients.remove(socket);
+      socket->deleteLater();
+    });
+
+    if (m_maxConnections > 0 && m_connectedClients.size() >= m_maxConnections) {
+      qWarningNN << LOGSEC_NETWORK << "Too many connected clients, rejecting new one.";
+      rejectClient(socket, 503);
+      continue;
+    }
+
+    HttpClient& client = m_connectedClients[socket];
 
-  QObject::connect(socket, &QTcpSocket::disconnected, socket, &QTcpSocket::deleteLater);
-  QObject::connect(socket, &QTcpSocket::readyRead, [this, socket]() {
-    readReceivedData(socket);
-  });
+    client.m_request.m_address = QSL(URI_SCHEME_HTTP) + m_httpServer.serverAddress().toString();
+    client.m_request.m_port = m_httpServer.serverPort();
+
+    QObject::connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+      readReceivedData(socket);
+    });
+  }
+}
+
+void HttpServer::rejectClient(QTcpSocket* socket, int http_code) {
+  socket->write(generateHttpAnswer(http_code, {}));
+  socket->disconnectFromHost();
 }
 
 void HttpServer::readReceivedData(QTcpSocket* socket) {
-  if (!m_connectedClients.contains(socket)) {
-    m_connectedClients[socket].m_address = QSL(URI_SCHEME_HTTP) + m_httpServer.serverAddress().toString();
-    m_connectedClients[socket].m_port = m_httpServer.serverPort();
+  auto client_it = m_connectedClients.find(socket);
+
+  if (client_it == m_connectedClients.end() || client_it->m_request.m_state == HttpRequest::State::AllDone) {
+    // Request of this client was already answered, ignore any further data.
+    socket->readAll();
+    return;
   }
 
-  HttpRequest* request = &m_connectedClients[socket];
-  bool error = false;
+  // NOTE: We read all available data at once and parse them
+  // from the buffer, which is much faster than reading byte after byte.
+  client_it->m_buffer.append(socket->readAll());
 
-  if (Q_LIKELY(request->m_state == HttpRequest::State::ReadingMethod)) {
-    if (Q_UNLIKELY(error = !request->readMethod(socket))) {
-      qWarningNN << LOGSEC_NETWORK << "Invalid method.";
-    }
-  }
+  switch (client_it->m_request.parse(client_it->m_buffer, m_maxBodySize)) {
+    case HttpRequest::ParseResult::Incomplete:
+      break;
 
-  if (Q_LIKELY(!error && request->m_state == HttpRequest::State::ReadingUrl)) {
-    if (Q_UNLIKELY(error = !request->readUrl(socket))) {
-      qWarningNN << LOGSEC_NETWORK << "Invalid URL.";
-    }
-  }
+    case HttpRequest::ParseResult::Malformed:
+      qWarningNN << LOGSEC_NETWORK << "Received malformed HTTP request.";
+      rejectClient(socket, 400);
+      break;
 
-  if (Q_LIKELY(!error && request->m_state == HttpRequest::State::ReadingStatus)) {
-    if (Q_UNLIKELY(error = !request->readStatus(socket))) {
-      qWarningNN << LOGSEC_NETWORK << "Invalid status.";
-    }
-  }
+    case HttpRequest::ParseResult::TooLarge:
+      qWarningNN << LOGSEC_NETWORK << "Received HTTP request is too large.";
+      rejectClient(socket, 413);
+      break;
 
-  if (Q_LIKELY(!error && request->m_state == HttpRequest::State::ReadingHeader)) {
-    if (Q_UNLIKELY(error = !request->readHeader(socket))) {
-      qWarningNN << LOGSEC_NETWORK << "Invalid header.";
+    case HttpRequest::ParseResult::Complete: {
+      // NOTE: Answering the client might disconnect it and remove it
+      // from the list of clients, so we work with copy of the request.
+      const HttpRequest request = client_it->m_request;
+
+      client_it->m_buffer.clear();
+      answerClient(socket, request);
+      break;
     }
   }
+}
 
-  if (error) {
-    socket->disconnectFromHost();
-    m_connectedClients.remove(socket);
-  }
-  else if (!request->m_url.isEmpty()) {
-    Q_ASSERT(request->m_state != HttpRequest::State::ReadingUrl);
+int HttpServer::maxConnections() const {
+  return m_maxConnections;
+}
 
-    answerClient(socket, *request);
-    m_connectedClients.remove(socket);
-  }
+void HttpServer::setMaxConnections(int max_connections) {
+  m_maxConnections = max_connections;
+}
+
+qint64 HttpServer::maxBodySize() const {
+  return m_maxBodySize;
+}
+
+void HttpServer::setMaxBodySize(qint64 max_body_size) {
+  m_maxBodySize = max_body_size;
 }
 
 QHostAddress HttpServer::listenAddress() const {
@@ -161,146 +197,134 @@ quint16 HttpServer::listenPort() const {
   return m_listenPort;
 }
 
-bool HttpServer::HttpRequest::readMethod(QTcpSocket* socket) {
-  bool finished = false;
+HttpServer::HttpRequest::ParseResult HttpServer::HttpRequest::parse(QByteArray& buffer, qint64 max_body_size) {
+  if (m_state == State::ReadingHeader) {
+    const int header_end = buffer.indexOf("\r\n\r\n");
 
-  while ((socket->bytesAvailable() != 0) && !finished) {
-    const auto c = socket->read(1).at(0);
-
-    if ((std::isupper(c) != 0) && m_fragment.size() < 7) {
-      m_fragment += c;
+    // NOTE: Header is limited even if it arrived whole in single chunk of data.
+    if (header_end < 0) {
+      return buffer.size() > HTTP_SERVER_MAX_HEADER_SIZE ? ParseResult::TooLarge : ParseResult::Incomplete;
     }
-    else {
-      finished = true;
+    else if (header_end > HTTP_SERVER_MAX_HEADER_SIZE) {
+      return ParseResult::TooLarge;
     }
-  }
 
-  if (finished) {
-    if (m_fragment == "HEAD") {
-      m_method = Method::Head;
-    }
-    else if (m_fragment == "GET") {
-      m_method = Method::Get;
-    }
-    else if (m_fragment == "PUT") {
-      m_method = Method::Put;
-    }
-    else if (m_fragment == "POST") {
-      m_method = Method::Post;
-    }
-    else if (m_fragment == "DELETE") {
-      m_method = Method::Delete;
-    }
-    else if (m_fragment == "OPTIONS") {
-      m_method = Method::Options;
-    }
-    else {
-      qWarningNN << LOGSEC_NETWORK << "Invalid operation:" << QUOTE_W_SPACE_DOT(m_fragment.data());
+    const QList<QByteArray> lines = buffer.left(header_end).split('\n');
+
+    buffer.remove(0, header_end + 4);
+
+    if (!parseRequestLine(lines.first().trimmed())) {
+      return ParseResult::Malformed;
     }
 
-    m_state = State::ReadingUrl;
-    m_fragment.clear();
+    for (int i = 1; i < lines.size(); i++) {
+      const QByteArray& line = lines.at(i);
+      const int index = line.indexOf(':');
 
-    return m_method != Method::Unknown;
-  }
+      if (index <= 0) {
+        return ParseResult::Malformed;
+      }
 
-  return true;
-}
+      m_headers.insert(line.left(index).trimmed().toLower(), line.mid(index + 1).trimmed());
+    }
 
-bool HttpServer::HttpRequest::readUrl(QTcpSocket* socket) {
-  bool finished = false;
+    if (m_headers.contains("content-length")) {
+      bool ok;
 
-  while ((socket->bytesAvailable() != 0) && !finished) {
-    const auto c = socket->read(1).at(0);
+      m_bodyLength = m_headers.value("content-length").toLongLong(&ok);
 
-    if (std::isspace(c) != 0) {
-      finished = true;
-    }
-    else {
-      m_fragment += c;
+      if (!ok || m_bodyLength < 0) {
+        return ParseResult::Malformed;
+      }
     }
-  }
 
-  if (finished) {
-    if (!m_fragment.startsWith("/")) {
-      qWarningNN << LOGSEC_NETWORK << "Invalid URL path" << QUOTE_W_SPACE_DOT(m_fragment);
-      return false;
+    if (m_bodyLength > max_body_size) {
+      return ParseResult::TooLarge;
     }
 
-    m_url.setUrl(m_address + QString::number(m_port) + QString::fromUtf8(m_fragment));
-    m_state = State::ReadingStatus;
+    m_state = State::ReadingBody;
+  }
 
-    if (!m_url.isValid()) {
-      qWarningNN << LOGSEC_NETWORK << "Invalid URL" << QUOTE_W_SPACE_DOT(m_fragment);
-      return false;
+  if (m_state == State::ReadingBody) {
+    if (buffer.size() < m_bodyLength) {
+      return ParseResult::Incomplete;
     }
 
-    m_fragment.clear();
-    return true;
+    m_body = buffer.left(int(m_bodyLength));
+    buffer.remove(0, int(m_bodyLength));
+    m_state = State::AllDone;
   }
 
-  return true;
+  return ParseResult::Complete;
 }
 
-bool HttpServer::HttpRequest::readStatus(QTcpSocket* socket) {
-  bool finished = false;
-
-  while ((socket->bytesAvailable() != 0) && !finished) {
-    m_fragment += socket->read(1);
+bool HttpServer::HttpRequest::parseRequestLine(const QByteArray& line) {
+  // Request line looks like "GET /path HTTP/1.1".
+  const QList<QByteArray> parts = line.split(' ');
 
-    if (m_fragment.endsWith("\r\n")) {
-      finished = true;
-      m_fragment.resize(m_fragment.size() - 2);
-    }
+  if (parts.size() != 3) {
+    qWarningNN << LOGSEC_NETWORK << "Invalid request line" << QUOTE_W_SPACE_DOT(line);
+    return false;
   }
 
-  if (finished) {
-    if ((std::isdigit(m_fragment.at(m_fragment.size() - 3)) == 0) ||
-        (std::isdigit(m_fragment.at(m_fragment.size() - 1)) == 0)) {
-      qWarningNN << LOGSEC_NETWORK << "Invalid version";
-      return false;
-    }
+  const QByteArray& method = parts.at(0);
+  const QByteArray& path = parts.at(1);
+  const QByteArray& version = parts.at(2);
 
-    m_version = qMakePair(m_fragment.at(m_fragment.size() - 3) - '0', m_fragment.at(m_fragment.size() - 1) - '0');
-    m_state = State::ReadingHeader;
-    m_fragment.clear();
+  if (method == "HEAD") {
+    m_method = Method::Head;
+  }
+  else if (method == "GET") {
+    m_method = Method::Get;
+  }
+  else if (method == "PUT") {
+    m_method = Method::Put;
+  }
+  else if (method == "POST") {
+    m_method = Method::Post;
+  }
+  else if (method == "DELETE") {
+    m_method = Method::Delete;
+  }
+  else if (method == "OPTIONS") {
+    m_method = Method::Options;
+  }
+  else {
+    qWarningNN << LOGSEC_NETWORK << "Invalid operation:" << QUOTE_W_SPACE_DOT(method);
+    return false;
   }
 
-  return true;
-}
-
-bool HttpServer::HttpRequest::readHeader(QTcpSocket* socket) {
-  while (socket->bytesAvailable() != 0) {
-    m_fragment += socket->read(1);
-
-    if (m_fragment.endsWith("\r\n")) {
-      if (m_fragment == "\r\n") {
-        m_state = State::ReadingBody;
-        m_fragment.clear();
-        return true;
-      }
-      else {
-        m_fragment.chop(2);
-        const int index = m_fragment.indexOf(':');
+  if (!path.startsWith('/')) {
+    qWarningNN << LOGSEC_NETWORK << "Invalid URL path" << QUOTE_W_SPACE_DOT(path);
+    return false;
+  }
 
-        if (index == -1) {
-          return false;
-        }
+  m_url.setUrl(m_address + QL1C(':') + QString::number(m_port) + QString::fromUtf8(path));
 
-        const QByteArray key = m_fragment.mid(0, index).trimmed();
-        const QByteArray value = m_fragment.mid(index + 1).trimmed();
+  if (!m_url.isValid()) {
+    qWarningNN << LOGSEC_NETWORK << "Invalid URL" << QUOTE_W_SPACE_DOT(path);
+    return false;
+  }
 
-        m_headers.insert(key, value);
-        m_fragment.clear();
-      }
-    }
+  if (!version.startsWith("HTTP/") || version.size() < 8 || (std::isdigit(version.at(version.size() - 3)) == 0) ||
+      (std::isdigit(version.at(version.size() - 1)) == 0)) {
+    qWarningNN << LOGSEC_NETWORK << "Invalid version";
+    return false;
   }
 
-  return false;
+  m_version = qMakePair(version.at(version.size() - 3) - '0', version.at(version.size() - 1) - '0');
+  return true;
 }
 
 void HttpServer::stop() {
   m_httpServer.close();
+
+  for (QTcpSocket* socket : m_connectedClients.keys()) {
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+  }
+
   m_connectedClients.clear();
   m_listenAddress = QHostAddress();
   m_listenPort = 0;
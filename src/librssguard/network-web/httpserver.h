@@ -9,7 +9,7 @@
 #include <QTcpSocket>
 #include <QUrl>
 
-class HttpServer : public QObject {
+class RSSGUARD_DLLSPEC HttpServer : public QObject {
     Q_OBJECT
 
   public:
@@ -33,6 +33,14 @@ class HttpServer : public QObject {
     // Sets full URL string, for example "http://localhost:123456".
     void setListenAddressPort(const QString& full_uri, bool start_handler);
 
+    // Maximum number of simultaneously connected clients.
+    int maxConnections() const;
+    void setMaxConnections(int max_connections);
+
+    // Maximum size of request body (in bytes) which is accepted.
+    qint64 maxBodySize() const;
+    void setMaxBodySize(qint64 max_body_size);
+
   protected:
     struct HttpHeader {
         QString m_name;
@@ -42,19 +50,24 @@ class HttpServer : public QObject {
     QByteArray generateHttpAnswer(int http_code, const QList<HttpHeader>& headers, const QByteArray& body = {}) const;
 
     struct HttpRequest {
-        bool readMethod(QTcpSocket* socket);
-        bool readUrl(QTcpSocket* socket);
-        bool readStatus(QTcpSocket* socket);
-        bool readHeader(QTcpSocket* socket);
+        enum class ParseResult {
+          Incomplete,
+          Complete,
+          Malformed,
+          TooLarge
+        };
+
+        // Consumes data of this request from the beginning of the buffer.
+        // Data which follow after the request are left in the buffer.
+        ParseResult parse(QByteArray& buffer, qint64 max_body_size);
+
+        bool parseRequestLine(const QByteArray& line);
 
         enum class State {
-          ReadingMethod,
-          ReadingUrl,
-          ReadingStatus,
           ReadingHeader,
           ReadingBody,
           AllDone
-        } m_state = State::ReadingMethod;
+        } m_state = State::ReadingHeader;
 
         enum class Method {
           Unknown,
@@ -68,10 +81,11 @@ class HttpServer : public QObject {
 
         QString m_address;
         quint16 m_port = 0;
-        QByteArray m_fragment;
         QUrl m_url;
         QPair<quint8, quint8> m_version;
         QMap<QByteArray, QByteArray> m_headers;
+        qint64 m_bodyLength = 0;
+        QByteArray m_body;
     };
 
     virtual void answerClient(QTcpSocket* socket, const HttpRequest& request) = 0;
@@ -80,14 +94,22 @@ class HttpServer : public QObject {
     void clientConnected();
 
   private:
+    struct HttpClient {
+        QByteArray m_buffer;
+        HttpRequest m_request;
+    };
+
     void readReceivedData(QTcpSocket* socket);
+    void rejectClient(QTcpSocket* socket, int http_code);
 
   private:
-    QMap<QTcpSocket*, HttpRequest> m_connectedClients;
+    QMap<QTcpSocket*, HttpClient> m_connectedClients;
     QTcpServer m_httpServer;
     QHostAddress m_listenAddress;
     quint16 m_listenPort;
     QString m_listenAddressPort;
+    int m_maxConnections;
+    qint64 m_maxBodySize;
 };
 
 #endif // HTTPSERVER_H
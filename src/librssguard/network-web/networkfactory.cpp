@@ -3,6 +3,7 @@
 #include "network-web/networkfactory.h"
 
 #include "definitions/definitions.h"
+#include "miscellaneous/tracer.h"
 #include "network-web/downloader.h"
 
 #include <QEventLoop>
@@ -294,6 +295,8 @@ NetworkResult NetworkFactory::performNetworkOperation(const QString& url,
 
   output = downloader.lastOutputData();
 
+  TRACE_COUNTER("network-bytes-received", output.size());
+
   result.m_networkError = downloader.lastOutputError();
   result.m_contentType = downloader.lastContentType();
   result.m_cookies = downloader.lastCookies();
@@ -0,0 +1,180 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "network-web/networkreplydevice.h"
+
+#include "definitions/definitions.h"
+#include "network-web/networkfactory.h"
+#include "network-web/silentnetworkaccessmanager.h"
+
+#include <QEventLoop>
+#include <QTimer>
+
+NetworkReplyDevice::NetworkReplyDevice(const QUrl& url,
+                                       int timeout,
+                                       const QList<QPair<QByteArray, QByteArray>>& headers,
+                                       const QNetworkProxy& proxy,
+                                       QObject* parent)
+  : QIODevice(parent), m_url(url), m_timeout(timeout), m_headers(headers),
+    m_network(new SilentNetworkAccessManager()), m_reply(nullptr), m_redirects(0),
+    m_error(QNetworkReply::NetworkError::NoError) {
+  if (proxy.type() != QNetworkProxy::ProxyType::DefaultProxy) {
+    m_network->setProxy(proxy);
+  }
+}
+
+NetworkReplyDevice::~NetworkReplyDevice() {
+  close();
+}
+
+bool NetworkReplyDevice::isSequential() const {
+  return true;
+}
+
+bool NetworkReplyDevice::atEnd() const {
+  return QIODevice::atEnd() && (m_reply == nullptr || m_reply->isFinished());
+}
+
+qint64 NetworkReplyDevice::bytesAvailable() const {
+  return QIODevice::bytesAvailable() + (isFinalReply() ? m_reply->bytesAvailable() : 0);
+}
+
+bool NetworkReplyDevice::open(OpenMode mode) {
+  if (mode != QIODevice::OpenModeFlag::ReadOnly || isOpen()) {
+    return false;
+  }
+
+  m_redirects = 0;
+  m_error = QNetworkReply::NetworkError::NoError;
+
+  sendRequest(m_url);
+
+  // NOTE: Empty body is fine, for example HTTP/304 has none.
+  if (!waitForData() && m_error != QNetworkReply::NetworkError::NoError) {
+    setErrorString(NetworkFactory::networkErrorText(m_error));
+    return false;
+  }
+
+  return QIODevice::open(mode);
+}
+
+void NetworkReplyDevice::close() {
+  if (m_reply != nullptr) {
+    m_reply->abort();
+    delete m_reply;
+    m_reply = nullptr;
+  }
+
+  QIODevice::close();
+}
+
+QNetworkReply::NetworkError NetworkReplyDevice::error() const {
+  return m_error;
+}
+
+int NetworkReplyDevice::httpCode() const {
+  return m_reply == nullptr ? 0 : m_reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute).toInt();
+}
+
+QByteArray NetworkReplyDevice::rawHeader(const QByteArray& name) const {
+  return m_reply == nullptr ? QByteArray() : m_reply->rawHeader(name);
+}
+
+qint64 NetworkReplyDevice::readData(char* data, qint64 max_size) {
+  if (!waitForData()) {
+    if (m_error != QNetworkReply::NetworkError::NoError) {
+      setErrorString(NetworkFactory::networkErrorText(m_error));
+      return -1;
+    }
+
+    return 0;
+  }
+
+  return m_reply->read(data, max_size);
+}
+
+qint64 NetworkReplyDevice::writeData(const char* data, qint64 max_size) {
+  Q_UNUSED(data)
+  Q_UNUSED(max_size)
+
+  return -1;
+}
+
+void NetworkReplyDevice::sendRequest(const QUrl& url) {
+  QNetworkRequest request(url);
+
+  for (const auto& header : std::as_const(m_headers)) {
+    if (!header.first.isEmpty()) {
+      request.setRawHeader(header.first, header.second);
+    }
+  }
+
+  m_reply = m_network->get(request);
+}
+
+bool NetworkReplyDevice::isFinalReply() const {
+  return m_reply != nullptr &&
+         !m_reply->attribute(QNetworkRequest::Attribute::RedirectionTargetAttribute).toUrl().isValid() &&
+         httpCode() < 400;
+}
+
+bool NetworkReplyDevice::waitForData() {
+  while (m_reply != nullptr) {
+    if (isFinalReply() && m_reply->bytesAvailable() > 0) {
+      return true;
+    }
+
+    if (!m_reply->isFinished()) {
+      if (!waitForReply()) {
+        qWarningNN << LOGSEC_NETWORK << "Reading of" << QUOTE_W_SPACE(m_reply->url().toString()) << "timed out.";
+
+        m_error = QNetworkReply::NetworkError::TimeoutError;
+        m_reply->abort();
+        return false;
+      }
+
+      continue;
+    }
+
+    const QUrl redirection_url = m_reply->attribute(QNetworkRequest::Attribute::RedirectionTargetAttribute).toUrl();
+
+    if (m_reply->error() != QNetworkReply::NetworkError::NoError || !redirection_url.isValid()) {
+      m_error = m_reply->error();
+      return false;
+    }
+
+    if (++m_redirects > MAX_NUMBER_OF_REDIRECTIONS) {
+      qDebugNN << LOGSEC_NETWORK << "Aborting request due too many redirections.";
+
+      m_error = QNetworkReply::NetworkError::TooManyRedirectsError;
+      return false;
+    }
+
+    const QUrl next_url = m_reply->url().resolved(redirection_url);
+
+    qDebugNN << LOGSEC_NETWORK << "Following redirection to" << QUOTE_W_SPACE_DOT(next_url.toString());
+
+    delete m_reply;
+    sendRequest(next_url);
+  }
+
+  return false;
+}
+
+bool NetworkReplyDevice::waitForReply() {
+  QEventLoop loop;
+  QTimer timer;
+
+  timer.setSingleShot(true);
+
+  connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+  connect(m_reply, &QNetworkReply::readyRead, &loop, &QEventLoop::quit);
+  connect(m_reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+
+  if (m_timeout > 0) {
+    timer.start(m_timeout);
+  }
+
+  loop.exec();
+
+  return m_timeout <= 0 || timer.isActive();
+}
@@ -0,0 +1,71 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef NETWORKREPLYDEVICE_H
+#define NETWORKREPLYDEVICE_H
+
+#include <QIODevice>
+#include <QNetworkProxy>
+#include <QNetworkReply>
+#include <QScopedPointer>
+#include <QUrl>
+
+class SilentNetworkAccessManager;
+
+// Read-only sequential device which reads body of HTTP GET reply while it is
+// being downloaded, so that whole response never has to be held in memory.
+//
+// Reading blocks calling thread until more data arrive. HTTP redirections are
+// followed, bodies of redirections and of erroneous replies are never returned.
+class RSSGUARD_DLLSPEC NetworkReplyDevice : public QIODevice {
+    Q_OBJECT
+
+  public:
+    explicit NetworkReplyDevice(const QUrl& url,
+                                int timeout,
+                                const QList<QPair<QByteArray, QByteArray>>& headers,
+                                const QNetworkProxy& proxy = QNetworkProxy::ProxyType::DefaultProxy,
+                                QObject* parent = nullptr);
+    virtual ~NetworkReplyDevice();
+
+    virtual bool isSequential() const;
+    virtual bool atEnd() const;
+    virtual qint64 bytesAvailable() const;
+
+    // Sends the request and waits until first data of final reply arrive,
+    // fails if the request fails before that.
+    virtual bool open(OpenMode mode);
+    virtual void close();
+
+    QNetworkReply::NetworkError error() const;
+    int httpCode() const;
+    QByteArray rawHeader(const QByteArray& name) const;
+
+  protected:
+    virtual qint64 readData(char* data, qint64 max_size);
+    virtual qint64 writeData(const char* data, qint64 max_size);
+
+  private:
+    void sendRequest(const QUrl& url);
+
+    // Returns true if body of current reply is the actual response.
+    bool isFinalReply() const;
+
+    // Waits until there are data to be read, follows redirections. Returns
+    // false if there are no more data to be read.
+    bool waitForData();
+
+    // Processes events until current reply emits some data or finishes,
+    // returns false if nothing happened in given timeout.
+    bool waitForReply();
+
+  private:
+    QUrl m_url;
+    int m_timeout;
+    QList<QPair<QByteArray, QByteArray>> m_headers;
+    QScopedPointer<SilentNetworkAccessManager> m_network;
+    QNetworkReply* m_reply;
+    int m_redirects;
+    QNetworkReply::NetworkError m_error;
+};
+
+#endif // NETWORKREPLYDEVICE_H
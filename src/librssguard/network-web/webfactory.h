@@ -82,9 +82,6 @@ class RSSGUARD_DLLSPEC WebFactory : public QObject {
     QAction* createEngineSettingsAction(const QString& title, int web_attribute);
 #endif
 
-  private:
-    static QMap<QString, char16_t> generateUnescapes();
-
   private:
     AdBlockManager* m_adBlock;
 
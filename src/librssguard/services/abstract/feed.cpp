@@ -201,13 +201,6 @@ void Feed::setIsRtl(bool rtl) {
   m_isRtl = rtl;
 }
 
-bool Feed::removeUnwantedArticles(QSqlDatabase& db) {
-  Feed::ArticleIgnoreLimit feed_setup = articleIgnoreLimit();
-  Feed::ArticleIgnoreLimit app_setup = Feed::ArticleIgnoreLimit::fromSettings();
-
-  return DatabaseQueries::removeUnwantedArticlesFromFeed(db, this, feed_setup, app_setup);
-}
-
 void Feed::appendMessageFilter(MessageFilter* filter) {
   removeMessageFilter(filter);
   m_messageFilters.append(QPointer<MessageFilter>(filter));
@@ -303,6 +296,14 @@ QString Feed::getStatusDescription() const {
   }
 }
 
+bool Feed::prefetchFullArticles() const {
+  return false;
+}
+
+QList<QPair<QByteArray, QByteArray>> Feed::articleHttpHeaders() const {
+  return {};
+}
+
 Feed::ArticleIgnoreLimit& Feed::articleIgnoreLimit() {
   return m_articleIgnoreLimit;
 }
@@ -390,19 +391,16 @@ Qt::ItemFlags Feed::additionalFlags() const {
 Feed::ArticleIgnoreLimit Feed::ArticleIgnoreLimit::fromSettings() {
   Feed::ArticleIgnoreLimit art_limit;
 
-  art_limit.m_avoidOldArticles = qApp->settings()->value(GROUP(Messages), SETTING(Messages::AvoidOldArticles)).toBool();
-  art_limit.m_dtToAvoid =
-    qApp->settings()->value(GROUP(Messages), SETTING(Messages::DateTimeToAvoidArticle)).toDateTime();
-  art_limit.m_hoursToAvoid = qApp->settings()->value(GROUP(Messages), SETTING(Messages::HoursToAvoidArticle)).toInt();
-
-  art_limit.m_doNotRemoveStarred =
-    qApp->settings()->value(GROUP(Messages), SETTING(Messages::LimitDoNotRemoveStarred)).toBool();
-  art_limit.m_doNotRemoveUnread =
-    qApp->settings()->value(GROUP(Messages), SETTING(Messages::LimitDoNotRemoveUnread)).toBool();
-  art_limit.m_keepCountOfArticles =
-    qApp->settings()->value(GROUP(Messages), SETTING(Messages::LimitCountOfArticles)).toInt();
-  art_limit.m_moveToBinDontPurge =
-    qApp->settings()->value(GROUP(Messages), SETTING(Messages::LimitRecycleInsteadOfPurging)).toBool();
+  const QSharedPointer<const SettingsSnapshot> settings = qApp->settings()->snapshot();
+
+  art_limit.m_avoidOldArticles = settings->m_avoidOldArticles;
+  art_limit.m_dtToAvoid = settings->m_dateTimeToAvoidArticle;
+  art_limit.m_hoursToAvoid = settings->m_hoursToAvoidArticle;
+
+  art_limit.m_doNotRemoveStarred = settings->m_limitDoNotRemoveStarred;
+  art_limit.m_doNotRemoveUnread = settings->m_limitDoNotRemoveUnread;
+  art_limit.m_keepCountOfArticles = settings->m_limitCountOfArticles;
+  art_limit.m_moveToBinDontPurge = settings->m_limitRecycleInsteadOfPurging;
 
   return art_limit;
 }
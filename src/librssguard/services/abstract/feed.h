@@ -71,6 +71,13 @@ class RSSGUARD_DLLSPEC Feed : public RootItem {
     virtual bool isFetching() const;
     virtual QVariant data(int column, int role) const;
 
+    // If true, linked pages of new articles are downloaded during
+    // feed updates and their extracted contents are stored with articles.
+    virtual bool prefetchFullArticles() const;
+
+    // HTTP headers to use when downloading linked pages of articles.
+    virtual QList<QPair<QByteArray, QByteArray>> articleHttpHeaders() const;
+
     void setCountOfAllMessages(int count_all_messages);
     void setCountOfUnreadMessages(int count_unread_messages);
 
@@ -107,8 +114,6 @@ class RSSGUARD_DLLSPEC Feed : public RootItem {
     bool isRtl() const;
     void setIsRtl(bool rtl);
 
-    bool removeUnwantedArticles(QSqlDatabase& db);
-
     ArticleIgnoreLimit& articleIgnoreLimit();
     const ArticleIgnoreLimit& articleIgnoreLimit() const;
     void setArticleIgnoreLimit(const ArticleIgnoreLimit& ignore_limit);
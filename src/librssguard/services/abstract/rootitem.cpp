@@ -23,7 +23,8 @@ RootItem::RootItem(const RootItem& other) : RootItem(nullptr) {
   setTitle(other.title());
   setId(other.id());
   setCustomId(other.customId());
-  setIcon(other.icon());
+  m_icon = other.m_icon;
+  m_iconKey = other.m_iconKey;
   setKeepOnTop(other.keepOnTop());
   setSortOrder(other.sortOrder());
 
@@ -496,11 +497,25 @@ void RootItem::setKind(RootItem::Kind kind) {
 }
 
 QIcon RootItem::icon() const {
+  if (m_icon.isNull() && !m_iconKey.isEmpty()) {
+    return qApp->icons()->storedIcon(m_iconKey);
+  }
+
   return m_icon;
 }
 
 void RootItem::setIcon(const QIcon& icon) {
   m_icon = icon;
+  m_iconKey.clear();
+}
+
+QString RootItem::iconKey() const {
+  return m_iconKey;
+}
+
+void RootItem::setIconKey(const QString& key) {
+  m_iconKey = key;
+  m_icon = QIcon();
 }
 
 QIcon RootItem::fullIcon() const {
@@ -172,6 +172,10 @@ class RSSGUARD_DLLSPEC RootItem : public QObject {
     QIcon icon() const;
     void setIcon(const QIcon& icon);
 
+    // Key of icon in icon store, icon is then decoded only when needed.
+    QString iconKey() const;
+    void setIconKey(const QString& key);
+
     // Returns icon, even if item has "default" icon set, then
     // this icon is extra loaded and returned.
     QIcon fullIcon() const;
@@ -232,6 +236,7 @@ class RSSGUARD_DLLSPEC RootItem : public QObject {
     QString m_title;
     QString m_description;
     QIcon m_icon;
+    QString m_iconKey;
     QDateTime m_creationDate;
     bool m_keepOnTop;
     int m_sortOrder;
@@ -26,10 +26,13 @@
 #include "services/abstract/searchsnode.h"
 #include "services/abstract/unreadnode.h"
 
+#include <QThread>
+
 ServiceRoot::ServiceRoot(RootItem* parent)
   : RootItem(parent), m_recycleBin(new RecycleBin(this)), m_importantNode(new ImportantNode(this)),
     m_labelsNode(new LabelsNode(this)), m_probesNode(new SearchsNode(this)), m_unreadNode(new UnreadNode(this)),
-    m_accountId(NO_PARENT_CATEGORY), m_networkProxy(QNetworkProxy()) {
+    m_accountId(NO_PARENT_CATEGORY), m_networkProxy(QNetworkProxy()), m_specialNodesDirty(0),
+    m_structurePreloaded(false) {
   setKind(RootItem::Kind::ServiceRoot);
   appendCommonNodes();
 }
@@ -228,6 +231,10 @@ CustomMessagePreviewer* ServiceRoot::customMessagePreviewer() {
 }
 
 void ServiceRoot::updateCounts(bool including_total_count) {
+  updateCountsOfTree(including_total_count, nullptr);
+}
+
+void ServiceRoot::updateCountsOfTree(bool including_total_count, const QMap<QString, ArticleCounts>* feed_counts) {
   QList<Feed*> feeds;
   auto str = getSubTree();
 
@@ -245,10 +252,17 @@ void ServiceRoot::updateCounts(bool including_total_count) {
     return;
   }
 
-  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
-  bool ok;
-  QMap<QString, ArticleCounts> counts =
-    DatabaseQueries::getMessageCountsForAccount(database, accountId(), including_total_count, &ok);
+  bool ok = true;
+  QMap<QString, ArticleCounts> counts;
+
+  if (feed_counts != nullptr) {
+    counts = *feed_counts;
+  }
+  else {
+    QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+
+    counts = DatabaseQueries::getMessageCountsForAccount(database, accountId(), including_total_count, &ok);
+  }
 
   if (ok) {
     for (Feed* feed : feeds) {
@@ -736,10 +750,74 @@ void ServiceRoot::performInitialAssembly(const Assignment& categories,
   updateCounts(true);
 }
 
+void ServiceRoot::preloadFromDatabase() {
+  QSqlDatabase database = qApp->database()->driver()->threadSafeConnection(metaObject()->className());
+
+  // NOTE: All accounts are preloaded in parallel, so nothing can be written
+  // to database. Connection of worker thread refuses writes meanwhile.
+  DatabaseQueries::setConnectionReadOnly(database, true);
+
+  try {
+    AccountStructure structure = structureFromDatabase(database);
+
+    structure.m_counts =
+      DatabaseQueries::getMessageCountsForAccount(database, accountId(), true, &structure.m_countsLoaded);
+
+    // NOTE: Items were created in this worker thread but they
+    // will be used by the model in main thread.
+    QThread* main_thread = qApp->thread();
+
+    for (const AssignmentItem& cat : std::as_const(structure.m_categories)) {
+      cat.second->moveToThread(main_thread);
+    }
+
+    for (const AssignmentItem& fd : std::as_const(structure.m_feeds)) {
+      fd.second->moveToThread(main_thread);
+    }
+
+    m_preloadedStructure = structure;
+    m_structurePreloaded = true;
+  }
+  catch (const ApplicationException& ex) {
+    qWarningNN << LOGSEC_CORE << "Failed to preload account" << QUOTE_W_SPACE(title())
+               << "from database, it will be loaded in main thread:" << QUOTE_W_SPACE_DOT(ex.message());
+  }
+
+  DatabaseQueries::setConnectionReadOnly(database, false);
+}
+
+void ServiceRoot::loadFromDatabase() {
+  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+  AccountStructure structure;
+
+  if (m_structurePreloaded) {
+    structure = m_preloadedStructure;
+    m_preloadedStructure = {};
+    m_structurePreloaded = false;
+  }
+  else {
+    structure = structureFromDatabase(database);
+  }
+
+  // NOTE: Labels and probes generate their icons, so they are
+  // always loaded in main thread.
+  assembleCategories(structure.m_categories);
+  assembleFeeds(structure.m_feeds);
+  labelsNode()->loadLabels(DatabaseQueries::getLabelsForAccount(database, accountId()));
+  probesNode()->loadProbes(DatabaseQueries::getProbesForAccount(database, accountId()));
+
+  updateCountsOfTree(true, structure.m_countsLoaded ? &structure.m_counts : nullptr);
+}
+
 RootItem* ServiceRoot::obtainNewTreeForSyncIn() const {
   return nullptr;
 }
 
+AccountStructure ServiceRoot::structureFromDatabase(const QSqlDatabase& db) const {
+  Q_UNUSED(db)
+  return {};
+}
+
 QStringList ServiceRoot::customIDSOfMessagesForItem(RootItem* item, ReadStatus target_read) {
   if (item->getParentServiceRoot() != this) {
     // Not item from this account.
@@ -912,8 +990,10 @@ bool ServiceRoot::loadMessagesForItem(RootItem* item, MessagesModel* model) {
     itemChanged({item});
 
     model->setFilter(QSL("Messages.is_deleted = 0 AND Messages.is_pdeleted = 0 AND Messages.account_id = %1 AND "
-                         "(Messages.title REGEXP '%2' OR Messages.contents REGEXP '%2')")
-                       .arg(QString::number(accountId()), item->toProbe()->filter()));
+                         "(Messages.title REGEXP '%2' OR %3 REGEXP '%2')")
+                       .arg(QString::number(accountId()),
+                            item->toProbe()->filter(),
+                            DatabaseQueries::contentsColumn()));
   }
   else if (item->kind() == RootItem::Kind::Label) {
     // Show messages with particular label.
@@ -1290,36 +1370,57 @@ UpdatedArticles ServiceRoot::updateMessages(QList<Message>& messages, Feed* feed
     qDebugNN << "No messages to be updated/added in DB for feed" << QUOTE_W_SPACE_DOT(feed->customId());
   }
 
-  bool anything_removed = feed->removeUnwantedArticles(database);
-
-  if (anything_removed || !updated_messages.m_unread.isEmpty() || !updated_messages.m_all.isEmpty()) {
+  // NOTE: Old articles are removed only once when all feeds are
+  // fetched, see FeedDownloader.
+  if (!updated_messages.m_unread.isEmpty() || !updated_messages.m_all.isEmpty()) {
     QMutexLocker lck(db_mutex);
 
     // Something was added or updated in the DB, update numbers.
     feed->updateCounts(true);
 
-    if (recycleBin() != nullptr) {
-      recycleBin()->updateCounts(true);
-    }
+    // Counts of special nodes are aggregated across whole account,
+    // update them only once when all feeds are processed.
+    m_specialNodesDirty.storeRelease(1);
+  }
 
-    if (importantNode() != nullptr) {
-      importantNode()->updateCounts(true);
-    }
+  // NOTE: Do not update model items here. We update only once when all feeds are fetched
+  // or separately in downloader, if user has this enabled.
+  return updated_messages;
+}
 
-    if (unreadNode() != nullptr) {
-      unreadNode()->updateCounts(true);
-    }
+void ServiceRoot::updateCountsOfAllFeeds(const QSqlDatabase& db) {
+  bool ok = false;
+  QMap<QString, ArticleCounts> counts = DatabaseQueries::getMessageCountsForAccount(db, accountId(), true, &ok);
 
-    if (labelsNode() != nullptr) {
-      labelsNode()->updateCounts(true);
-    }
+  if (ok) {
+    updateCountsOfTree(true, &counts);
+  }
 
-    if (probesNode() != nullptr) {
-      probesNode()->updateCounts(true);
-    }
+  m_specialNodesDirty.storeRelease(1);
+}
+
+void ServiceRoot::updateCountsOfDirtyNodes() {
+  if (!m_specialNodesDirty.testAndSetAcquire(1, 0)) {
+    return;
   }
 
-  // NOTE: Do not update model items here. We update only once when all feeds are fetched
-  // or separately in downloader, if user has this enabled.
-  return updated_messages;
+  if (recycleBin() != nullptr) {
+    recycleBin()->updateCounts(true);
+  }
+
+  if (importantNode() != nullptr) {
+    importantNode()->updateCounts(true);
+  }
+
+  if (unreadNode() != nullptr) {
+    unreadNode()->updateCounts(true);
+  }
+
+  if (labelsNode() != nullptr) {
+    labelsNode()->updateCounts(true);
+  }
+
+  if (probesNode() != nullptr) {
+    probesNode()->updateCounts(true);
+  }
 }
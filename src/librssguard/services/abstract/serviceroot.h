@@ -7,12 +7,14 @@
 #include "definitions/typedefs.h"
 #include "services/abstract/rootitem.h"
 
+#include <QAtomicInt>
 #include <QJsonDocument>
 #include <QNetworkProxy>
 #include <QPair>
 
 class QAction;
 class QMutex;
+class QSqlDatabase;
 class FeedsModel;
 class RecycleBin;
 class ImportantNode;
@@ -208,8 +210,19 @@ class RSSGUARD_DLLSPEC ServiceRoot : public RootItem {
     void completelyRemoveAllData();
 
     // Returns counts of updated messages <unread, all>.
+    // NOTE: Counts of "special" nodes (recycle bin, labels, ...) are not updated here,
+    // the nodes are only marked dirty, call updateCountsOfDirtyNodes() once all
+    // feeds are updated.
     UpdatedArticles updateMessages(QList<Message>& messages, Feed* feed, bool force_update, QMutex* db_mutex);
 
+    // Updates counts of "special" nodes if some articles
+    // were changed since last call.
+    void updateCountsOfDirtyNodes();
+
+    // Reloads counts of all feeds with single query and marks "special" nodes
+    // dirty. Used when articles of many feeds were changed at once.
+    void updateCountsOfAllFeeds(const QSqlDatabase& db);
+
     QIcon feedIconForMessage(const QString& feed_custom_id) const;
 
     // Removes all/read only messages from given underlying feeds.
@@ -247,6 +260,11 @@ class RSSGUARD_DLLSPEC ServiceRoot : public RootItem {
                                 const QList<Label*>& labels,
                                 const QList<Search*>& probes);
 
+    // Reads categories, feeds and article counts of the account from database
+    // ahead of start(), which then only assembles the tree.
+    // NOTE: This is called from worker threads during application startup.
+    void preloadFromDatabase();
+
     bool nodeShowUnread() const;
     void setNodeShowUnread(bool enabled);
 
@@ -268,6 +286,14 @@ class RSSGUARD_DLLSPEC ServiceRoot : public RootItem {
     // This method should obtain new tree of feed/categories/whatever to perform sync in.
     virtual RootItem* obtainNewTreeForSyncIn() const;
 
+    // Returns categories and feeds of the account as stored in database, usually via
+    // DatabaseQueries::getAccountStructure(). Must be callable from worker thread.
+    virtual AccountStructure structureFromDatabase(const QSqlDatabase& db) const;
+
+    // Assembles the tree of the account from preloaded structure or
+    // from database if the structure was not preloaded.
+    void loadFromDatabase();
+
     // Removes all messages/categories/feeds which are
     // associated with this account.
     void removeOldAccountFromDatabase(bool delete_messages_too, bool delete_labels_too);
@@ -303,6 +329,10 @@ class RSSGUARD_DLLSPEC ServiceRoot : public RootItem {
     void itemRemovalRequested(RootItem* item);
 
   private:
+    // Updates counts of all nodes, feed counts are taken from "feed_counts" if
+    // it is provided, otherwise they are read from database.
+    void updateCountsOfTree(bool including_total_count, const QMap<QString, ArticleCounts>* feed_counts);
+
     void resortAccountTree(RootItem* tree,
                            const QMap<QString, QVariantMap>& custom_category_data,
                            const QMap<QString, QVariantMap>& custom_feed_data) const;
@@ -330,6 +360,9 @@ class RSSGUARD_DLLSPEC ServiceRoot : public RootItem {
     bool m_nodeShowImportant;
     bool m_nodeShowLabels;
     bool m_nodeShowProbes;
+    QAtomicInt m_specialNodesDirty;
+    AccountStructure m_preloadedStructure;
+    bool m_structurePreloaded;
 };
 
 #if QT_VERSION_MAJOR == 6
@@ -0,0 +1,84 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "benchmark.h"
+
+#include "definitions/definitions.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+Benchmark::Benchmark(int repeats) : m_repeats(qMax(1, repeats)) {}
+
+void Benchmark::measure(const QString& name, qint64 items, const std::function<void()>& run) {
+  measure(name, items, {}, run);
+}
+
+void Benchmark::measure(const QString& name,
+                        qint64 items,
+                        const std::function<void()>& prepare,
+                        const std::function<void()>& run) {
+  QList<double> times;
+  QElapsedTimer tmr;
+
+  std::cerr << "Running " << name.toStdString() << "..." << std::endl;
+
+  for (int i = 0; i < m_repeats; i++) {
+    if (prepare) {
+      prepare();
+    }
+
+    tmr.start();
+    run();
+    times.append(tmr.nsecsElapsed() / 1000000.0);
+  }
+
+  appendResult(name, items, times);
+}
+
+void Benchmark::measureOnce(const QString& name, qint64 items, const std::function<void()>& run) {
+  QElapsedTimer tmr;
+
+  std::cerr << "Running " << name.toStdString() << "..." << std::endl;
+
+  tmr.start();
+  run();
+
+  appendResult(name, items, {tmr.nsecsElapsed() / 1000000.0});
+}
+
+void Benchmark::appendResult(const QString& name, qint64 items, QList<double> times) {
+  std::sort(times.begin(), times.end());
+
+  double sum = std::accumulate(times.begin(), times.end(), 0.0);
+  double median = times.at(times.size() / 2);
+  QJsonObject result;
+
+  result.insert(QSL("name"), name);
+  result.insert(QSL("items"), double(items));
+  result.insert(QSL("repeats"), int(times.size()));
+  result.insert(QSL("min_ms"), times.first());
+  result.insert(QSL("median_ms"), median);
+  result.insert(QSL("mean_ms"), sum / times.size());
+  result.insert(QSL("max_ms"), times.last());
+  result.insert(QSL("items_per_sec"), median > 0.0 ? items * 1000.0 / median : 0.0);
+
+  m_results.append(result);
+}
+
+void Benchmark::annotate(const QString& key, const QJsonValue& value) {
+  if (m_results.isEmpty()) {
+    return;
+  }
+
+  QJsonObject result = m_results.last().toObject();
+
+  result.insert(key, value);
+  m_results.replace(m_results.size() - 1, result);
+}
+
+QJsonArray Benchmark::results() const {
+  return m_results;
+}
@@ -0,0 +1,45 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+
+#include <functional>
+
+// Measures run times of benchmark cases and collects results.
+class Benchmark {
+  public:
+    explicit Benchmark(int repeats);
+
+    // Runs given function repeatedly. Number of items processed by
+    // single run is used to calculate throughput.
+    void measure(const QString& name, qint64 items, const std::function<void()>& run);
+
+    // Same as above but each run is prepared by given function first
+    // and the preparation is not measured.
+    void measure(const QString& name,
+                 qint64 items,
+                 const std::function<void()>& prepare,
+                 const std::function<void()>& run);
+
+    // Runs given function exactly once, for cases which change
+    // state permanently.
+    void measureOnce(const QString& name, qint64 items, const std::function<void()>& run);
+
+    // Adds arbitrary value to the result of last measured case.
+    void annotate(const QString& key, const QJsonValue& value);
+
+    QJsonArray results() const;
+
+  private:
+    void appendResult(const QString& name, qint64 items, QList<double> times);
+
+  private:
+    int m_repeats;
+    QJsonArray m_results;
+};
+
+#endif // BENCHMARK_H
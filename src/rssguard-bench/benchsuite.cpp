@@ -0,0 +1,835 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "benchsuite.h"
+
+#include "legacyhtml.h"
+
+#include "core/feedsmodel.h"
+#include "core/feedsproxymodel.h"
+#include "core/messagesmodel.h"
+#include "database/databasefactory.h"
+#include "database/databasequeries.h"
+#include "definitions/definitions.h"
+#include "exceptions/applicationexception.h"
+#include "gui/webviewers/qtextbrowser/textbrowserresourceloader.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
+#include "miscellaneous/settings.h"
+#include "miscellaneous/textfactory.h"
+#include "network-web/apiserver.h"
+#include "network-web/articleextractor.h"
+#include "network-web/webfactory.h"
+#include "src/definitions.h"
+#include "src/parsers/atomparser.h"
+#include "src/parsers/icalparser.h"
+#include "src/parsers/jsonparser.h"
+#include "src/parsers/rssparser.h"
+#include "src/standardcategory.h"
+#include "src/standardfeed.h"
+#include "src/standardserviceroot.h"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QNetworkAccessManager>
+#include <QNetworkProxy>
+#include <QNetworkReply>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTimer>
+
+#include <algorithm>
+
+#define BENCH_FILL_BATCH_SIZE     10000
+#define BENCH_UPDATE_FEEDS        10
+#define BENCH_UPDATE_TIMEOUT      (30 * 60 * 1000)
+#define BENCH_DATETIMES           100000
+#define BENCH_SETTINGS_READS      1000000
+#define BENCH_SANITIZED_ARTICLES  20000
+#define BENCH_ESCAPED_BODIES      1000
+#define BENCH_ESCAPED_PARAGRAPHS  50
+#define BENCH_DB_CONNECTION       "BenchSuite"
+#define BENCH_KEEP_ARTICLES       100
+#define BENCH_EXTRACTED_PAGES     100
+#define BENCH_NESTED_DEPTH        100000
+#define BENCH_IMAGES              20
+#define BENCH_IMAGE_WIDTH         1600
+#define BENCH_IMAGE_HEIGHT        1200
+#define BENCH_IMAGE_VIEWER_WIDTH  800
+#define BENCH_API_REQUESTS        500
+#define BENCH_API_CLIENTS         16
+#define BENCH_API_ROW_LIMIT       100
+#define BENCH_FILTER_CATEGORIES   200
+#define BENCH_FILTER_FEEDS        100
+#define BENCH_FILTER_PHRASE       8
+
+BenchSuite::BenchSuite(const Options& options)
+  : m_options(options), m_benchmark(options.m_repeats), m_generator(options.m_seed), m_root(nullptr) {}
+
+QJsonObject BenchSuite::run() {
+  if (!m_server.start()) {
+    throw ApplicationException(QSL("local HTTP server failed to start: %1").arg(m_server.errorString()));
+  }
+
+  m_database = qApp->database()->driver()->connection(QSL(BENCH_DB_CONNECTION));
+
+  benchmarkParsers();
+  benchmarkDateTimes();
+  benchmarkSettings();
+  benchmarkSanitize();
+  benchmarkHtmlUnescape();
+  benchmarkArticleExtractor();
+  benchmarkImageLoading();
+
+  prepareAccount();
+  fillDatabase();
+
+  benchmarkUpdateMessages();
+  benchmarkCounts();
+  benchmarkMessagesModel();
+  benchmarkApiServer();
+  benchmarkFeedUpdate();
+  benchmarkArticleLimits();
+  benchmarkCompression();
+  benchmarkFeedFilter();
+
+  QJsonObject config;
+
+  config.insert(QSL("articles"), m_options.m_articles);
+  config.insert(QSL("feeds"), m_options.m_feeds);
+  config.insert(QSL("items"), m_options.m_items);
+  config.insert(QSL("repeats"), m_options.m_repeats);
+  config.insert(QSL("seed"), double(m_options.m_seed));
+  config.insert(QSL("database"), qApp->database()->driver()->humanDriverType());
+
+  QJsonObject report;
+
+  report.insert(QSL("version"), QSL(APP_VERSION));
+  report.insert(QSL("revision"), QSL(APP_REVISION));
+  report.insert(QSL("qt"), QString::fromLatin1(qVersion()));
+  report.insert(QSL("date"), QDateTime::currentDateTimeUtc().toString(Qt::DateFormat::ISODate));
+  report.insert(QSL("config"), config);
+  report.insert(QSL("results"), m_benchmark.results());
+
+  return report;
+}
+
+void BenchSuite::benchmarkParsers() {
+  const QByteArray rss = m_generator.rssFeed(0, m_options.m_items);
+  const QByteArray atom = m_generator.atomFeed(0, m_options.m_items);
+  const QByteArray json = m_generator.jsonFeed(0, m_options.m_items);
+  const QByteArray ical = m_generator.icalFeed(0, m_options.m_items);
+
+  m_benchmark.measure(QSL("parser-rss"), m_options.m_items, [&]() {
+    RssParser(QString::fromUtf8(rss)).messages();
+  });
+  m_benchmark.annotate(QSL("bytes"), int(rss.size()));
+
+  m_benchmark.measure(QSL("parser-atom"), m_options.m_items, [&]() {
+    AtomParser(QString::fromUtf8(atom)).messages();
+  });
+  m_benchmark.annotate(QSL("bytes"), int(atom.size()));
+
+  m_benchmark.measure(QSL("parser-json"), m_options.m_items, [&]() {
+    JsonParser(QString::fromUtf8(json)).messages();
+  });
+  m_benchmark.annotate(QSL("bytes"), int(json.size()));
+
+  m_benchmark.measure(QSL("parser-ical"), m_options.m_items, [&]() {
+    IcalParser(QString::fromUtf8(ical)).messages();
+  });
+  m_benchmark.annotate(QSL("bytes"), int(ical.size()));
+}
+
+void BenchSuite::benchmarkDateTimes() {
+  const QStringList dates = m_generator.dateTimes(BENCH_DATETIMES);
+
+  m_benchmark.measure(QSL("textfactory-parse-datetime"), dates.size(), [&]() {
+    for (const QString& date : dates) {
+      TextFactory::parseDateTime(date);
+    }
+  });
+}
+
+void BenchSuite::benchmarkSettings() {
+  Settings* settings = qApp->settings();
+  int enabled = 0;
+
+  // NOTE: Snapshot is taken for each read, which is the worst case,
+  // hot loops take it once and read all their settings from it.
+  m_benchmark.measure(QSL("settings-snapshot"), BENCH_SETTINGS_READS, [&]() {
+    for (int i = 0; i < BENCH_SETTINGS_READS; i++) {
+      enabled += settings->snapshot()->m_ignoreContentsChanges ? 1 : 0;
+    }
+  });
+
+  m_benchmark.measure(QSL("settings-value"), BENCH_SETTINGS_READS, [&]() {
+    for (int i = 0; i < BENCH_SETTINGS_READS; i++) {
+      enabled += settings->value(GROUP(Messages), SETTING(Messages::IgnoreContentsChanges)).toBool() ? 1 : 0;
+    }
+  });
+  m_benchmark.annotate(QSL("enabled_reads"), enabled);
+}
+
+void BenchSuite::benchmarkSanitize() {
+  StandardFeed feed;
+  QList<Message> msgs;
+
+  feed.setSource(QSL("https://bench.rssguard.invalid/feed"));
+
+  m_benchmark.measure(
+    QSL("message-sanitize"),
+    BENCH_SANITIZED_ARTICLES,
+    [&]() {
+      msgs = m_generator.articles(0, BENCH_SANITIZED_ARTICLES);
+    },
+    [&]() {
+      for (Message& msg : msgs) {
+        msg.sanitize(&feed, true);
+      }
+    });
+}
+
+void BenchSuite::benchmarkHtmlUnescape() {
+  QStringList bodies;
+  QStringList titles;
+  int bytes = 0;
+
+  for (int i = 0; i < BENCH_ESCAPED_BODIES; i++) {
+    bodies.append(m_generator.escapedText(BENCH_ESCAPED_PARAGRAPHS));
+    bytes += bodies.last().size();
+  }
+
+  for (const Message& msg : m_generator.articles(0, BENCH_SANITIZED_ARTICLES)) {
+    titles.append(QSL("<b>%1</b> &amp;  %2&#8217;s\n").arg(msg.m_title, msg.m_author));
+  }
+
+  m_benchmark.measure(QSL("html-unescape"), bodies.size(), [&]() {
+    for (const QString& body : std::as_const(bodies)) {
+      WebFactory::unescapeHtml(body);
+    }
+  });
+  m_benchmark.annotate(QSL("bytes"), bytes);
+
+  m_benchmark.measure(QSL("html-unescape-legacy"), bodies.size(), [&]() {
+    for (const QString& body : std::as_const(bodies)) {
+      LegacyHtml::unescapeHtml(body);
+    }
+  });
+  m_benchmark.annotate(QSL("bytes"), bytes);
+
+  WebFactory* web = qApp->web();
+
+  m_benchmark.measure(QSL("title-cleanup"), titles.size(), [&]() {
+    for (const QString& title : std::as_const(titles)) {
+      TextFactory::simplifyTitle(web->stripTags(WebFactory::unescapeHtml(title)));
+    }
+  });
+
+  m_benchmark.measure(QSL("title-cleanup-legacy"), titles.size(), [&]() {
+    for (const QString& title : std::as_const(titles)) {
+      LegacyHtml::sanitizeTitle(title);
+    }
+  });
+}
+
+void BenchSuite::benchmarkArticleExtractor() {
+  const QUrl base_url(QSL("https://bench.rssguard.invalid/article"));
+  QStringList pages;
+  int bytes = 0;
+
+  for (int i = 0; i < BENCH_EXTRACTED_PAGES; i++) {
+    pages.append(m_generator.htmlPage(20));
+    bytes += pages.last().size();
+  }
+
+  m_benchmark.measure(QSL("article-extractor"), pages.size(), [&]() {
+    for (const QString& page : std::as_const(pages)) {
+      ArticleExtractor::extract(page, base_url);
+    }
+  });
+  m_benchmark.annotate(QSL("bytes"), bytes);
+
+  // Pathologically nested page, extraction must neither crash nor blow up.
+  const QString nested = QSL("<html><body>") + QSL("<div>").repeated(BENCH_NESTED_DEPTH) + m_generator.htmlPage(20) +
+                         QSL("</div>").repeated(BENCH_NESTED_DEPTH) + QSL("</body></html>");
+
+  m_benchmark.measure(QSL("article-extractor-nested"), 1, [&]() {
+    ArticleExtractor::extract(nested, base_url);
+  });
+  m_benchmark.annotate(QSL("depth"), BENCH_NESTED_DEPTH);
+}
+
+void BenchSuite::benchmarkImageLoading() {
+  const QByteArray image = m_generator.jpegImage(BENCH_IMAGE_WIDTH, BENCH_IMAGE_HEIGHT);
+  TextBrowserResourceLoader* loader = TextBrowserResourceLoader::acquire();
+  QList<QUrl> urls;
+  int run = 0;
+
+  m_benchmark.measure(
+    QSL("text-browser-images"),
+    BENCH_IMAGES,
+    [&]() {
+      // NOTE: Each run downloads different URLs, so that
+      // pictures are never loaded from disk cache.
+      urls.clear();
+
+      for (int i = 0; i < BENCH_IMAGES; i++) {
+        QString path = QSL("/image/%1/%2.jpg").arg(QString::number(run), QString::number(i));
+
+        m_server.addDocument(path, QByteArrayLiteral("image/jpeg"), image);
+        urls.append(QUrl(m_server.urlFor(path)));
+      }
+
+      run++;
+    },
+    [&]() {
+      QEventLoop loop;
+      int decoded = 0;
+
+      QObject::connect(loader,
+                       &TextBrowserResourceLoader::resourceLoaded,
+                       &loop,
+                       [&](int requester, const QUrl& url, const QImage& picture, int width, const QImage& scaled) {
+                         Q_UNUSED(requester)
+                         Q_UNUSED(url)
+                         Q_UNUSED(width)
+
+                         if (!picture.isNull() && !scaled.isNull()) {
+                           decoded++;
+                         }
+                       });
+      QObject::connect(loader, &TextBrowserResourceLoader::allResourcesLoaded, &loop, &QEventLoop::quit);
+
+      QMetaObject::invokeMethod(
+        loader,
+        [loader, urls]() {
+          loader->loadResources(1, urls, BENCH_IMAGE_VIEWER_WIDTH);
+        },
+        Qt::ConnectionType::QueuedConnection);
+
+      loop.exec();
+
+      if (decoded != urls.size()) {
+        throw ApplicationException(QSL("only %1 of %2 pictures were loaded").arg(decoded).arg(urls.size()));
+      }
+    });
+  m_benchmark.annotate(QSL("bytes"), int(image.size()));
+
+  TextBrowserResourceLoader::release();
+}
+
+void BenchSuite::prepareAccount() {
+  m_root = new StandardServiceRoot();
+  m_root->setTitle(QSL("Benchmark"));
+  m_root->saveAccountDataToDatabase();
+
+  for (int i = 0; i < m_options.m_feeds; i++) {
+    QString path = QSL("/feed/%1").arg(i);
+    StandardFeed feed;
+
+    m_server.addDocument(path, QByteArrayLiteral("application/rss+xml"), m_generator.rssFeed(i, m_options.m_items));
+
+    feed.setTitle(QSL("Feed %1").arg(i));
+    feed.setSource(m_server.urlFor(path));
+    feed.setSourceType(StandardFeed::SourceType::Url);
+    feed.setType(StandardFeed::Type::Rss2X);
+    feed.setEncoding(QSL(DEFAULT_FEED_ENCODING));
+    feed.setCreationDate(QDateTime::currentDateTime());
+
+    DatabaseQueries::createOverwriteFeed(m_database, &feed, m_root->accountId(), NO_PARENT_CATEGORY);
+  }
+
+  // Account loads its feeds from database.
+  qApp->feedReader()->feedsModel()->addServiceAccount(m_root, false);
+}
+
+void BenchSuite::fillDatabase() {
+  const QList<Feed*> feeds = m_root->getSubTreeFeeds();
+  QList<Message> bodies = m_generator.articles(0, 64);
+  QSqlQuery q(m_database);
+
+  q.prepare(QSL("INSERT INTO Messages "
+                "(is_read, is_important, feed, title, url, author, date_created, contents, account_id, custom_id) "
+                "VALUES (:is_read, :is_important, :feed, :title, :url, :author, :date_created, :contents, "
+                ":account_id, :custom_id);"));
+
+  m_benchmark.measureOnce(QSL("db-fill"), m_options.m_articles, [&]() {
+    if (!m_database.transaction()) {
+      throw ApplicationException(m_database.lastError().text());
+    }
+
+    for (int i = 0; i < m_options.m_articles; i++) {
+      const Message& body = bodies.at(i % bodies.size());
+
+      q.bindValue(QSL(":is_read"), i % 10 < 7);
+      q.bindValue(QSL(":is_important"), i % 20 == 0);
+      q.bindValue(QSL(":feed"), feeds.at(i % feeds.size())->customId());
+      q.bindValue(QSL(":title"), body.m_title);
+      q.bindValue(QSL(":url"), body.m_url + QSL("/%1").arg(i));
+      q.bindValue(QSL(":author"), body.m_author);
+      q.bindValue(QSL(":date_created"), body.m_created.toMSecsSinceEpoch() - qint64(i) * 1000);
+      q.bindValue(QSL(":contents"), body.m_contents);
+      q.bindValue(QSL(":account_id"), m_root->accountId());
+      q.bindValue(QSL(":custom_id"), QSL("fill-%1").arg(i));
+
+      if (!q.exec()) {
+        throw ApplicationException(q.lastError().text());
+      }
+
+      if ((i + 1) % BENCH_FILL_BATCH_SIZE == 0) {
+        m_database.commit();
+        m_database.transaction();
+      }
+    }
+
+    m_database.commit();
+  });
+}
+
+void BenchSuite::benchmarkUpdateMessages() {
+  const QList<Feed*> feeds = m_root->getSubTreeFeeds().mid(0, BENCH_UPDATE_FEEDS);
+  QList<QList<Message>> msgs;
+  QMutex db_mutex;
+  int run = 0;
+
+  auto prepare_articles = [&](int first_item) {
+    msgs.clear();
+
+    for (int i = 0; i < feeds.size(); i++) {
+      QList<Message> feed_msgs = m_generator.articles(i, m_options.m_items, first_item);
+
+      for (Message& msg : feed_msgs) {
+        msg.m_feedId = feeds.at(i)->customId();
+        msg.m_accountId = m_root->accountId();
+      }
+
+      msgs.append(feed_msgs);
+    }
+  };
+
+  auto store_articles = [&]() {
+    for (int i = 0; i < feeds.size(); i++) {
+      bool ok = false;
+
+      DatabaseQueries::updateMessages(m_database, msgs[i], feeds.at(i), false, &db_mutex, &ok);
+
+      if (!ok) {
+        throw ApplicationException(QSL("articles were not stored"));
+      }
+    }
+  };
+
+  // Each run stores completely new articles.
+  m_benchmark.measure(
+    QSL("db-update-messages-new"),
+    qint64(feeds.size()) * m_options.m_items,
+    [&]() {
+      prepare_articles(1000000 + (run++) * m_options.m_items);
+    },
+    store_articles);
+
+  // Each run stores the same articles again, so that existing
+  // articles are looked up and compared.
+  m_benchmark.measure(
+    QSL("db-update-messages-existing"),
+    qint64(feeds.size()) * m_options.m_items,
+    [&]() {
+      prepare_articles(1000000);
+    },
+    store_articles);
+}
+
+void BenchSuite::benchmarkCounts() {
+  const int account_id = m_root->accountId();
+
+  m_benchmark.measure(QSL("db-counts-account"), 1, [&]() {
+    DatabaseQueries::getMessageCountsForAccount(m_database, account_id, true);
+  });
+
+  m_benchmark.measure(QSL("db-counts-special-nodes"), 1, [&]() {
+    DatabaseQueries::getImportantMessageCounts(m_database, account_id);
+    DatabaseQueries::getUnreadMessageCounts(m_database, account_id);
+    DatabaseQueries::getMessageCountsForBin(m_database, account_id);
+    DatabaseQueries::getMessageCountsForAllLabels(m_database, account_id);
+  });
+}
+
+void BenchSuite::benchmarkMessagesModel() {
+  MessagesModel* model = qApp->feedReader()->messagesModel();
+  Feed* feed = m_root->getSubTreeFeeds().first();
+
+  m_benchmark.measure(QSL("messages-model-repopulate-feed"), 1, [&]() {
+    model->loadMessages(feed);
+  });
+  m_benchmark.annotate(QSL("rows"), model->rowCount());
+
+  m_benchmark.measure(QSL("messages-model-repopulate-account"), 1, [&]() {
+    model->loadMessages(m_root);
+  });
+  m_benchmark.annotate(QSL("rows"), model->rowCount());
+
+  model->loadMessages(nullptr);
+}
+
+void BenchSuite::benchmarkApiServer() {
+  // NOTE: API server gets port which was free just a moment ago.
+  QTcpServer probe;
+
+  if (!probe.listen(QHostAddress(QHostAddress::SpecialAddress::LocalHost), 0)) {
+    throw ApplicationException(QSL("no free port for API server: %1").arg(probe.errorString()));
+  }
+
+  const QString address = QSL("http://127.0.0.1:%1").arg(QString::number(probe.serverPort()));
+  ApiServer server;
+
+  probe.close();
+  server.setListenAddressPort(address, true);
+
+  if (!server.isListening()) {
+    throw ApplicationException(QSL("API server failed to start"));
+  }
+
+  QJsonObject data;
+
+  data.insert(QSL("feed"), m_root->getSubTreeFeeds().first()->customId());
+  data.insert(QSL("account"), m_root->accountId());
+  data.insert(QSL("newest_first"), true);
+  data.insert(QSL("row_limit"), BENCH_API_ROW_LIMIT);
+
+  const QByteArray body = QJsonDocument(QJsonObject{{QSL("method"), QSL("ArticlesFromFeed")}, {QSL("data"), data}})
+                            .toJson(QJsonDocument::JsonFormat::Compact);
+  QList<double> latencies;
+  int failed = 0;
+
+  // NOTE: Each client sends its requests one after another, so that
+  // number of clients is number of requests processed concurrently.
+  m_benchmark.measure(QSL("api-server-articles-from-feed"), BENCH_API_REQUESTS, [&]() {
+    QEventLoop loop;
+    int started = 0;
+    int finished = 0;
+    std::function<void(QNetworkAccessManager*)> send_request;
+
+    send_request = [&](QNetworkAccessManager* client) {
+      QNetworkRequest request(QUrl(address + QSL("/api")));
+      QElapsedTimer tmr;
+
+      request.setHeader(QNetworkRequest::KnownHeaders::ContentTypeHeader, QSL("application/json"));
+      tmr.start();
+      started++;
+
+      QNetworkReply* reply = client->post(request, body);
+
+      QObject::connect(reply, &QNetworkReply::finished, &loop, [&, client, reply, tmr]() {
+        latencies.append(tmr.nsecsElapsed() / 1000000.0);
+
+        if (reply->error() != QNetworkReply::NetworkError::NoError) {
+          failed++;
+        }
+
+        reply->deleteLater();
+
+        if (++finished == BENCH_API_REQUESTS) {
+          loop.quit();
+        }
+        else if (started < BENCH_API_REQUESTS) {
+          send_request(client);
+        }
+      });
+    };
+
+    for (int i = 0; i < BENCH_API_CLIENTS; i++) {
+      auto* client = new QNetworkAccessManager(&loop);
+
+      client->setProxy(QNetworkProxy::ProxyType::NoProxy);
+      send_request(client);
+    }
+
+    loop.exec();
+  });
+
+  if (failed > 0) {
+    throw ApplicationException(QSL("%1 of %2 API requests failed").arg(failed).arg(latencies.size()));
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+
+  m_benchmark.annotate(QSL("clients"), BENCH_API_CLIENTS);
+  m_benchmark.annotate(QSL("p50_ms"), latencies.at(latencies.size() / 2));
+  m_benchmark.annotate(QSL("p99_ms"), latencies.at(qMin(latencies.size() - 1, latencies.size() * 99 / 100)));
+}
+
+void BenchSuite::benchmarkFeedUpdate() {
+  const QList<Feed*> feeds = m_root->getSubTreeFeeds();
+  FeedReader* reader = qApp->feedReader();
+
+  m_benchmark.measure(QSL("feed-downloader-update-cycle"), feeds.size(), [&]() {
+    QEventLoop loop;
+    QTimer timeout;
+
+    timeout.setSingleShot(true);
+
+    QObject::connect(reader, &FeedReader::feedUpdatesFinished, &loop, &QEventLoop::quit);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, [&]() {
+      reader->stopRunningFeedUpdate();
+    });
+
+    timeout.start(BENCH_UPDATE_TIMEOUT);
+    reader->updateFeeds(feeds, true);
+    loop.exec();
+  });
+  m_benchmark.annotate(QSL("served_requests"), m_server.servedRequests());
+}
+
+void BenchSuite::benchmarkArticleLimits() {
+  const int feeds_count = m_root->getSubTreeFeeds().size();
+  Feed::ArticleIgnoreLimit app_setup;
+
+  app_setup.m_keepCountOfArticles = BENCH_KEEP_ARTICLES;
+  app_setup.m_doNotRemoveStarred = true;
+  app_setup.m_doNotRemoveUnread = false;
+  app_setup.m_moveToBinDontPurge = false;
+
+  bool in_transaction = false;
+
+  // NOTE: Each run is rolled back, so that all runs start with the same articles.
+  auto start_run = [&]() {
+    restartTransaction(in_transaction);
+  };
+
+  m_benchmark.measure(QSL("article-limits-per-feed"), feeds_count, start_run, [&]() {
+    removeUnwantedArticlesPerFeed(app_setup);
+  });
+
+  int removed = 0;
+
+  m_benchmark.measure(QSL("article-limits-set-based"), feeds_count, start_run, [&]() {
+    removed = DatabaseQueries::removeUnwantedArticles(m_database, {m_root->accountId()}, app_setup);
+  });
+  m_benchmark.annotate(QSL("removed_articles"), removed);
+
+  if (in_transaction) {
+    m_database.rollback();
+  }
+}
+
+void BenchSuite::benchmarkCompression() {
+  QSqlQuery q(m_database);
+
+  if (!q.exec(QSL("SELECT COUNT(*) FROM Messages;")) || !q.next()) {
+    throw ApplicationException(q.lastError().text());
+  }
+
+  const qint64 articles = q.value(0).toLongLong();
+
+  q.finish();
+
+  auto read_contents = [&]() {
+    QSqlQuery q_read(m_database);
+
+    q_read.setForwardOnly(true);
+
+    if (!q_read.exec(QSL("SELECT %1 FROM Messages;").arg(DatabaseQueries::contentsColumn()))) {
+      throw ApplicationException(q_read.lastError().text());
+    }
+
+    while (q_read.next()) {
+      q_read.value(0).toString();
+    }
+  };
+
+  m_benchmark.measure(QSL("db-read-contents-plain"), articles, read_contents);
+
+  const qint64 plain_bytes = columnBytes(QSL("contents"));
+  bool in_transaction = false;
+
+  // NOTE: Each run is rolled back, so that all runs compress the same articles.
+  m_benchmark.measure(
+    QSL("db-compress-contents"),
+    articles,
+    [&]() {
+      restartTransaction(in_transaction);
+    },
+    [&]() {
+      if (!DatabaseQueries::compressArticleContents(m_database)) {
+        throw ApplicationException(QSL("contents of articles were not compressed"));
+      }
+    });
+  m_benchmark.annotate(QSL("bytes_plain"), double(plain_bytes));
+  m_benchmark.annotate(QSL("bytes_compressed"), double(columnBytes(QSL("contents_compressed"))));
+
+  m_benchmark.measure(QSL("db-read-contents-compressed"), articles, read_contents);
+
+  if (in_transaction) {
+    m_database.rollback();
+  }
+}
+
+void BenchSuite::benchmarkFeedFilter() {
+  const int feed_count = BENCH_FILTER_CATEGORIES * BENCH_FILTER_FEEDS;
+  const QList<Message> titles = m_generator.articles(0, feed_count);
+  auto* root = new StandardServiceRoot();
+
+  root->setTitle(QSL("Filter benchmark"));
+  root->saveAccountDataToDatabase();
+
+  if (!m_database.transaction()) {
+    throw ApplicationException(m_database.lastError().text());
+  }
+
+  for (int i = 0; i < BENCH_FILTER_CATEGORIES; i++) {
+    StandardCategory category;
+
+    category.setTitle(QSL("Category %1").arg(i));
+    category.setCreationDate(QDateTime::currentDateTime());
+
+    DatabaseQueries::createOverwriteCategory(m_database, &category, root->accountId(), NO_PARENT_CATEGORY);
+
+    for (int j = 0; j < BENCH_FILTER_FEEDS; j++) {
+      const int feed_index = i * BENCH_FILTER_FEEDS + j;
+      StandardFeed feed;
+
+      feed.setTitle(titles.at(feed_index).m_title);
+      feed.setSource(QSL("https://bench.rssguard.invalid/filter/%1").arg(feed_index));
+      feed.setSourceType(StandardFeed::SourceType::Url);
+      feed.setType(StandardFeed::Type::Rss2X);
+      feed.setEncoding(QSL(DEFAULT_FEED_ENCODING));
+      feed.setCreationDate(QDateTime::currentDateTime());
+
+      DatabaseQueries::createOverwriteFeed(m_database, &feed, root->accountId(), category.id());
+    }
+  }
+
+  if (!m_database.commit()) {
+    throw ApplicationException(m_database.lastError().text());
+  }
+
+  qApp->feedReader()->feedsModel()->addServiceAccount(root, false);
+
+  FeedsProxyModel* proxy = qApp->feedReader()->feedsProxyModel();
+  const int nodes = root->getSubTreeFeeds().size() + root->getSubTreeCategories().size();
+
+  // User types the phrase letter by letter and then clears the search box,
+  // all nodes are walked after each change as if the whole tree was expanded.
+  const QString phrase = titles.at(feed_count / 2).m_title.left(BENCH_FILTER_PHRASE);
+  int visible = 0;
+
+  m_benchmark.measure(QSL("feeds-filter-typing"), nodes, [&]() {
+    for (int i = 1; i <= phrase.size(); i++) {
+      proxy->setFilter(SearchLineEdit::SearchMode::FixedString,
+                       Qt::CaseSensitivity::CaseInsensitive,
+                       true,
+                       phrase.left(i));
+      visible = visibleRows(proxy, QModelIndex());
+    }
+
+    proxy->setFilter(SearchLineEdit::SearchMode::FixedString, Qt::CaseSensitivity::CaseInsensitive, true, {});
+    visibleRows(proxy, QModelIndex());
+  });
+  m_benchmark.annotate(QSL("nodes"), nodes);
+  m_benchmark.annotate(QSL("visible"), visible);
+
+  m_benchmark.measure(QSL("feeds-filter-regex"), nodes, [&]() {
+    proxy->setFilter(SearchLineEdit::SearchMode::RegularExpression,
+                     Qt::CaseSensitivity::CaseInsensitive,
+                     true,
+                     QSL("^\\w+ \\w+s\\b"));
+    visible = visibleRows(proxy, QModelIndex());
+
+    proxy->setFilter(SearchLineEdit::SearchMode::RegularExpression, Qt::CaseSensitivity::CaseInsensitive, true, {});
+    visibleRows(proxy, QModelIndex());
+  });
+  m_benchmark.annotate(QSL("nodes"), nodes);
+  m_benchmark.annotate(QSL("visible"), visible);
+}
+
+void BenchSuite::restartTransaction(bool& in_transaction) {
+  if (in_transaction) {
+    m_database.rollback();
+  }
+
+  in_transaction = m_database.transaction();
+
+  if (!in_transaction) {
+    throw ApplicationException(m_database.lastError().text());
+  }
+}
+
+qint64 BenchSuite::columnBytes(const QString& column) {
+  QSqlQuery q(m_database);
+  qint64 bytes = 0;
+
+  q.setForwardOnly(true);
+
+  if (!q.exec(QSL("SELECT %1 FROM Messages WHERE %1 IS NOT NULL;").arg(column))) {
+    throw ApplicationException(q.lastError().text());
+  }
+
+  // NOTE: Texts are counted as UTF-8.
+  while (q.next()) {
+    bytes += q.value(0).toByteArray().size();
+  }
+
+  return bytes;
+}
+
+void BenchSuite::removeUnwantedArticlesPerFeed(const Feed::ArticleIgnoreLimit& app_setup) {
+  const QList<Feed*> feeds = m_root->getSubTreeFeeds();
+  QSqlQuery q(m_database);
+
+  for (const Feed* feed : feeds) {
+    // We find datetime stamp of oldest article which will be NOT removed.
+    q.setForwardOnly(true);
+    q.prepare(QSL("SELECT Messages.date_created "
+                  "FROM Messages "
+                  "WHERE "
+                  "  Messages.account_id = :account_id AND "
+                  "  Messages.feed = :feed AND "
+                  "  Messages.is_deleted = 0 AND "
+                  "  Messages.is_pdeleted = 0 "
+                  "ORDER BY Messages.date_created DESC "
+                  "LIMIT 1 OFFSET :offset;"));
+    q.bindValue(QSL(":offset"), app_setup.m_keepCountOfArticles - 1);
+    q.bindValue(QSL(":feed"), feed->customId());
+    q.bindValue(QSL(":account_id"), m_root->accountId());
+
+    if (!q.exec()) {
+      throw ApplicationException(q.lastError().text());
+    }
+
+    if (!q.next()) {
+      continue;
+    }
+
+    const qlonglong last_kept_stamp = q.value(0).toLongLong();
+
+    q.prepare(QSL("DELETE FROM Messages "
+                  "WHERE "
+                  "  Messages.account_id = :account_id AND "
+                  "  Messages.feed = :feed AND "
+                  "  (Messages.is_deleted = 1 OR Messages.is_important != :is_important) AND "
+                  "  (Messages.is_deleted = 1 OR Messages.is_read != :is_read) AND "
+                  "  Messages.date_created < :stamp"));
+    q.bindValue(QSL(":is_important"), app_setup.m_doNotRemoveStarred ? 1 : 2);
+    q.bindValue(QSL(":is_read"), app_setup.m_doNotRemoveUnread ? 0 : 2);
+    q.bindValue(QSL(":feed"), feed->customId());
+    q.bindValue(QSL(":stamp"), last_kept_stamp);
+    q.bindValue(QSL(":account_id"), m_root->accountId());
+
+    if (!q.exec()) {
+      throw ApplicationException(q.lastError().text());
+    }
+  }
+}
+
+int BenchSuite::visibleRows(const QAbstractItemModel* model, const QModelIndex& parent) {
+  const int rows = model->rowCount(parent);
+  int visible = rows;
+
+  for (int i = 0; i < rows; i++) {
+    visible += visibleRows(model, model->index(i, 0, parent));
+  }
+
+  return visible;
+}
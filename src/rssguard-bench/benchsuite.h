@@ -0,0 +1,85 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef BENCHSUITE_H
+#define BENCHSUITE_H
+
+#include "benchmark.h"
+#include "corpusgenerator.h"
+#include "localfeedserver.h"
+
+#include "services/abstract/feed.h"
+
+#include <QAbstractItemModel>
+#include <QJsonObject>
+#include <QSqlDatabase>
+
+class StandardServiceRoot;
+
+// Runs all benchmark cases against live application instance
+// with its own (temporary) user data folder.
+class BenchSuite {
+  public:
+    struct Options {
+        // Number of articles in generated database.
+        int m_articles = 100000;
+
+        // Number of feeds served by local HTTP server.
+        int m_feeds = 100;
+
+        // Number of articles in each generated feed document.
+        int m_items = 200;
+
+        int m_repeats = 5;
+        quint32 m_seed = 1;
+    };
+
+    explicit BenchSuite(const Options& options);
+
+    QJsonObject run();
+
+  private:
+    void benchmarkParsers();
+    void benchmarkDateTimes();
+    void benchmarkSettings();
+    void benchmarkSanitize();
+    void benchmarkHtmlUnescape();
+    void benchmarkArticleExtractor();
+    void benchmarkImageLoading();
+
+    void prepareAccount();
+    void fillDatabase();
+
+    void benchmarkUpdateMessages();
+    void benchmarkCounts();
+    void benchmarkMessagesModel();
+    void benchmarkApiServer();
+    void benchmarkFeedUpdate();
+    void benchmarkArticleLimits();
+    void benchmarkCompression();
+    void benchmarkFeedFilter();
+
+    // Rolls back transaction started by previous run, if any, and starts
+    // new one, so that all runs start with the same articles.
+    void restartTransaction(bool& in_transaction);
+
+    // Returns total size of values of given column of all articles.
+    qint64 columnBytes(const QString& column);
+
+    // Returns number of rows under given parent, walking the whole
+    // subtree like view with all items expanded.
+    static int visibleRows(const QAbstractItemModel* model, const QModelIndex& parent);
+
+    // Applies article limits feed by feed, as it was done before
+    // limits were applied with set-based queries. Used as baseline.
+    void removeUnwantedArticlesPerFeed(const Feed::ArticleIgnoreLimit& app_setup);
+
+  private:
+    Options m_options;
+    Benchmark m_benchmark;
+    CorpusGenerator m_generator;
+    LocalFeedServer m_server;
+    StandardServiceRoot* m_root;
+    QSqlDatabase m_database;
+};
+
+#endif // BENCHSUITE_H
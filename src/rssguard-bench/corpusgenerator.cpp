@@ -0,0 +1,295 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "corpusgenerator.h"
+
+#include "definitions/definitions.h"
+
+#include <QBuffer>
+#include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocale>
+
+#define CORPUS_BASE_URL "https://bench.rssguard.invalid"
+
+CorpusGenerator::CorpusGenerator(quint32 seed)
+  : m_random(seed), m_now(QDate(2024, 1, 1), QTime(12, 0), Qt::TimeSpec::UTC) {}
+
+QByteArray CorpusGenerator::rssFeed(int feed_index, int items) {
+  QString xml;
+  QLocale c_locale = QLocale::c();
+
+  xml += QSL("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<rss version=\"2.0\" xmlns:dc=\"http://purl.org/dc/elements/1.1/\">\n<channel>\n"
+             "<title>Feed %1</title>\n<link>%2</link>\n<description>%3</description>\n")
+           .arg(QString::number(feed_index), QSL(CORPUS_BASE_URL), sentence(5, 12).toHtmlEscaped());
+
+  for (int i = 0; i < items; i++) {
+    QString title = sentence(4, 10);
+    QString author = sentence(2, 2);
+    QString body = paragraphs(3);
+
+    xml += QSL("<item>\n<title>%1</title>\n<link>%2</link>\n<guid isPermaLink=\"false\">%3</guid>\n"
+               "<pubDate>%4</pubDate>\n<dc:creator>%5</dc:creator>\n"
+               "<description><![CDATA[%6]]></description>\n"
+               "<enclosure url=\"%2/image.jpg\" type=\"image/jpeg\" length=\"1024\"/>\n</item>\n")
+             .arg(title.toHtmlEscaped(),
+                  itemUrl(feed_index, i),
+                  QSL("feed-%1-item-%2").arg(feed_index).arg(i),
+                  c_locale.toString(itemDate(i), QSL("ddd, dd MMM yyyy HH:mm:ss +0000")),
+                  author.toHtmlEscaped(),
+                  body);
+  }
+
+  xml += QSL("</channel>\n</rss>\n");
+  return xml.toUtf8();
+}
+
+QByteArray CorpusGenerator::atomFeed(int feed_index, int items) {
+  QString xml;
+
+  xml += QSL("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<feed xmlns=\"http://www.w3.org/2005/Atom\">\n"
+             "<title>Feed %1</title>\n<id>%2/feed/%1</id>\n<updated>%3</updated>\n")
+           .arg(QString::number(feed_index), QSL(CORPUS_BASE_URL), m_now.toString(Qt::DateFormat::ISODate));
+
+  for (int i = 0; i < items; i++) {
+    QString title = sentence(4, 10);
+    QString author = sentence(2, 2);
+    QString body = paragraphs(3);
+
+    xml += QSL("<entry>\n<title>%1</title>\n<link href=\"%2\"/>\n<id>%3</id>\n"
+               "<updated>%4</updated>\n<author><name>%5</name></author>\n"
+               "<content type=\"html\">%6</content>\n</entry>\n")
+             .arg(title.toHtmlEscaped(),
+                  itemUrl(feed_index, i),
+                  QSL("feed-%1-item-%2").arg(feed_index).arg(i),
+                  itemDate(i).toString(Qt::DateFormat::ISODate),
+                  author.toHtmlEscaped(),
+                  body.toHtmlEscaped());
+  }
+
+  xml += QSL("</feed>\n");
+  return xml.toUtf8();
+}
+
+QByteArray CorpusGenerator::jsonFeed(int feed_index, int items) {
+  QJsonObject feed;
+  QJsonArray json_items;
+
+  feed.insert(QSL("version"), QSL("https://jsonfeed.org/version/1.1"));
+  feed.insert(QSL("title"), QSL("Feed %1").arg(feed_index));
+  feed.insert(QSL("home_page_url"), QSL(CORPUS_BASE_URL));
+
+  for (int i = 0; i < items; i++) {
+    QJsonObject item;
+
+    item.insert(QSL("id"), QSL("feed-%1-item-%2").arg(feed_index).arg(i));
+    item.insert(QSL("url"), itemUrl(feed_index, i));
+    item.insert(QSL("title"), sentence(4, 10));
+    item.insert(QSL("content_html"), paragraphs(3));
+    item.insert(QSL("date_published"), itemDate(i).toString(Qt::DateFormat::ISODate));
+    item.insert(QSL("authors"), QJsonArray{QJsonObject{{QSL("name"), sentence(2, 2)}}});
+    item.insert(QSL("attachments"),
+                QJsonArray{QJsonObject{{QSL("url"), itemUrl(feed_index, i) + QSL("/audio.mp3")},
+                                       {QSL("mime_type"), QSL("audio/mpeg")}}});
+    json_items.append(item);
+  }
+
+  feed.insert(QSL("items"), json_items);
+  return QJsonDocument(feed).toJson(QJsonDocument::JsonFormat::Compact);
+}
+
+QByteArray CorpusGenerator::icalFeed(int feed_index, int items) {
+  QString ical;
+
+  ical += QSL("BEGIN:VCALENDAR\r\nVERSION:2.0\r\nPRODID:-//rssguard//bench//EN\r\nX-WR-CALNAME:Feed %1\r\n")
+            .arg(feed_index);
+
+  for (int i = 0; i < items; i++) {
+    QString start = itemDate(i).toString(QSL("yyyyMMdd'T'HHmmss'Z'"));
+    QString summary = sentence(4, 10);
+    QString description = sentence(20, 40);
+    QString location = sentence(1, 3);
+
+    ical += QSL("BEGIN:VEVENT\r\nUID:feed-%1-item-%2\r\nDTSTAMP:%3\r\nDTSTART:%3\r\nDTEND:%3\r\n"
+                "SUMMARY:%4\r\nDESCRIPTION:%5\r\nURL:%6\r\nLOCATION:%7\r\nEND:VEVENT\r\n")
+              .arg(QString::number(feed_index),
+                   QString::number(i),
+                   start,
+                   summary,
+                   description,
+                   itemUrl(feed_index, i),
+                   location);
+  }
+
+  ical += QSL("END:VCALENDAR\r\n");
+  return ical.toUtf8();
+}
+
+QList<Message> CorpusGenerator::articles(int feed_index, int items, int first_item) {
+  QList<Message> msgs;
+
+  msgs.reserve(items);
+
+  for (int i = first_item; i < first_item + items; i++) {
+    Message msg;
+
+    msg.m_title = sentence(4, 10);
+    msg.m_url = itemUrl(feed_index, i);
+    msg.m_author = sentence(2, 2);
+    msg.m_contents = paragraphs(3);
+    msg.m_created = itemDate(i);
+    msg.m_createdFromFeed = true;
+    msg.m_customId = QSL("feed-%1-item-%2").arg(feed_index).arg(i);
+    msg.m_enclosures.append(Enclosure(msg.m_url + QSL("/image.jpg"), QSL("image/jpeg")));
+    msgs.append(msg);
+  }
+
+  return msgs;
+}
+
+QStringList CorpusGenerator::dateTimes(int count) {
+  static const QStringList formats = {QSL("ddd, dd MMM yyyy HH:mm:ss +0000"),
+                                      QSL("ddd, d MMM yyyy HH:mm:ss 'GMT'"),
+                                      QSL("yyyy-MM-dd'T'HH:mm:ss'Z'"),
+                                      QSL("yyyy-MM-dd'T'HH:mm:ss.zzz'+02:00'"),
+                                      QSL("yyyy-MM-dd HH:mm:ss"),
+                                      QSL("yyyyMMdd'T'HHmmss'Z'"),
+                                      QSL("dd.MM.yyyy HH:mm")};
+  QLocale c_locale = QLocale::c();
+  QStringList dates;
+
+  dates.reserve(count);
+
+  for (int i = 0; i < count; i++) {
+    dates.append(c_locale.toString(itemDate(i), formats.at(i % formats.size())));
+  }
+
+  return dates;
+}
+
+QString CorpusGenerator::htmlPage(int paragraphs_count) {
+  QString html;
+
+  html += QSL("<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>%1</title>"
+              "<meta property=\"og:title\" content=\"%1\"><script>var tracking = {};</script>"
+              "<style>body { margin: 0; }</style></head><body>\n"
+              "<header class=\"site-header\"><nav><ul>")
+            .arg(sentence(4, 10).toHtmlEscaped());
+
+  for (int i = 0; i < 12; i++) {
+    html += QSL("<li><a href=\"/section/%1\">%2</a></li>").arg(QString::number(i), word());
+  }
+
+  html += QSL("</ul></nav></header>\n<div class=\"layout\"><aside class=\"sidebar\"><ul>");
+
+  for (int i = 0; i < 8; i++) {
+    html += QSL("<li><a href=\"/related/%1\">%2</a></li>").arg(QString::number(i), sentence(3, 6).toHtmlEscaped());
+  }
+
+  QString heading = sentence(4, 10);
+  QString byline = sentence(2, 2);
+
+  html += QSL("</ul></aside>\n<main><article class=\"post-content\"><h1>%1</h1>"
+              "<p class=\"byline\">%2</p>\n")
+            .arg(heading.toHtmlEscaped(), byline.toHtmlEscaped());
+  html += paragraphs(paragraphs_count);
+  html += QSL("</article>\n<div class=\"comments\">");
+
+  for (int i = 0; i < 5; i++) {
+    html += QSL("<div class=\"comment\"><p>%1</p></div>").arg(sentence(5, 20).toHtmlEscaped());
+  }
+
+  html += QSL("</div></main></div>\n<footer class=\"footer\"><p>%1</p></footer>"
+              "<script>window.onload = function() {};</script></body></html>\n")
+            .arg(sentence(5, 10).toHtmlEscaped());
+
+  return html;
+}
+
+QByteArray CorpusGenerator::jpegImage(int width, int height) {
+  QImage image(width, height, QImage::Format::Format_RGB32);
+
+  // NOTE: Gradient with some noise, so that picture
+  // compresses roughly as photo does.
+  for (int y = 0; y < height; y++) {
+    auto* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+
+    for (int x = 0; x < width; x++) {
+      const int noise = int(m_random.bounded(32U));
+
+      line[x] = qRgb((x * 255 / width + noise) % 256, (y * 255 / height + noise) % 256, noise * 4);
+    }
+  }
+
+  QByteArray data;
+  QBuffer buffer(&data);
+
+  buffer.open(QIODevice::OpenModeFlag::WriteOnly);
+  image.save(&buffer, "JPG", 85);
+
+  return data;
+}
+
+QString CorpusGenerator::escapedText(int paragraphs_count) {
+  return paragraphs(paragraphs_count)
+    .toHtmlEscaped()
+    .replace(QSL(". "), QSL(".&nbsp; "))
+    .replace(QSL("é"), QSL("&eacute;"))
+    .replace(QSL("ï"), QSL("&iuml;"))
+    .replace(QSL("Ä"), QSL("&Auml;"))
+    .replace(QSL("日本"), QSL("&#26085;&#x672C;"));
+}
+
+QString CorpusGenerator::word() {
+  static const QStringList words = {
+    QSL("lorem"),   QSL("ipsum"),    QSL("dolor"),   QSL("sit"),      QSL("amet"),    QSL("consectetur"),
+    QSL("feed"),    QSL("article"),  QSL("update"),  QSL("database"), QSL("network"), QSL("reader"),
+    QSL("science"), QSL("politics"), QSL("weather"), QSL("market"),   QSL("release"), QSL("report"),
+    QSL("city"),    QSL("council"),  QSL("budget"),  QSL("energy"),   QSL("school"),  QSL("health"),
+    QSL("Ärger"),   QSL("čaj"),      QSL("日本"),    QSL("naïve"),    QSL("café"),    QSL("résumé")};
+
+  return words.at(int(m_random.bounded(quint32(words.size()))));
+}
+
+QString CorpusGenerator::sentence(int min_words, int max_words) {
+  int count = min_words + int(m_random.bounded(quint32(max_words - min_words + 1)));
+  QStringList words;
+
+  words.reserve(count);
+
+  for (int i = 0; i < count; i++) {
+    words.append(word());
+  }
+
+  QString sent = words.join(QL1C(' '));
+
+  sent[0] = sent[0].toUpper();
+  return sent;
+}
+
+QString CorpusGenerator::paragraphs(int count) {
+  QString html;
+
+  for (int i = 0; i < count; i++) {
+    QString first = sentence(8, 20);
+    QString second = sentence(5, 12);
+    QString link = word();
+    QString last = sentence(8, 20);
+
+    html += QSL("<p>%1. %2, <a href=\"%3\">%4</a>. %5.</p>\n")
+              .arg(first, second, QSL(CORPUS_BASE_URL "/link"), link, last);
+  }
+
+  return html;
+}
+
+QString CorpusGenerator::itemUrl(int feed_index, int item_index) const {
+  return QSL(CORPUS_BASE_URL "/feed/%1/article/%2").arg(QString::number(feed_index), QString::number(item_index));
+}
+
+QDateTime CorpusGenerator::itemDate(int item_index) const {
+  return m_now.addSecs(-qint64(item_index) * 600);
+}
@@ -0,0 +1,54 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef CORPUSGENERATOR_H
+#define CORPUSGENERATOR_H
+
+#include "core/message.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QStringList>
+
+// Generates synthetic feeds and articles.
+//
+// NOTE: Generator is seeded, so that the same seed always
+// produces the same corpus and results of runs are comparable.
+class CorpusGenerator {
+  public:
+    explicit CorpusGenerator(quint32 seed);
+
+    QByteArray rssFeed(int feed_index, int items);
+    QByteArray atomFeed(int feed_index, int items);
+    QByteArray jsonFeed(int feed_index, int items);
+    QByteArray icalFeed(int feed_index, int items);
+
+    // Returns articles as parsers would return them.
+    QList<Message> articles(int feed_index, int items, int first_item = 0);
+
+    // Returns date/time strings in formats which are seen in the wild.
+    QStringList dateTimes(int count);
+
+    // Returns HTML page with article surrounded by usual boilerplate.
+    QString htmlPage(int paragraphs);
+
+    // Returns HTML-escaped article text full of named and numeric entities,
+    // as seen in feeds which escape contents of their articles.
+    QString escapedText(int paragraphs);
+
+    // Returns JPEG-encoded picture of given size.
+    QByteArray jpegImage(int width, int height);
+
+  private:
+    QString word();
+    QString sentence(int min_words, int max_words);
+    QString paragraphs(int count);
+    QString itemUrl(int feed_index, int item_index) const;
+    QDateTime itemDate(int item_index) const;
+
+  private:
+    QRandomGenerator m_random;
+    QDateTime m_now;
+};
+
+#endif // CORPUSGENERATOR_H
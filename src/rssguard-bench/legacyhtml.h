@@ -0,0 +1,23 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef LEGACYHTML_H
+#define LEGACYHTML_H
+
+#include <QMap>
+#include <QString>
+
+// Former implementations of HTML unescaping and title cleanup, which
+// were based on map of entities and regular expressions. Used as baseline.
+class LegacyHtml {
+  public:
+    static QString unescapeHtml(const QString& html);
+    static QString stripTags(QString text);
+
+    // Cleans up article title as Message::sanitize() did.
+    static QString sanitizeTitle(const QString& title);
+
+  private:
+    static QMap<QString, char16_t> generateUnescapes();
+};
+
+#endif // LEGACYHTML_H
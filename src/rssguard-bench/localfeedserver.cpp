@@ -0,0 +1,73 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "localfeedserver.h"
+
+#include "definitions/definitions.h"
+
+#include <QHostAddress>
+#include <QTcpSocket>
+
+LocalFeedServer::LocalFeedServer(QObject* parent) : QTcpServer(parent), m_servedRequests(0) {
+  connect(this, &QTcpServer::newConnection, this, &LocalFeedServer::onNewConnection);
+}
+
+bool LocalFeedServer::start() {
+  return listen(QHostAddress(QHostAddress::SpecialAddress::LocalHost), 0);
+}
+
+void LocalFeedServer::addDocument(const QString& path, const QByteArray& content_type, const QByteArray& data) {
+  m_documents.insert(path, Document{content_type, data});
+}
+
+QString LocalFeedServer::urlFor(const QString& path) const {
+  return QSL("http://127.0.0.1:%1%2").arg(QString::number(serverPort()), path);
+}
+
+int LocalFeedServer::servedRequests() const {
+  return m_servedRequests;
+}
+
+void LocalFeedServer::onNewConnection() {
+  while (hasPendingConnections()) {
+    QTcpSocket* socket = nextPendingConnection();
+
+    connect(socket, &QTcpSocket::readyRead, this, &LocalFeedServer::onReadyRead);
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+      m_buffers.remove(socket);
+      socket->deleteLater();
+    });
+  }
+}
+
+void LocalFeedServer::onReadyRead() {
+  auto* socket = qobject_cast<QTcpSocket*>(sender());
+  QByteArray& buffer = m_buffers[socket];
+
+  buffer += socket->readAll();
+
+  if (!buffer.contains("\r\n\r\n")) {
+    // Wait for the rest of the header.
+    return;
+  }
+
+  // Request line looks like "GET /feed/1 HTTP/1.1".
+  QList<QByteArray> request_line = buffer.left(buffer.indexOf("\r\n")).split(' ');
+  QString path = request_line.size() >= 2 ? QString::fromUtf8(request_line.at(1)) : QString();
+  auto doc = m_documents.constFind(path);
+  QByteArray answer;
+
+  if (doc == m_documents.constEnd()) {
+    answer = QByteArrayLiteral("HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+  }
+  else {
+    answer = QByteArrayLiteral("HTTP/1.0 200 OK\r\nContent-Type: ") + doc->m_contentType +
+             QByteArrayLiteral("\r\nContent-Length: ") + QByteArray::number(doc->m_data.size()) +
+             QByteArrayLiteral("\r\nConnection: close\r\n\r\n") + doc->m_data;
+  }
+
+  m_servedRequests++;
+  buffer.clear();
+
+  socket->write(answer);
+  socket->disconnectFromHost();
+}
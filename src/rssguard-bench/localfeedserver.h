@@ -0,0 +1,47 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef LOCALFEEDSERVER_H
+#define LOCALFEEDSERVER_H
+
+#include <QHash>
+#include <QTcpServer>
+
+class QTcpSocket;
+
+// Minimal HTTP/1.0 server which serves static documents from memory.
+//
+// NOTE: Server runs in the thread which created it, so that thread
+// must spin event loop while clients are downloading.
+class LocalFeedServer : public QTcpServer {
+    Q_OBJECT
+
+  public:
+    explicit LocalFeedServer(QObject* parent = nullptr);
+
+    // Starts listening on random port of loopback interface.
+    bool start();
+
+    // Registers document for given path, for example "/feed/1".
+    void addDocument(const QString& path, const QByteArray& content_type, const QByteArray& data);
+
+    // Returns full URL of document with given path.
+    QString urlFor(const QString& path) const;
+
+    int servedRequests() const;
+
+  private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+  private:
+    struct Document {
+        QByteArray m_contentType;
+        QByteArray m_data;
+    };
+
+    QHash<QString, Document> m_documents;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+    int m_servedRequests;
+};
+
+#endif // LOCALFEEDSERVER_H
@@ -0,0 +1,93 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "benchsuite.h"
+
+#include "core/feedsmodel.h"
+#include "definitions/definitions.h"
+#include "exceptions/applicationexception.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
+#include "miscellaneous/iofactory.h"
+#include "services/abstract/label.h"
+
+#include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QSettings>
+#include <QTemporaryDir>
+
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+  // NOTE: Benchmarks do not show any windows.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+
+  QSettings::setDefaultFormat(QSettings::Format::IniFormat);
+  QCoreApplication::setApplicationName(QSL(APP_NAME));
+  QCoreApplication::setApplicationVersion(QSL(APP_VERSION));
+  QCoreApplication::setOrganizationDomain(QSL(APP_URL));
+
+  QStringList bench_args;
+
+  for (int a = 0; a < argc; a++) {
+    bench_args << QString::fromLocal8Bit(argv[a]);
+  }
+
+  QCommandLineParser parser;
+  BenchSuite::Options options;
+  QCommandLineOption articles(QSL("articles"), QSL("Number of articles in generated database."), QSL("count"));
+  QCommandLineOption feeds(QSL("feeds"), QSL("Number of feeds served by local HTTP server."), QSL("count"));
+  QCommandLineOption items(QSL("items"), QSL("Number of articles in each generated feed."), QSL("count"));
+  QCommandLineOption repeats(QSL("repeats"), QSL("Number of runs of each benchmark case."), QSL("count"));
+  QCommandLineOption seed(QSL("seed"), QSL("Seed of generated corpora."), QSL("number"));
+  QCommandLineOption output(QSL("output"), QSL("Write JSON results to file instead of standard output."), QSL("file"));
+
+  parser.setApplicationDescription(QSL("%1 benchmark suite").arg(QSL(APP_NAME)));
+  parser.addHelpOption();
+  parser.addOptions({articles, feeds, items, repeats, seed, output});
+  parser.process(bench_args);
+
+  options.m_articles = parser.value(articles).toInt() > 0 ? parser.value(articles).toInt() : options.m_articles;
+  options.m_feeds = parser.value(feeds).toInt() > 0 ? parser.value(feeds).toInt() : options.m_feeds;
+  options.m_items = parser.value(items).toInt() > 0 ? parser.value(items).toInt() : options.m_items;
+  options.m_repeats = parser.value(repeats).toInt() > 0 ? parser.value(repeats).toInt() : options.m_repeats;
+  options.m_seed = parser.isSet(seed) ? parser.value(seed).toUInt() : options.m_seed;
+
+  // Application runs with its own user data, so that user's
+  // database is never touched and runs are comparable.
+  QTemporaryDir data_folder;
+  QStringList app_args = {bench_args.first(),
+                          QSL("-%1").arg(QSL(CLI_DAT_SHORT)),
+                          data_folder.path(),
+                          QSL("-%1").arg(QSL(CLI_NDEBUG_SHORT))};
+  int app_argc = 1;
+  Application application(QSL(APP_LOW_NAME "-bench"), app_argc, argv, app_args);
+
+  qApp->setFeedReader(new FeedReader(&application));
+
+  qRegisterMetaType<QList<Message>>("QList<Message>");
+  qRegisterMetaType<QList<RootItem*>>("QList<RootItem*>");
+  qRegisterMetaType<QList<Label*>>("QList<Label*>");
+  qRegisterMetaType<Label*>("Label*");
+
+  int exit_code = EXIT_SUCCESS;
+
+  try {
+    QByteArray report = QJsonDocument(BenchSuite(options).run()).toJson(QJsonDocument::JsonFormat::Indented);
+
+    if (parser.isSet(output)) {
+      IOFactory::writeFile(parser.value(output), report);
+    }
+    else {
+      std::cout << report.constData() << std::endl;
+    }
+  }
+  catch (const ApplicationException& ex) {
+    std::cerr << "Benchmark failed: " << ex.message().toStdString() << std::endl;
+    exit_code = EXIT_FAILURE;
+  }
+
+  qApp->feedReader()->quit();
+  return exit_code;
+}